@@ -0,0 +1,275 @@
+//@ts-check
+
+const fs = require("fs");
+const path = require("path");
+const {Utils} = require("../lib/Utils");
+
+const ROOT = path.join(__dirname, "/..");
+const GRAMMAR_PATH = path.join(__dirname, "/ll_grammar.md");
+const TABLE_PATH = path.join(__dirname, "/ll_table.md");
+const OUTPUT_PATH = path.join(ROOT, "/include/compiler/parser/LLTable.h");
+
+/**
+ * Names of the terminals that cannot be used as C identifiers directly
+ * @type {Record<string, string>}
+ */
+const TERMINAL_NAMES = {
+	"$": "EOF",
+	"{": "LEFT_BRACE",
+	"}": "RIGHT_BRACE",
+	"(": "LEFT_PAREN",
+	")": "RIGHT_PAREN",
+	"->": "ARROW",
+	",": "COMMA",
+	":": "COLON",
+	"=": "EQUAL",
+	"...": "RANGE",
+	"..<": "HALF_OPEN_RANGE"
+};
+
+/**
+ * @typedef {Object} Rule
+ * @prop {number} id
+ * @prop {string} lhs
+ * @prop {string[]} rhs
+ */
+
+/**
+ * @typedef {Object} Grammar
+ * @prop {Rule[]} rules
+ * @prop {string[]} terminals
+ * @prop {string[]} nonTerminals
+ * @prop {number[][]} table Rule ids indexed by [nonTerminal][terminal], 0 means no rule
+ */
+
+(function main() {
+	Utils.info("Reading grammar...");
+	const rules = parseGrammar(fs.readFileSync(GRAMMAR_PATH, "utf8"));
+
+	Utils.info("Reading LL table...");
+	const grammar = parseTable(fs.readFileSync(TABLE_PATH, "utf8"), rules);
+
+	Utils.info("Filling default reductions...");
+	fillDefaultRules(grammar);
+
+	Utils.info("Generating header...");
+	fs.writeFileSync(OUTPUT_PATH, generateHeader(grammar));
+
+	Utils.info(`Generated ${path.relative(ROOT, OUTPUT_PATH)} (${grammar.rules.length} rules, ${grammar.terminals.length} terminals, ${grammar.nonTerminals.length} non-terminals)`);
+})();
+
+
+/**
+ * Parses the numbered list of rules in form of `N. lhs → rhs`.
+ * Terminals are either enclosed in backticks or are not defined on any left side.
+ * @param {string} source
+ * @return {Rule[]}
+ */
+function parseGrammar(source) {
+	/** @type {Rule[]} */
+	const rules = [];
+
+	for(const line of source.split(/\r?\n/)) {
+		const match = line.match(/^\s*(\d+)\.\s*(\S+)\s*→\s*(.*)$/);
+		if(!match) continue;
+
+		const [, id, lhs, rhs] = match;
+		const symbols = rhs.trim() === "ε" ? [] : rhs.trim().split(/\s+/);
+
+		if(+id !== rules.length + 1) {
+			Utils.error(`Rule ${id} is out of order, expected rule ${rules.length + 1}!`);
+			process.exit(1);
+		}
+
+		rules.push({id: +id, lhs, rhs: symbols});
+	}
+
+	return rules;
+}
+
+/**
+ * Parses the markdown table of the LL table.
+ * @param {string} source
+ * @param {Rule[]} rules
+ * @return {Grammar}
+ */
+function parseTable(source, rules) {
+	const rows = source.split(/\r?\n/)
+		.filter(e => e.trim().startsWith("|"))
+		.map(e => e.trim().slice(1, -1).split("|").map(e => e.trim()));
+
+	// First row is a header, second one is an alignment row
+	const [header, , ...body] = rows;
+	const terminals = header.slice(1).map(e => e.replace(/^\*\*(.*)\*\*$/, "$1"));
+	const nonTerminals = body.map(e => e[0]);
+
+	// Collect terminals used in the grammar, but missing in the table
+	const defined = new Set(rules.map(e => e.lhs));
+	for(const rule of rules) {
+		for(const symbol of rule.rhs) {
+			const name = symbol.replace(/^`(.*)`$/, "$1");
+			if(defined.has(symbol) || terminals.includes(name)) continue;
+
+			terminals.push(name);
+		}
+	}
+
+	// Validate the non-terminals
+	for(const nonTerminal of defined) {
+		if(nonTerminals.includes(nonTerminal)) continue;
+
+		Utils.error(`Non-terminal "${nonTerminal}" is missing in the LL table!`);
+		process.exit(1);
+	}
+
+	const table = body.map(row => terminals.map((_, i) => +(row[i + 1] || 0)));
+
+	return {
+		rules: rules.map(e => ({...e, rhs: e.rhs.map(e => e.replace(/^`(.*)`$/, "$1"))})),
+		terminals,
+		nonTerminals,
+		table
+	};
+}
+
+/**
+ * Fills the empty cells of nullable non-terminals with their ε-rule.
+ * The error is then detected by the next terminal, which reports it
+ * in the context of the enclosing rule (e.g. missing '}' of a block).
+ * @param {Grammar} grammar
+ */
+function fillDefaultRules(grammar) {
+	for(const rule of grammar.rules) {
+		if(rule.rhs.length) continue;
+
+		const row = grammar.table[grammar.nonTerminals.indexOf(rule.lhs)];
+		for(let i = 0; i < row.length; i++) {
+			if(!row[i]) row[i] = rule.id;
+		}
+	}
+}
+
+/**
+ * @param {string} terminal
+ * @return {string}
+ */
+function terminalToIdentifier(terminal) {
+	return "LL_T_" + (TERMINAL_NAMES[terminal] || terminal.toUpperCase());
+}
+
+/**
+ * @param {string} nonTerminal
+ * @return {string}
+ */
+function nonTerminalToIdentifier(nonTerminal) {
+	return "LL_N_" + nonTerminal.toUpperCase().replace(/-/g, "_");
+}
+
+/**
+ * @param {Grammar} grammar
+ * @param {string} symbol
+ * @return {string}
+ */
+function symbolToIdentifier(grammar, symbol) {
+	if(grammar.nonTerminals.includes(symbol)) return nonTerminalToIdentifier(symbol);
+	return terminalToIdentifier(symbol);
+}
+
+/**
+ * @param {Grammar} grammar
+ * @return {string}
+ */
+function generateHeader(grammar) {
+	const maxLength = Math.max(...grammar.rules.map(e => e.rhs.length));
+	const pad = (/** @type {string} */ str, /** @type {number} */ length) => str + " ".repeat(Math.max(0, length - str.length));
+
+	const terminals = grammar.terminals.map(e => `\t${terminalToIdentifier(e)}, // ${e}`);
+	const nonTerminals = grammar.nonTerminals.map(e => `\t${nonTerminalToIdentifier(e)},`);
+
+	const names = [
+		`\t"<none>",`,
+		...grammar.terminals.map(e => `\t"${e}",`),
+		...grammar.nonTerminals.map(e => `\t"${e}",`)
+	];
+
+	const rules = [
+		`\t/* 0 */ {LL_NONE},`,
+		...grammar.rules.map(e => `\t/* ${e.id} */ {${e.rhs.length ? e.rhs.map(e => symbolToIdentifier(grammar, e)).join(", ") : "LL_NONE"}},`)
+	];
+
+	const lhs = [
+		`\tLL_NONE,`,
+		...grammar.rules.map(e => `\t${nonTerminalToIdentifier(e.lhs)}, // ${e.id}`)
+	];
+
+	const width = Math.max(...grammar.nonTerminals.map(e => e.length));
+	const table = grammar.table.map((row, i) => `\t/* ${pad(grammar.nonTerminals[i], width)} */ {${row.map(e => String(e).padStart(2, " ")).join(",")}},`);
+
+	return `/**
+ * @file include/compiler/parser/LLTable.h
+ * @author docs/generate_ll_table.js
+ * @brief This file is generated automatically from docs/ll_grammar.md and docs/ll_table.md. Do not edit manually!
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef LL_TABLE_H
+#define LL_TABLE_H
+
+enum LLSymbol {
+	LL_NONE = 0,
+
+	// Terminals
+${terminals.join("\n")}
+
+	// Non-terminals
+${nonTerminals.join("\n")}
+
+	LL_SYMBOL_COUNT
+};
+
+#define LL_TERMINAL_FIRST ${terminalToIdentifier(grammar.terminals[0])}
+#define LL_NON_TERMINAL_FIRST ${nonTerminalToIdentifier(grammar.nonTerminals[0])}
+#define LL_TERMINAL_COUNT (LL_NON_TERMINAL_FIRST - LL_TERMINAL_FIRST)
+#define LL_NON_TERMINAL_COUNT (LL_SYMBOL_COUNT - LL_NON_TERMINAL_FIRST)
+
+#define LL_RULE_COUNT ${grammar.rules.length}
+#define LL_MAX_RULE_LENGTH ${maxLength}
+
+#define is_ll_terminal(symbol) ((symbol) >= LL_TERMINAL_FIRST && (symbol) < LL_NON_TERMINAL_FIRST)
+#define is_ll_non_terminal(symbol) ((symbol) >= LL_NON_TERMINAL_FIRST && (symbol) < LL_SYMBOL_COUNT)
+
+/**
+ * Human readable names of the symbols (used in error messages).
+ */
+static const char *LL_SYMBOL_NAMES[LL_SYMBOL_COUNT] = {
+${names.join("\n")}
+};
+
+/**
+ * Right sides of the rules, terminated by LL_NONE.
+ */
+static const unsigned char LL_RULES[LL_RULE_COUNT + 1][LL_MAX_RULE_LENGTH + 1] = {
+${rules.join("\n")}
+};
+
+/**
+ * Left sides of the rules.
+ */
+static const unsigned char LL_RULE_LHS[LL_RULE_COUNT + 1] = {
+${lhs.join("\n")}
+};
+
+/**
+ * Rule to expand for the non-terminal on the top of the stack and the terminal
+ * on the input, indexed as [nonTerminal - LL_NON_TERMINAL_FIRST][terminal - LL_TERMINAL_FIRST].
+ * Zero means a syntax error. Empty cells of nullable non-terminals are filled with their ε-rule.
+ */
+static const unsigned char LL_TABLE[LL_NON_TERMINAL_COUNT][LL_TERMINAL_COUNT] = {
+${table.join("\n")}
+};
+
+#endif
+
+/** End of file include/compiler/parser/LLTable.h **/
+`;
+}
@@ -7,7 +7,7 @@
 
 #include <stdbool.h>
 
-#define ALLOCATOR_SET_SIZE 2048
+#define ALLOCATOR_SET_SIZE 65536
 
 typedef struct PointerNode {
 	void *ptr;
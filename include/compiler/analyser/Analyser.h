@@ -8,6 +8,7 @@
 #include "internal/Array.h"
 #include "internal/String.h"
 #include "internal/HashMap.h"
+#include "internal/BitSet.h"
 #include "compiler/analyser/AnalyserResult.h"
 
 #ifndef ANALYSER_H
@@ -31,6 +32,7 @@ typedef struct VariableDeclaration {
 	struct VariableDeclaratorASTNode /* | null*/ *node; // null if isUserDefined = 0
 	String *name;
 	ValueType type;
+	struct BlockScope *scope; // Scope the variable is bound in, null until it is bound
 	bool isConstant;
 	bool isUserDefined;
 	bool isUsed;
@@ -41,14 +43,20 @@ typedef struct FunctionDeclaration {
 	enum DeclarationType _type;
 	size_t id;
 	struct FunctionDeclarationASTNode *node;
-	HashMap /*<id: String, declaration: VariableDeclaration>*/ *variables;
+	Array /*<VariableDeclaration>*/ *variables; // Local variables in order of declaration
+	Array /*<Declaration> | null*/ *dependencies; // Called functions and referenced global variables, null if there are none
+	size_t bindingsOffset; // Number of the global bindings visible in the body
 	bool isUsed;
+	bool isAnalysed; // Whether the current body was analysed successfully
+	bool isTailRecursive; // Whether the body contains a self-recursive call in the tail position
+	bool isLeaf; // Whether the body calls no other user functions (except the tail calls), set by the optimizer
 	ValueType returnType;
 } FunctionDeclaration;
 
 typedef struct BlockScope {
 	struct BlockScope *parent;
-	HashMap /*<name: String, declaration: VariableDeclaration>*/ *variables;
+	Array /*<VariableDeclaration> | null*/ *declarations; // Bound once the scope is entered (parameters, loop iterator, optional binding)
+	size_t bindingsOffset; // Size of the binding stack when the scope was entered
 	FunctionDeclaration *function; // Defined when this is function body scope
 	StatementASTNode /*<loop: ForStatementASTNode | WhileStatementASTNode>*/ *loop; // Defined when this is loop body scope
 } BlockScope;
@@ -57,13 +65,45 @@ typedef struct Analyser {
 	ProgramASTNode *ast;
 	BlockScope *globalScope;
 	HashMap /*<name: String, declarations: Array<FunctionDeclaration>>*/ *overloads; // Relative to global scope
-	HashMap /*<id: String, declaration: FunctionDeclaration>*/ *functions; // Relative to global scope //! Unused
-	HashMap /*<id: String, declaration: VariableDeclaration>*/ *variables; // Relative to global scope //! Unused
-	HashMap /*<id: String, declaration: Declaration>*/ *idsPool;
+	HashMap /*<selector: String, declarations: Array<FunctionDeclaration>>*/ *selectors; // Overloads grouped by argument labels, e.g. "foo(_:with:)"
+	HashMap /*<name: String, bindings: Array<VariableDeclaration>>*/ *symbols; // Variables visible in the analysed scope, the innermost binding of the name is the last one
+	Array /*<Array<VariableDeclaration>>*/ *bindings; // Binding arrays of the symbols in order of binding, popped when leaving a scope
+	Array /*<FunctionDeclaration>*/ *functions; // Relative to global scope, in order of declaration
+	Array /*<VariableDeclaration>*/ *variables; // Relative to global scope, in order of declaration
+	Array /*<Declaration | null>*/ *declarations; // Indexed by id, null for ids not assigned to a declaration
+	BitSet *globals; // Ids of the declarations in global scope
+	BitSet *dependencies; // Ids of the functions and global variables referenced by the global code
+	FunctionDeclaration /* | null*/ *function; // Function whose body is being analysed, null in the global code
 	HashMap /*<String, String>*/ *types; // TODO: delete this
 	size_t idCounter; // Do NOT directly modify this!
+	size_t epoch; // Incremented for each analysed statement, older memoized call resolutions are discarded
+	bool isAnalysed; // Whether the whole program was analysed successfully, required by re-analysis
 } Analyser;
 
+/**
+ * Memoized result of resolving a function call with the specific preffered type.
+ */
+typedef struct ResolvedCall {
+	size_t epoch;
+	ValueType prefferedType;
+	ValueType type;
+	FunctionDeclaration /* | null*/ *declaration; // null if the resolution failed
+	AnalyserResult result;
+} ResolvedCall;
+
+/**
+ * Arguments and the result of a recursive analyser call made on a new stack segment.
+ */
+typedef struct AnalyserCall {
+	Analyser *analyser;
+	ASTNode *node;
+	BlockScope *scope;
+	ValueType prefferedType;
+	ValueType *outType;
+	AnalyserResult result;
+	bool isReachable;
+} AnalyserCall;
+
 
 /* Analyser */
 /**
@@ -86,6 +126,19 @@ void Analyser_destructor(Analyser *analyser);
  */
 AnalyserResult Analyser_analyse(Analyser *analyser, ProgramASTNode *ast);
 
+/**
+ * Re-analyses the program after some of its function declarations were replaced in the AST by newly parsed ones.
+ * Only the bodies of the replaced functions and of the functions calling an overload whose signature changed are analysed again,
+ * declarations of the rest of the program are reused from the previous analysis.
+ * Changes that cannot be handled this way (a renamed, added or removed function, a changed signature the global code depends on)
+ * require a full analysis of the newly parsed program.
+ * @param analyser
+ * @param functions The new function declaration nodes, each of them replaced a declaration of the same name in the AST
+ * @param outResult The result of the re-analysis
+ * @return false if a full analysis is required (the analyser is left untouched), true otherwise
+ */
+bool Analyser_reanalyse(Analyser *analyser, Array /*<FunctionDeclarationASTNode>*/ *functions, AnalyserResult *outResult);
+
 
 /**
  * Returns the declaration with the provided id or null if it doesn't exist.
@@ -114,6 +167,7 @@ VariableDeclaration /* | null*/* Analyser_getVariableById(Analyser *analyser, si
 /**
  * Returns the variable declaration with the provided name,
  * reachable from provided scope or null if it doesn't exist.
+ * Only the currently analysed scope can be searched (the global scope once the analysis is finished).
  * @param analyser
  * @param name Name of the function
  * @param scope Scope to search from
@@ -210,6 +264,13 @@ void FunctionDeclaration_free(FunctionDeclaration *declaration);
  */
 BlockScope* BlockScope_alloc(BlockScope *parent);
 
+/**
+ * Adds a variable declaration to be bound once the scope is entered.
+ * @param scope
+ * @param declaration
+ */
+void BlockScope_addDeclaration(BlockScope *scope, VariableDeclaration *declaration);
+
 #endif
 
 /** End of file include/compiler/analyser/Analyser.h **/
@@ -36,8 +36,9 @@ AnalyserResult AnalyserResult_construct(
 	Array *markers
 );
 
-#define AnalyserSuccess() AnalyserResult_construct(RESULT_SUCCESS, SEVERITY_NONE, NULL, NULL)
-#define AnalyserNoMatch() AnalyserResult_construct(RESULT_NO_MATCH, SEVERITY_NONE, NULL, NULL)
+// Non-error results are built in place (members not listed are zeroed), only errors go through the constructor
+#define AnalyserSuccess() ((AnalyserResult){.success = true, .type = RESULT_SUCCESS, .severity = SEVERITY_NONE})
+#define AnalyserNoMatch() ((AnalyserResult){.success = true, .type = RESULT_NO_MATCH, .severity = SEVERITY_NONE})
 #define AnalyserError(type, message, markers) AnalyserResult_construct(type, SEVERITY_ERROR, message, markers)
 
 #endif
@@ -6,23 +6,74 @@
  */
 
 #include <stdio.h>
+#include <stdbool.h>
 
 #include "compiler/parser/ASTNodes.h"
+#include "compiler/codegen/Instruction.h"
+#include "compiler/codegen/FrameAllocator.h"
 
 #ifndef CODEGEN_H
 #define CODEGEN_H
 
-enum Frame {
-	FRAME_GLOBAL,
-	FRAME_LOCAL,
-	FRAME_TEMPORARY
+/**
+ * Maximum number of AST nodes of an operand searched for a function call, larger operands are assumed to contain one.
+ */
+#define CODEGEN_CALL_SEARCH_BUDGET 64
+
+/**
+ * Maximum number of the arguments of a built-in function lowered to the target instructions in place of the call.
+ */
+#define CODEGEN_MAX_INLINE_ARGUMENTS 3
+
+/**
+ * @brief Routines implementing the built-in functions and operators in the target code.
+ */
+enum BuiltInRoutine {
+	ROUTINE_ORD,
+	ROUTINE_CHR,
+	ROUTINE_LENGTH,
+	ROUTINE_SUBSTRING,
+	ROUTINE_STRINGIFY_INT,
+	ROUTINE_STRINGIFY_DOUBLE,
+	ROUTINE_COALESCING,
+	ROUTINES_COUNT
+};
+
+/**
+ * @brief Lowering of the expressions to the target code.
+ */
+enum ExpressionLowering {
+	LOWERING_STACK,         // Operands are pushed to the data stack and combined by the stack instructions (ADDS, LTS, ...)
+	LOWERING_THREE_ADDRESS  // Results are written to the temporary variables of the current frame (ADD, LT, ...)
 };
 
 typedef struct Codegen {
 	Analyser *analyser;
 	enum Frame frame;
+	bool usedRoutines[ROUTINES_COUNT]; // Only the called routines are generated (after the main body)
+	InstructionList instructions;
+	enum ExpressionLowering lowering;
+	size_t temporaries; // Number of the temporary variables in use
+	size_t maxTemporaries; // Number of the temporary variables declared in the current frame
+	size_t labels; // Number of the labels generated within the expressions, used to make them unique
+	FrameAllocator allocator; // Local variables of each function are allocated once its body is generated
+	InstructionList leafVariables; // Declarations of the variables of the leaf functions, moved to the global frame
+	size_t leafTemporaries; // Number of the temporary variables shared by the leaf functions
 } Codegen;
 
+/**
+ * @brief Arguments of a recursive walker call made on a new stack segment.
+ */
+typedef struct CodegenCall {
+	Codegen *codegen;
+	ASTNode *node;
+	Operand *destination;
+	Operand result;
+	char *label; // Target of the evaluated condition
+	size_t labelId;
+	bool isJumpIfTrue;
+} CodegenCall;
+
 
 /**
  * @brief Initializes a Codegen instance with the specified Analyser.
@@ -30,7 +81,7 @@ typedef struct Codegen {
  * This function constructs a Codegen instance, associating it with a given Analyser.
  * The Analyser is crucial for code generation as it provides necessary information
  * from the analysis phase. Additionally, the function sets the initial frame of the
- * Codegen instance to FRAME_GLOBAL.
+ * Codegen instance to FRAME_GLOBAL and the expression lowering to LOWERING_THREE_ADDRESS.
  *
  * @param codegen A pointer to the Codegen instance to be initialized.
  * @param analyser A pointer to the Analyser instance to be associated with the Codegen.
@@ -45,8 +96,23 @@ void Codegen_constructor(Codegen *codegen, Analyser *analyser);
  */
 void Codegen_destructor(Codegen *codegen);
 
+/**
+ * @brief Generates the instruction list of the analysed program.
+ *
+ * Nothing is printed, use Codegen_emit to output the generated code.
+ *
+ * @param codegen A pointer to the Codegen instance.
+ */
 void Codegen_generate(Codegen *codegen);
 
+/**
+ * @brief Prints the generated instruction list as the IFJcode23 source.
+ *
+ * @param codegen A pointer to the Codegen instance.
+ * @param stream The output stream.
+ */
+void Codegen_emit(Codegen *codegen, FILE *stream);
+
 #endif // CODEGEN_H
 
 /** End of file include/compiler/codegen/Codegen.h **/
@@ -0,0 +1,55 @@
+/**
+ * @file include/compiler/codegen/FrameAllocator.h
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Reuse of the frame variables with disjoint lifetimes.
+ * @copyright Copyright (c) 2023
+ */
+
+#include "compiler/codegen/Instruction.h"
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+typedef struct FrameAllocator {
+	size_t variables; // Number of the local variables declared by the generated code
+	size_t slots; // Number of the local variables left after the allocation
+} FrameAllocator;
+
+
+/**
+ * @brief Initializes a FrameAllocator instance with zero counters.
+ *
+ * @param allocator A pointer to the FrameAllocator instance to be initialized.
+ */
+void FrameAllocator_constructor(FrameAllocator *allocator);
+
+/**
+ * @brief Dissociates resources for a FrameAllocator instance.
+ *
+ * @param allocator A pointer to the FrameAllocator instance to be destructed.
+ */
+void FrameAllocator_destructor(FrameAllocator *allocator);
+
+/**
+ * @brief Assigns the local variables declared in the list to the shared slots.
+ *
+ * The list is expected to contain the whole body of a single function. The
+ * live variables are computed for each basic block, the lifetime of a variable
+ * is then the range of the instructions from the first to the last point it is
+ * live at. The variables are scanned in the order of their lifetimes and each
+ * one reuses a slot whose variable is no longer live (linear scan), so the
+ * variables with disjoint lifetimes share a single declaration.
+ *
+ * Only the local variables declared by the list itself are allocated, the
+ * parameters and the return value are declared by the caller in the temporary
+ * frame and keep their names. The declarations of the unused variables are
+ * removed. If the list jumps to a label it does not contain, it is left intact.
+ *
+ * @param allocator A pointer to the FrameAllocator instance counting the variables.
+ * @param list The instruction list of a function body to be rewritten.
+ */
+void FrameAllocator_allocate(FrameAllocator *allocator, InstructionList *list);
+
+#endif // FRAME_ALLOCATOR_H
+
+/** End of file include/compiler/codegen/FrameAllocator.h **/
@@ -8,41 +8,269 @@
 #ifndef INSTRUCTION_H
 #define INSTRUCTION_H
 
+#include <stdio.h>
+#include <stdbool.h>
+
 #include "internal/String.h"
-#include "compiler/codegen/Codegen.h"
+#include "internal/Array.h"
+
+#define INSTRUCTION_MAX_OPERANDS 3
 
-#define INSTRUCTION_NULLARY(ins) \
-	fprintf(stdout, "%s\n", ins);
+#define INSTRUCTION_NULLARY(opcode) \
+	Instruction_emit(opcode, 0);
 
 #define NEWLINE \
-    fprintf(stdout, "\n");
+	Instruction_emit(OPCODE_NEWLINE, 0);
 
 #define COMMENT(comment) \
-    fprintf(stdout, "# %s\n", comment);
+	Instruction_comment(String_alloc(comment));
 
 #define COMMENT_FUNC(declaration) \
-    fprintf(stdout, "# Function %s (%lu)\n", declaration->id->name->value, declaration->id->id);
+	Instruction_comment(String_fromFormat("Function %s (%lu)", declaration->id->name->value, declaration->id->id));
 
 #define COMMENT_VAR(declaration) \
-    fprintf(stdout, "# Variable %s (%lu)\n", declaration->name->value, declaration->id);
+	Instruction_comment(String_fromFormat("Variable %s (%lu)", declaration->name->value, declaration->id));
 
 #define COMMENT_WHILE(id) \
-    fprintf(stdout, "# While loop %lu\n", id);
+	Instruction_comment(String_fromFormat("While loop %lu", id));
 
 #define COMMENT_FOR(id) \
-    fprintf(stdout, "# For loop %lu\n", id);
+	Instruction_comment(String_fromFormat("For loop %lu", id));
 
 #define COMMENT_IF(id) \
-    fprintf(stdout, "# If statement %lu\n", id);
+	Instruction_comment(String_fromFormat("If statement %lu", id));
 
 #define COMMENT_IF_BLOCK(id) \
-    fprintf(stdout, "# If %lu block\n", id);
+	Instruction_comment(String_fromFormat("If %lu block", id));
 
 #define COMMENT_ELSE_BLOCK(id) \
-    fprintf(stdout, "# If %lu else\n", id);
+	Instruction_comment(String_fromFormat("If %lu else", id));
 
 #define HEADER \
-    fprintf(stdout, ".IFJcode23\n");
+	Instruction_emit(OPCODE_HEADER, 0);
+
+#define is_opcode_jump(opcode) ((opcode) >= OPCODE_JUMP && (opcode) <= OPCODE_JUMPIFNEQS)
+#define is_opcode_pseudo(opcode) ((opcode) >= OPCODE_HEADER)
+
+// The first operand is the variable the result is written to
+#define is_opcode_assignment(opcode) ( \
+	(opcode) == OPCODE_MOVE || (opcode) == OPCODE_POPS || (opcode) == OPCODE_READ || (opcode) == OPCODE_TYPE || \
+	((opcode) >= OPCODE_ADD && (opcode) <= OPCODE_IDIV) || \
+	((opcode) >= OPCODE_LT && (opcode) <= OPCODE_EQ) || \
+	((opcode) >= OPCODE_AND && (opcode) <= OPCODE_NOT) || \
+	((opcode) >= OPCODE_INT2FLOAT && (opcode) <= OPCODE_STRI2INT) || \
+	((opcode) >= OPCODE_CONCAT && (opcode) <= OPCODE_GETCHAR) \
+)
+
+// The control leaves the block (the calls are included, the callee works with the same data stack)
+#define is_opcode_block_end(opcode) (is_opcode_jump(opcode) || (opcode) == OPCODE_CALL || (opcode) == OPCODE_RETURN || (opcode) == OPCODE_EXIT)
+
+enum Frame {
+	FRAME_GLOBAL,
+	FRAME_LOCAL,
+	FRAME_TEMPORARY
+};
+
+/**
+ * @brief Operation codes of the target code, followed by the pseudo-instructions used only for the textual output.
+ */
+enum Opcode {
+	OPCODE_MOVE,
+	OPCODE_CREATEFRAME,
+	OPCODE_PUSHFRAME,
+	OPCODE_POPFRAME,
+	OPCODE_DEFVAR,
+	OPCODE_CALL,
+	OPCODE_RETURN,
+	OPCODE_PUSHS,
+	OPCODE_POPS,
+	OPCODE_CLEARS,
+	OPCODE_ADD,
+	OPCODE_SUB,
+	OPCODE_MUL,
+	OPCODE_DIV,
+	OPCODE_IDIV,
+	OPCODE_ADDS,
+	OPCODE_SUBS,
+	OPCODE_MULS,
+	OPCODE_DIVS,
+	OPCODE_IDIVS,
+	OPCODE_LT,
+	OPCODE_GT,
+	OPCODE_EQ,
+	OPCODE_LTS,
+	OPCODE_GTS,
+	OPCODE_EQS,
+	OPCODE_AND,
+	OPCODE_OR,
+	OPCODE_NOT,
+	OPCODE_ANDS,
+	OPCODE_ORS,
+	OPCODE_NOTS,
+	OPCODE_INT2FLOAT,
+	OPCODE_FLOAT2INT,
+	OPCODE_INT2CHAR,
+	OPCODE_STRI2INT,
+	OPCODE_INT2FLOATS,
+	OPCODE_FLOAT2INTS,
+	OPCODE_INT2CHARS,
+	OPCODE_STRI2INTS,
+	OPCODE_READ,
+	OPCODE_WRITE,
+	OPCODE_CONCAT,
+	OPCODE_STRLEN,
+	OPCODE_GETCHAR,
+	OPCODE_SETCHAR,
+	OPCODE_TYPE,
+	OPCODE_LABEL,
+	OPCODE_JUMP,
+	OPCODE_JUMPIFEQ,
+	OPCODE_JUMPIFNEQ,
+	OPCODE_JUMPIFEQS,
+	OPCODE_JUMPIFNEQS,
+	OPCODE_EXIT,
+	OPCODE_BREAK,
+	OPCODE_DPRINT,
+	OPCODE_HEADER,
+	OPCODE_COMMENT,
+	OPCODE_NEWLINE
+};
+
+enum OperandType {
+	OPERAND_NONE,
+	OPERAND_VARIABLE,
+	OPERAND_LABEL,
+	OPERAND_TYPE,
+	OPERAND_INT,
+	OPERAND_FLOAT,
+	OPERAND_BOOL,
+	OPERAND_NIL,
+	OPERAND_STRING
+};
+
+/**
+ * @brief Operand of an instruction.
+ *
+ * Variables and labels are named as `$name`, `$id` or `$name_id` (`name` is always a string literal).
+ * The string literals are kept unescaped, they are escaped by the serializer.
+ */
+typedef struct Operand {
+	enum OperandType type;
+	enum Frame frame;
+	char *name;
+	size_t id;
+	bool hasId;
+	union {
+		long integer;
+		double floating;
+		bool boolean;
+		String *string;
+	} value;
+} Operand;
+
+typedef struct Instruction {
+	enum Opcode opcode;
+	Operand operands[INSTRUCTION_MAX_OPERANDS];
+	String *comment;
+} Instruction;
+
+typedef struct InstructionList {
+	Array /*<Instruction>*/ *instructions;
+} InstructionList;
+
+/**
+ * @brief Range [start, end) of the instructions executed in sequence.
+ */
+typedef struct BasicBlock {
+	size_t start;
+	size_t end;
+} BasicBlock;
+
+
+// --- LIST ---
+
+void InstructionList_constructor(InstructionList *list);
+
+void InstructionList_destructor(InstructionList *list);
+
+/**
+ * @brief Selects the list the following instructions are appended to.
+ *
+ * @param list The list to append to.
+ */
+void InstructionList_select(InstructionList *list);
+
+/**
+ * @brief Appends the instructions of the other list to the end of the list.
+ *
+ * @param list The list to append to.
+ * @param other The appended list.
+ */
+void InstructionList_append(InstructionList *list, InstructionList *other);
+
+/**
+ * @brief Splits the list into basic blocks.
+ *
+ * A block starts at the first instruction, at every label and after every
+ * jump, call, return and exit. Pseudo-instructions do not affect the boundaries.
+ *
+ * @param list The list to split.
+ * @return Array of the BasicBlock ranges covering the whole list.
+ */
+Array /*<BasicBlock>*/* InstructionList_getBasicBlocks(InstructionList *list);
+
+/**
+ * @brief Prints the list as the IFJcode23 source.
+ *
+ * @param list The list to print.
+ * @param stream The output stream.
+ */
+void InstructionList_serialize(InstructionList *list, FILE *stream);
+
+// --- OPERANDS ---
+
+Operand Operand_variable(enum Frame frame, char *name);
+
+Operand Operand_variable_id(enum Frame frame, size_t id);
+
+Operand Operand_variable_named_id(enum Frame frame, char *name, size_t id);
+
+Operand Operand_label(char *name);
+
+Operand Operand_label_id(char *name, size_t id);
+
+Operand Operand_type(char *name);
+
+Operand Operand_int(long value);
+
+Operand Operand_float(double value);
+
+Operand Operand_bool(bool value);
+
+Operand Operand_nil();
+
+Operand Operand_string(String *value);
+
+/**
+ * @brief Checks whether both operands refer to the same variable.
+ */
+bool Operand_isSameVariable(Operand *a, Operand *b);
+
+/**
+ * @brief Checks whether both variables or labels have the same name (the frame is not compared).
+ */
+bool Operand_isSameName(Operand *a, Operand *b);
+
+/**
+ * @brief Appends an instruction to the selected list.
+ *
+ * @param opcode The operation code.
+ * @param count Number of the Operand arguments that follow.
+ * @return The appended instruction.
+ */
+Instruction* Instruction_emit(enum Opcode opcode, int count, ...);
+
+void Instruction_comment(String *comment);
 
 void Instruction_pops(char * where, enum Frame frame);
 
@@ -136,6 +364,8 @@ void Instruction_call(char *label);
 
 void Instruction_return();
 
+void Instruction_exit(int code);
+
 void Instruction_jump_ifeqs(char *label);
 
 void Instruction_getchar(enum Frame resultScope, char *result, enum Frame inputScope, char *input, enum Frame indexScope, char *index);
@@ -168,7 +398,9 @@ void Instruction_move_bool_id(enum Frame destinationScope, size_t id, bool value
 
 void Instruction_add_int(enum Frame destinationScope, char *destination, enum Frame sourceScope, char *source, int value);
 
-void Instruction_add_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, int value);
+void Instruction_add_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, long int value);
+
+void Instruction_mul_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, long int value);
 
 void Instruction_label_id(char *label, size_t id);
 
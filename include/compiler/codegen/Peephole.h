@@ -0,0 +1,79 @@
+/**
+ * @file include/compiler/codegen/Peephole.h
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Peephole optimization of the generated instruction list.
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdio.h>
+
+#include "compiler/codegen/Instruction.h"
+
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+/**
+ * @brief Rewriting rules applied to the windows of the adjacent instructions.
+ */
+enum PeepholeRule {
+	PEEPHOLE_PUSH_POP,          // PUSHS a; POPS x -> MOVE x a
+	PEEPHOLE_PUSH_MOVE_POP,     // PUSHS a; MOVE y b; POPS x -> MOVE y b; MOVE x a
+	PEEPHOLE_STACK_OPERATION,   // PUSHS a; PUSHS b; ADDS; POPS x -> ADD x a b
+	PEEPHOLE_HELPER_SOURCE,     // MOVE $TMP a; WRITE $TMP -> WRITE a
+	PEEPHOLE_HELPER_RESULT,     // CONCAT $TMP a b; MOVE x $TMP -> CONCAT x a b
+	PEEPHOLE_COMPARE_JUMP,      // EQS; PUSHS bool@true; JUMPIFNEQS l -> JUMPIFNEQS l
+	PEEPHOLE_NEGATED_JUMP,      // NOTS; PUSHS bool@true; JUMPIFNEQS l -> PUSHS bool@true; JUMPIFEQS l
+	PEEPHOLE_OPERAND_JUMP,      // PUSHS a; PUSHS b; JUMPIFEQS l -> JUMPIFEQ l a b
+	PEEPHOLE_JUMP_NEXT,         // JUMP l; LABEL l -> LABEL l
+	PEEPHOLE_RULES_COUNT
+};
+
+typedef struct Peephole {
+	size_t hits[PEEPHOLE_RULES_COUNT]; // Number of the rewrites done by each rule
+	size_t inputSize; // Number of the instructions before the optimization (without pseudo-instructions)
+	size_t outputSize; // Number of the instructions after the optimization (without pseudo-instructions)
+} Peephole;
+
+
+/**
+ * @brief Initializes a Peephole instance with zero hit counters.
+ *
+ * @param peephole A pointer to the Peephole instance to be initialized.
+ */
+void Peephole_constructor(Peephole *peephole);
+
+/**
+ * @brief Dissociates resources for a Peephole instance.
+ *
+ * @param peephole A pointer to the Peephole instance to be destructed.
+ */
+void Peephole_destructor(Peephole *peephole);
+
+/**
+ * @brief Rewrites the instruction list in a single pass.
+ *
+ * The instructions are moved to the output one by one and the rules are
+ * matched against the end of the output until none of them applies, so
+ * the rewritten instructions are matched again with their predecessors.
+ * A window never spans a pseudo-instruction (comment or blank line).
+ *
+ * The helper variables of the code generator (the named global variables,
+ * e.g. `GF@$WRITE_TMP`) are always written right before they are read,
+ * so their values are never needed after the reading instruction.
+ *
+ * @param peephole A pointer to the Peephole instance counting the rewrites.
+ * @param list The instruction list to be rewritten.
+ */
+void Peephole_optimize(Peephole *peephole, InstructionList *list);
+
+/**
+ * @brief Prints the instruction counts and the number of the rewrites done by each rule.
+ *
+ * @param peephole A pointer to the Peephole instance with the counters.
+ * @param stream The stream to print the statistics to.
+ */
+void Peephole_printStats(Peephole *peephole, FILE *stream);
+
+#endif // PEEPHOLE_H
+
+/** End of file include/compiler/codegen/Peephole.h **/
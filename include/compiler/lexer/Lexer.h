@@ -20,6 +20,7 @@ typedef struct Lexer {
 	int line;
 	int column;
 	enum WhitespaceType whitespace; // Left whitespace
+	LexerResult error; // Details of the last error (reported by `Lexer_next`, `Lexer_peek` and the scanners)
 } Lexer;
 
 
@@ -56,6 +57,13 @@ bool Lexer_isAtEnd(Lexer *lexer);
  */
 LexerResult Lexer_nextToken(Lexer *lexer);
 
+/**
+ * Returns the next token in token stream without constructing a result.
+ * @param lexer
+ * @return Next token, or NULL if tokenization fails (the error is stored in `lexer->error`)
+ */
+Token* Lexer_next(Lexer *lexer);
+
 /**
  * Returns the token at the given offset in token stream.
  * @param lexer
@@ -64,6 +72,15 @@ LexerResult Lexer_nextToken(Lexer *lexer);
  */
 LexerResult Lexer_peekToken(Lexer *lexer, int offset);
 
+/**
+ * Returns the token at the given offset in token stream without constructing a result.
+ * Tokens that have not been lexed yet are tokenized ahead, the current position is left untouched.
+ * @param lexer
+ * @param offset
+ * @return Token at the given offset, EOF token when peeking past the end, or NULL before the start of the stream or if tokenization fails (the error is stored in `lexer->error`)
+ */
+Token* Lexer_peek(Lexer *lexer, int offset);
+
 /**
  * Tokenizes the whole source code at once and updates the internal token stream.
  * @param lexer
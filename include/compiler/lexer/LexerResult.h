@@ -40,8 +40,9 @@ LexerResult LexerResult_construct(
 	Token *token
 );
 
-#define LexerSuccess() LexerResult_construct(RESULT_SUCCESS, SEVERITY_NONE, NULL, NULL, NULL)
-#define LexerNoMatch() LexerResult_construct(RESULT_NO_MATCH, SEVERITY_NONE, NULL, NULL, NULL)
+// Non-error results are built in place (members not listed are zeroed), only errors go through the constructor
+#define LexerSuccess() ((LexerResult){.success = true, .type = RESULT_SUCCESS, .severity = SEVERITY_NONE})
+#define LexerNoMatch() ((LexerResult){.success = true, .type = RESULT_NO_MATCH, .severity = SEVERITY_NONE})
 #define LexerError(message, markers) LexerResult_construct(RESULT_ERROR_LEXICAL_ANALYSIS, SEVERITY_ERROR, message, markers, NULL)
 #define LexerErrorCustom(type, message, markers) LexerResult_construct(type, SEVERITY_ERROR, message, markers, NULL)
 
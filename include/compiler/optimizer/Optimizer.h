@@ -0,0 +1,102 @@
+/**
+ * @file include/compiler/optimizer/Optimizer.h
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Optimization passes over the analysed AST.
+ * @copyright Copyright (c) 2023
+ */
+
+#include "internal/Array.h"
+#include "internal/BitSet.h"
+#include "compiler/parser/ASTNodes.h"
+#include "compiler/analyser/Analyser.h"
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+/**
+ * Maximum number of AST nodes of the function body (including the copies of the arguments) that gets inlined.
+ */
+#define OPTIMIZER_INLINE_BUDGET 32
+
+/**
+ * Maximum number of the function bodies inlined into each other.
+ */
+#define OPTIMIZER_INLINE_DEPTH 4
+
+/**
+ * Maximum number of the loops nested in the loop whose invariants are hoisted, each loop traverses its whole body.
+ */
+#define OPTIMIZER_HOIST_LOOPS 8
+
+/**
+ * Maximum number of the nested operations over the iterator of the for loop recognized as a derived induction variable.
+ */
+#define OPTIMIZER_INDUCTION_DEPTH 3
+
+typedef struct Optimizer {
+	Analyser *analyser;
+	FunctionDeclaration /* | null*/ *function; // Function being optimized, null for the global code
+	Array /*<FunctionDeclaration>*/ *inlining; // Functions whose bodies are being inlined
+} Optimizer;
+
+/**
+ * Arguments and the result of a recursive optimizer call made on a new stack segment.
+ */
+typedef struct OptimizerCall {
+	Optimizer *optimizer;
+	ASTNode *node;
+	ASTNode *result;
+} OptimizerCall;
+
+/**
+ * Replacement of a parameter or a local variable in the copy of the inlined function body.
+ */
+typedef struct InlinedVariable {
+	size_t id; // Id of the variable in the inlined function
+	ExpressionASTNode *replacement; // Copied to each use of the variable
+} InlinedVariable;
+
+/**
+ * Loop whose invariant expressions are being hoisted in front of it.
+ */
+typedef struct LoopScope {
+	BitSet *modified; // Ids of the variables declared or assigned in the loop
+	bool hasCalls; // Whether the loop calls the functions declared by the user (which could assign the global variables)
+	Array /*<VariableDeclarationASTNode>*/ *hoisted; // Declarations of the temporaries placed before the loop
+} LoopScope;
+
+
+/**
+ * Constructs the provided Optimizer instance.
+ * @param optimizer
+ * @param analyser Analyser that successfully analysed the program to optimize
+ */
+void Optimizer_constructor(Optimizer *optimizer, Analyser *analyser);
+
+/**
+ * Destructs the provided Optimizer instance.
+ * @param optimizer
+ */
+void Optimizer_destructor(Optimizer *optimizer);
+
+/**
+ * Optimizes the analysed AST in place, the result is ready to be passed to the code generator.
+ * Binary and unary expressions over literals are folded into a single literal (the semantics of the generated code are kept,
+ * e.g. integer division rounds towards negative infinity and divisions by zero are left to fail at runtime)
+ * and the uses of constants initialized with a (folded) literal are replaced by a copy of the literal.
+ * Branches with a constant test are resolved, statements following a return, break or continue are removed
+ * and the `isUsed` flags of the declarations are recomputed from the main body, so only the reachable functions
+ * and the variables that are actually read or assigned remain (initializers with side effects are kept).
+ * Calls of the small non-recursive functions are replaced by a copy of the body. Bodies consisting of a single return
+ * statement are substituted into the expression directly, straight-line bodies of the calls making up the whole statement
+ * are placed before it with the parameters and the local variables declared again under fresh ids (see `OPTIMIZER_INLINE_BUDGET`).
+ * Expressions of the loops that neither depend on the variables modified in the loop nor can fail (see `is_func_pure`)
+ * are evaluated once into the temporaries declared before the loop and the affine expressions of the for loop iterator
+ * (e.g. `i * 4 + 1`) are replaced by the induction variables incremented along with the iterator.
+ * @param optimizer
+ */
+void Optimizer_optimize(Optimizer *optimizer);
+
+#endif
+
+/** End of file include/compiler/optimizer/Optimizer.h **/
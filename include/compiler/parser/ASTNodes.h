@@ -94,20 +94,22 @@ enum BuiltInFunction {
 	FUNCTION_SUBSTRING,
 	FUNCTION_ORD,
 	FUNCTION_CHR,
-	FUNCTION_INTERNAL_STRINGIFY_NUMBER,
 	FUNCTION_INTERNAL_STRINGIFY_DOUBLE,
 	FUNCTION_INTERNAL_STRINGIFY_INT,
 	FUNCTION_INTERNAL_STRINGIFY_BOOL,
 	FUNCTION_INTERNAL_STRINGIFY_STRING,
-	FUNCTION_INTERNAL_MODULO,
 	FUNCTIONS_COUNT
 };
 
 #define is_func_valid(func) ((func) < FUNCTIONS_COUNT)
 #define is_func_user_defined(func) ((func) == FUNCTION_NONE)
-#define is_func_builtin(func) ((func) > FUNCTION_NONE && (func) < FUNCTION_INTERNAL_STRINGIFY_NUMBER)
-#define is_func_internal(func) ((func) >= FUNCTION_INTERNAL_STRINGIFY_NUMBER && (func) < FUNCTIONS_COUNT)
-#define is_func_generable(func) (is_func_user_defined(func) || is_func_internal(func))
+#define is_func_builtin(func) ((func) > FUNCTION_NONE && (func) < FUNCTION_INTERNAL_STRINGIFY_DOUBLE)
+#define is_func_internal(func) ((func) >= FUNCTION_INTERNAL_STRINGIFY_DOUBLE && (func) < FUNCTIONS_COUNT)
+#define is_func_generable(func) (is_func_user_defined(func)) // Bodies of the other functions are generated by the code generator itself
+#define is_func_pure(func) ( \
+	(func) == FUNCTION_INT_TO_DOUBLE || (func) == FUNCTION_LENGTH || (func) == FUNCTION_SUBSTRING || (func) == FUNCTION_ORD || \
+	is_func_internal(func) \
+) // Built-in functions without side effects that cannot fail at runtime
 
 #define is_type_valid(type) ((type) > TYPE_INVALID)
 #define is_value_assignable(dst, src) (((dst).type == (src).type || (src).type == TYPE_NIL) && ((dst).isNullable || !(src).isNullable))
@@ -178,6 +180,7 @@ typedef struct ReturnStatementASTNode {
 	enum ASTNodeType _type;
 	ExpressionASTNode /* | null*/ *expression;
 	size_t id;
+	bool isTailCall; // Returns the result of calling the enclosing function itself, its frame can be reused
 } ReturnStatementASTNode;
 
 typedef struct BreakStatementASTNode {
@@ -228,6 +231,7 @@ typedef struct FunctionCallASTNode {
 	enum ASTNodeType _type;
 	IdentifierASTNode *id;
 	ArgumentListASTNode *argumentList;
+	Array /*<ResolvedCall>*/ *resolutions; // Memoized by the analyser for each preffered type
 } FunctionCallASTNode;
 
 // typedef struct ExpressionASTNode {
@@ -304,12 +308,19 @@ typedef struct RangeASTNode {
 	enum OperatorType operator;
 } RangeASTNode;
 
+typedef struct InductionVariable {
+	size_t id;
+	long scale; // Value of the variable is `iterator * scale + offset`
+	long offset;
+} InductionVariable;
+
 typedef struct ForStatementASTNode {
 	enum ASTNodeType _type;
 	BlockASTNode *body; // This must be the second field
 	IdentifierASTNode *iterator;
 	size_t id; // This must be the fourth field
 	RangeASTNode *range;
+	Array /*<InductionVariable>*/ *inductions; // Derived from the iterator by the optimizer, incremented along with it
 } ForStatementASTNode;
 
 typedef struct AssignmentStatementASTNode {
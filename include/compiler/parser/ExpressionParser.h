@@ -88,6 +88,14 @@ StackItem* Expr_performReduction(Array *stack);
  */
 bool Expr_Reduce(Array *stack, StackItem *currentToken);
 
+/**
+ * Arguments and the result of __Parser_parseExpression called on a new stack segment.
+ */
+typedef struct ParserExpressionCall {
+	Parser *parser;
+	ParserResult result;
+} ParserExpressionCall;
+
 /**
  * Parses an expression using the precedence climbing method.
  *
@@ -0,0 +1,384 @@
+/**
+ * @file include/compiler/parser/LLTable.h
+ * @author docs/generate_ll_table.js
+ * @brief This file is generated automatically from docs/ll_grammar.md and docs/ll_table.md. Do not edit manually!
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef LL_TABLE_H
+#define LL_TABLE_H
+
+enum LLSymbol {
+	LL_NONE = 0,
+
+	// Terminals
+	LL_T_EOF, // $
+	LL_T_LEFT_BRACE, // {
+	LL_T_RIGHT_BRACE, // }
+	LL_T_FUNC, // func
+	LL_T_IDENTIFIER, // identifier
+	LL_T_ARROW, // ->
+	LL_T_LEFT_PAREN, // (
+	LL_T_RIGHT_PAREN, // )
+	LL_T_COMMA, // ,
+	LL_T_COLON, // :
+	LL_T_EXPRESSION, // expression
+	LL_T_EQUAL, // =
+	LL_T_LET, // let
+	LL_T_VAR, // var
+	LL_T_IF, // if
+	LL_T_ELSE, // else
+	LL_T_WHILE, // while
+	LL_T_FOR, // for
+	LL_T_RANGE, // ...
+	LL_T_HALF_OPEN_RANGE, // ..<
+	LL_T_CONTINUE, // continue
+	LL_T_BREAK, // break
+	LL_T_RETURN, // return
+	LL_T_IN, // in
+
+	// Non-terminals
+	LL_N_PROGRAM,
+	LL_N_CODE_BLOCK,
+	LL_N_STATEMENTS,
+	LL_N_STATEMENT,
+	LL_N_EXPRESSION_STATEMENT,
+	LL_N_FUNCTION_DECLARATION,
+	LL_N_FUNCTION_NAME,
+	LL_N_FUNCTION_SIGNATURE,
+	LL_N_FUNCTION_RESULT,
+	LL_N_FUNCTION_BODY,
+	LL_N_PARAMETER_CLAUSE,
+	LL_N_PARAMETER_LIST,
+	LL_N_ADDITIONAL_PARAMETERS,
+	LL_N_PARAMETER,
+	LL_N_EXTERNAL_PARAMETER_NAME,
+	LL_N_LOCAL_PARAMETER_NAME,
+	LL_N_FUNCTION_CALL_EXPRESSION,
+	LL_N_ARGUMENT_CLAUSE,
+	LL_N_ARGUMENT_LIST,
+	LL_N_ADDITIONAL_ARGUMENTS,
+	LL_N_ARGUMENT,
+	LL_N_ARGUMENT_NAME,
+	LL_N_ASSIGNMENT_STATEMENT,
+	LL_N_VARIABLE_DECLARATION,
+	LL_N_VARIABLE_HEAD,
+	LL_N_VARIABLE_NAME,
+	LL_N_VARIABLE_DECLARATION_LIST,
+	LL_N_ADDITIONAL_DECLARATORS,
+	LL_N_VARIABLE_DECLARATOR,
+	LL_N_INITIALIZER,
+	LL_N_PATTERN,
+	LL_N_TYPE_ANNOTATION,
+	LL_N_TYPE,
+	LL_N_IF_STATEMENT,
+	LL_N_ELSE_CLAUSE,
+	LL_N_ELSE_BODY,
+	LL_N_CONDITION,
+	LL_N_OPTIONAL_BINDING_CONDITION,
+	LL_N_WHILE_STATEMENT,
+	LL_N_FOR_IN_STATEMENT,
+	LL_N_RANGE,
+	LL_N_RANGE_OPERATOR,
+	LL_N_CONTINUE_STATEMENT,
+	LL_N_BREAK_STATEMENT,
+	LL_N_RETURN_STATEMENT,
+
+	LL_SYMBOL_COUNT
+};
+
+#define LL_TERMINAL_FIRST LL_T_EOF
+#define LL_NON_TERMINAL_FIRST LL_N_PROGRAM
+#define LL_TERMINAL_COUNT (LL_NON_TERMINAL_FIRST - LL_TERMINAL_FIRST)
+#define LL_NON_TERMINAL_COUNT (LL_SYMBOL_COUNT - LL_NON_TERMINAL_FIRST)
+
+#define LL_RULE_COUNT 69
+#define LL_MAX_RULE_LENGTH 5
+
+#define is_ll_terminal(symbol) ((symbol) >= LL_TERMINAL_FIRST && (symbol) < LL_NON_TERMINAL_FIRST)
+#define is_ll_non_terminal(symbol) ((symbol) >= LL_NON_TERMINAL_FIRST && (symbol) < LL_SYMBOL_COUNT)
+
+/**
+ * Human readable names of the symbols (used in error messages).
+ */
+static const char *LL_SYMBOL_NAMES[LL_SYMBOL_COUNT] = {
+	"<none>",
+	"$",
+	"{",
+	"}",
+	"func",
+	"identifier",
+	"->",
+	"(",
+	")",
+	",",
+	":",
+	"expression",
+	"=",
+	"let",
+	"var",
+	"if",
+	"else",
+	"while",
+	"for",
+	"...",
+	"..<",
+	"continue",
+	"break",
+	"return",
+	"in",
+	"program",
+	"code-block",
+	"statements",
+	"statement",
+	"expression-statement",
+	"function-declaration",
+	"function-name",
+	"function-signature",
+	"function-result",
+	"function-body",
+	"parameter-clause",
+	"parameter-list",
+	"additional-parameters",
+	"parameter",
+	"external-parameter-name",
+	"local-parameter-name",
+	"function-call-expression",
+	"argument-clause",
+	"argument-list",
+	"additional-arguments",
+	"argument",
+	"argument-name",
+	"assignment-statement",
+	"variable-declaration",
+	"variable-head",
+	"variable-name",
+	"variable-declaration-list",
+	"additional-declarators",
+	"variable-declarator",
+	"initializer",
+	"pattern",
+	"type-annotation",
+	"type",
+	"if-statement",
+	"else-clause",
+	"else-body",
+	"condition",
+	"optional-binding-condition",
+	"while-statement",
+	"for-in-statement",
+	"range",
+	"range-operator",
+	"continue-statement",
+	"break-statement",
+	"return-statement",
+};
+
+/**
+ * Right sides of the rules, terminated by LL_NONE.
+ */
+static const unsigned char LL_RULES[LL_RULE_COUNT + 1][LL_MAX_RULE_LENGTH + 1] = {
+	/* 0 */ {LL_NONE},
+	/* 1 */ {LL_N_STATEMENTS},
+	/* 2 */ {LL_T_LEFT_BRACE, LL_N_STATEMENTS, LL_T_RIGHT_BRACE},
+	/* 3 */ {LL_N_STATEMENT, LL_N_STATEMENTS},
+	/* 4 */ {LL_NONE},
+	/* 5 */ {LL_N_FUNCTION_DECLARATION},
+	/* 6 */ {LL_N_VARIABLE_DECLARATION},
+	/* 7 */ {LL_N_IF_STATEMENT},
+	/* 8 */ {LL_N_WHILE_STATEMENT},
+	/* 9 */ {LL_N_FOR_IN_STATEMENT},
+	/* 10 */ {LL_N_CONTINUE_STATEMENT},
+	/* 11 */ {LL_N_BREAK_STATEMENT},
+	/* 12 */ {LL_N_RETURN_STATEMENT},
+	/* 13 */ {LL_N_EXPRESSION_STATEMENT},
+	/* 14 */ {LL_N_FUNCTION_CALL_EXPRESSION},
+	/* 15 */ {LL_T_FUNC, LL_N_FUNCTION_NAME, LL_N_FUNCTION_SIGNATURE, LL_N_FUNCTION_BODY},
+	/* 16 */ {LL_T_IDENTIFIER},
+	/* 17 */ {LL_N_PARAMETER_CLAUSE, LL_N_FUNCTION_RESULT},
+	/* 18 */ {LL_T_ARROW, LL_N_TYPE},
+	/* 19 */ {LL_NONE},
+	/* 20 */ {LL_N_CODE_BLOCK},
+	/* 21 */ {LL_NONE},
+	/* 22 */ {LL_T_LEFT_PAREN, LL_N_PARAMETER_LIST, LL_T_RIGHT_PAREN},
+	/* 23 */ {LL_N_PARAMETER, LL_N_ADDITIONAL_PARAMETERS},
+	/* 24 */ {LL_NONE},
+	/* 25 */ {LL_T_COMMA, LL_N_PARAMETER, LL_N_ADDITIONAL_PARAMETERS},
+	/* 26 */ {LL_NONE},
+	/* 27 */ {LL_N_EXTERNAL_PARAMETER_NAME, LL_N_LOCAL_PARAMETER_NAME, LL_N_TYPE_ANNOTATION},
+	/* 28 */ {LL_T_IDENTIFIER},
+	/* 29 */ {LL_T_IDENTIFIER},
+	/* 30 */ {LL_N_FUNCTION_NAME, LL_N_ARGUMENT_CLAUSE},
+	/* 31 */ {LL_T_LEFT_PAREN, LL_N_ARGUMENT_LIST, LL_T_RIGHT_PAREN},
+	/* 32 */ {LL_N_ARGUMENT, LL_N_ADDITIONAL_ARGUMENTS},
+	/* 33 */ {LL_NONE},
+	/* 34 */ {LL_T_COMMA, LL_N_ARGUMENT, LL_N_ADDITIONAL_ARGUMENTS},
+	/* 35 */ {LL_NONE},
+	/* 36 */ {LL_N_ARGUMENT_NAME, LL_T_COLON, LL_T_EXPRESSION},
+	/* 37 */ {LL_T_EXPRESSION},
+	/* 38 */ {LL_T_IDENTIFIER},
+	/* 39 */ {LL_N_VARIABLE_NAME, LL_T_EQUAL, LL_T_EXPRESSION},
+	/* 40 */ {LL_N_VARIABLE_HEAD, LL_N_VARIABLE_DECLARATION_LIST},
+	/* 41 */ {LL_T_LET},
+	/* 42 */ {LL_T_VAR},
+	/* 43 */ {LL_T_IDENTIFIER},
+	/* 44 */ {LL_N_VARIABLE_DECLARATOR, LL_N_ADDITIONAL_DECLARATORS},
+	/* 45 */ {LL_T_COMMA, LL_N_VARIABLE_DECLARATOR, LL_N_ADDITIONAL_DECLARATORS},
+	/* 46 */ {LL_NONE},
+	/* 47 */ {LL_N_PATTERN, LL_N_INITIALIZER},
+	/* 48 */ {LL_T_EQUAL, LL_T_EXPRESSION},
+	/* 49 */ {LL_NONE},
+	/* 50 */ {LL_N_VARIABLE_NAME, LL_N_TYPE_ANNOTATION},
+	/* 51 */ {LL_T_COLON, LL_N_TYPE},
+	/* 52 */ {LL_NONE},
+	/* 53 */ {LL_T_IDENTIFIER},
+	/* 54 */ {LL_T_IF, LL_N_CONDITION, LL_N_CODE_BLOCK, LL_N_ELSE_CLAUSE},
+	/* 55 */ {LL_T_ELSE, LL_N_ELSE_BODY},
+	/* 56 */ {LL_NONE},
+	/* 57 */ {LL_N_IF_STATEMENT},
+	/* 58 */ {LL_N_CODE_BLOCK},
+	/* 59 */ {LL_T_EXPRESSION},
+	/* 60 */ {LL_N_OPTIONAL_BINDING_CONDITION},
+	/* 61 */ {LL_N_VARIABLE_HEAD, LL_N_VARIABLE_DECLARATOR},
+	/* 62 */ {LL_T_WHILE, LL_N_CONDITION, LL_N_CODE_BLOCK},
+	/* 63 */ {LL_T_FOR, LL_N_VARIABLE_NAME, LL_T_IN, LL_N_RANGE, LL_N_CODE_BLOCK},
+	/* 64 */ {LL_T_EXPRESSION, LL_N_RANGE_OPERATOR, LL_T_EXPRESSION},
+	/* 65 */ {LL_T_RANGE},
+	/* 66 */ {LL_T_HALF_OPEN_RANGE},
+	/* 67 */ {LL_T_CONTINUE},
+	/* 68 */ {LL_T_BREAK},
+	/* 69 */ {LL_T_RETURN, LL_T_EXPRESSION},
+};
+
+/**
+ * Left sides of the rules.
+ */
+static const unsigned char LL_RULE_LHS[LL_RULE_COUNT + 1] = {
+	LL_NONE,
+	LL_N_PROGRAM, // 1
+	LL_N_CODE_BLOCK, // 2
+	LL_N_STATEMENTS, // 3
+	LL_N_STATEMENTS, // 4
+	LL_N_STATEMENT, // 5
+	LL_N_STATEMENT, // 6
+	LL_N_STATEMENT, // 7
+	LL_N_STATEMENT, // 8
+	LL_N_STATEMENT, // 9
+	LL_N_STATEMENT, // 10
+	LL_N_STATEMENT, // 11
+	LL_N_STATEMENT, // 12
+	LL_N_STATEMENT, // 13
+	LL_N_EXPRESSION_STATEMENT, // 14
+	LL_N_FUNCTION_DECLARATION, // 15
+	LL_N_FUNCTION_NAME, // 16
+	LL_N_FUNCTION_SIGNATURE, // 17
+	LL_N_FUNCTION_RESULT, // 18
+	LL_N_FUNCTION_RESULT, // 19
+	LL_N_FUNCTION_BODY, // 20
+	LL_N_FUNCTION_BODY, // 21
+	LL_N_PARAMETER_CLAUSE, // 22
+	LL_N_PARAMETER_LIST, // 23
+	LL_N_PARAMETER_LIST, // 24
+	LL_N_ADDITIONAL_PARAMETERS, // 25
+	LL_N_ADDITIONAL_PARAMETERS, // 26
+	LL_N_PARAMETER, // 27
+	LL_N_EXTERNAL_PARAMETER_NAME, // 28
+	LL_N_LOCAL_PARAMETER_NAME, // 29
+	LL_N_FUNCTION_CALL_EXPRESSION, // 30
+	LL_N_ARGUMENT_CLAUSE, // 31
+	LL_N_ARGUMENT_LIST, // 32
+	LL_N_ARGUMENT_LIST, // 33
+	LL_N_ADDITIONAL_ARGUMENTS, // 34
+	LL_N_ADDITIONAL_ARGUMENTS, // 35
+	LL_N_ARGUMENT, // 36
+	LL_N_ARGUMENT, // 37
+	LL_N_ARGUMENT_NAME, // 38
+	LL_N_ASSIGNMENT_STATEMENT, // 39
+	LL_N_VARIABLE_DECLARATION, // 40
+	LL_N_VARIABLE_HEAD, // 41
+	LL_N_VARIABLE_HEAD, // 42
+	LL_N_VARIABLE_NAME, // 43
+	LL_N_VARIABLE_DECLARATION_LIST, // 44
+	LL_N_ADDITIONAL_DECLARATORS, // 45
+	LL_N_ADDITIONAL_DECLARATORS, // 46
+	LL_N_VARIABLE_DECLARATOR, // 47
+	LL_N_INITIALIZER, // 48
+	LL_N_INITIALIZER, // 49
+	LL_N_PATTERN, // 50
+	LL_N_TYPE_ANNOTATION, // 51
+	LL_N_TYPE_ANNOTATION, // 52
+	LL_N_TYPE, // 53
+	LL_N_IF_STATEMENT, // 54
+	LL_N_ELSE_CLAUSE, // 55
+	LL_N_ELSE_CLAUSE, // 56
+	LL_N_ELSE_BODY, // 57
+	LL_N_ELSE_BODY, // 58
+	LL_N_CONDITION, // 59
+	LL_N_CONDITION, // 60
+	LL_N_OPTIONAL_BINDING_CONDITION, // 61
+	LL_N_WHILE_STATEMENT, // 62
+	LL_N_FOR_IN_STATEMENT, // 63
+	LL_N_RANGE, // 64
+	LL_N_RANGE_OPERATOR, // 65
+	LL_N_RANGE_OPERATOR, // 66
+	LL_N_CONTINUE_STATEMENT, // 67
+	LL_N_BREAK_STATEMENT, // 68
+	LL_N_RETURN_STATEMENT, // 69
+};
+
+/**
+ * Rule to expand for the non-terminal on the top of the stack and the terminal
+ * on the input, indexed as [nonTerminal - LL_NON_TERMINAL_FIRST][terminal - LL_TERMINAL_FIRST].
+ * Zero means a syntax error. Empty cells of nullable non-terminals are filled with their ε-rule.
+ */
+static const unsigned char LL_TABLE[LL_NON_TERMINAL_COUNT][LL_TERMINAL_COUNT] = {
+	/* program                    */ { 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0},
+	/* code-block                 */ { 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* statements                 */ { 4, 4, 4, 3, 3, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 4, 3, 3, 4, 4, 3, 3, 3, 4},
+	/* statement                  */ { 0, 0, 0, 5,13, 0, 0, 0, 0, 0, 0, 0, 6, 6, 7, 0, 8, 9, 0, 0,10,11,12, 0},
+	/* expression-statement       */ { 0, 0, 0, 0,14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* function-declaration       */ { 0, 0, 0,15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* function-name              */ { 0, 0, 0, 0,16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* function-signature         */ { 0, 0, 0, 0, 0, 0,17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* function-result            */ {19,19,19,19,19,18,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19},
+	/* function-body              */ {21,20,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21},
+	/* parameter-clause           */ { 0, 0, 0, 0, 0, 0,22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* parameter-list             */ {24,24,24,24,23,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24},
+	/* additional-parameters      */ {26,26,26,26,26,26,26,26,25,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26},
+	/* parameter                  */ { 0, 0, 0, 0,27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* external-parameter-name    */ { 0, 0, 0, 0,28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* local-parameter-name       */ { 0, 0, 0, 0,29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* function-call-expression   */ { 0, 0, 0, 0,30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* argument-clause            */ { 0, 0, 0, 0, 0, 0,31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* argument-list              */ {33,33,33,33,32,33,33,33,33,33,33,33,33,33,33,33,33,33,33,33,33,33,33,33},
+	/* additional-arguments       */ {35,35,35,35,35,35,35,35,34,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35},
+	/* argument                   */ { 0, 0, 0, 0,36, 0, 0, 0, 0, 0,37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* argument-name              */ { 0, 0, 0, 0,38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* assignment-statement       */ { 0, 0, 0, 0,39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* variable-declaration       */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,40,40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* variable-head              */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,41,42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* variable-name              */ { 0, 0, 0, 0,43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* variable-declaration-list  */ { 0, 0, 0, 0,44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* additional-declarators     */ {46,46,46,46,46,46,46,46,45,46,46,46,46,46,46,46,46,46,46,46,46,46,46,46},
+	/* variable-declarator        */ { 0, 0, 0, 0,47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* initializer                */ {49,49,49,49,49,49,49,49,49,49,49,48,49,49,49,49,49,49,49,49,49,49,49,49},
+	/* pattern                    */ { 0, 0, 0, 0,50, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* type-annotation            */ {52,52,52,52,52,52,52,52,52,51,52,52,52,52,52,52,52,52,52,52,52,52,52,52},
+	/* type                       */ { 0, 0, 0, 0,53, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* if-statement               */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,54, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* else-clause                */ {56,56,56,56,56,56,56,56,56,56,56,56,56,56,56,55,56,56,56,56,56,56,56,56},
+	/* else-body                  */ { 0,58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,57, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* condition                  */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,59, 0,60,60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* optional-binding-condition */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,61,61, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* while-statement            */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,62, 0, 0, 0, 0, 0, 0, 0},
+	/* for-in-statement           */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,63, 0, 0, 0, 0, 0, 0},
+	/* range                      */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+	/* range-operator             */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,65,66, 0, 0, 0, 0},
+	/* continue-statement         */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,67, 0, 0, 0},
+	/* break-statement            */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,68, 0, 0},
+	/* return-statement           */ { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,69, 0},
+};
+
+#endif
+
+/** End of file include/compiler/parser/LLTable.h **/
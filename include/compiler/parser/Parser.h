@@ -18,17 +18,40 @@
 typedef struct Parser {
 	Lexer *lexer;
 	LexerResult lastLexerError;
+	Array /*<ParserResult>*/ *diagnostics;
+	Array /*<enum LLSymbol>*/ *symbols; // Symbol stack of the LL driver
+	Array /*<ASTNode>*/ *values; // Value stack of the LL driver
+	Array /*<ParserBlockFrame>*/ *frames; // Blocks being parsed
+	Array /*<ParserBlockFrame>*/ *framePool; // Frames of the closed blocks, ready to be reused
 } Parser;
 
+/**
+ * Block of statements being parsed by the LL driver.
+ */
+typedef struct ParserBlockFrame {
+	Array /*<StatementASTNode>*/ *statements;
+	size_t symbolBase; // Size of the symbol stack below the block body
+	size_t valueBase; // Size of the value stack below the block body
+	int statementStart; // Index of the last token before the current statement
+	bool requireBraces;
+} ParserBlockFrame;
+
 void Parser_constructor(Parser *parser, Lexer *lexer);
 void Parser_destructor(Parser *parser);
 void Parser_setLexer(Parser *parser, Lexer *lexer);
+
+/**
+ * Parses the whole program. Syntax errors are recovered from at statement
+ * boundaries, all of them are collected in `parser->diagnostics`.
+ * @param parser
+ * @return Program node, or the first error encountered
+ */
 ParserResult Parser_parse(Parser *parser);
 
 bool Parser_hasLexerError(Parser *parser);
 LexerResult Parser_flushLastLexerError(Parser *parser);
 
-#define FLUSH_ERROR_BUFFER(parser) if(Parser_hasLexerError(parser)) return LexerToParserError(Parser_flushLastLexerError(parser))
+#define FLUSH_ERROR_BUFFER(parser) if(Parser_hasLexerError(parser)) { LexerResult lexerError = Parser_flushLastLexerError(parser); return LexerToParserError(lexerError); }
 
 #endif
 
@@ -40,8 +40,18 @@ ParserResult ParserResult_construct(
 	ASTNode *node
 );
 
-#define ParserSuccess(node) ParserResult_construct(RESULT_SUCCESS, SEVERITY_NONE, NULL, NULL, (ASTNode*)node)
-#define ParserNoMatch() ParserResult_construct(RESULT_NO_MATCH, SEVERITY_NONE, NULL, NULL, NULL)
+ParserResult* ParserResult_alloc(
+	enum ResultType type,
+	enum Severity severity,
+	String *message,
+	Array *markers,
+	ASTNode *node
+);
+void ParserResult_free(ParserResult *result);
+
+// Non-error results are built in place (members not listed are zeroed), only errors go through the constructor
+#define ParserSuccess(_node) ((ParserResult){.success = true, .type = RESULT_SUCCESS, .severity = SEVERITY_NONE, .node = (ASTNode*)(_node)})
+#define ParserNoMatch() ((ParserResult){.success = true, .type = RESULT_NO_MATCH, .severity = SEVERITY_NONE})
 #define ParserError(message, markers) ParserResult_construct(RESULT_ERROR_SYNTACTIC_ANALYSIS, SEVERITY_ERROR, message, markers, NULL)
 #define LexerToParserError(lexerResult) ParserResult_construct(lexerResult.type, lexerResult.severity, lexerResult.message, lexerResult.markers, NULL)
 
@@ -0,0 +1,100 @@
+/**
+ * @file include/internal/BitSet.h
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief This file is part of the IFJ23 project.
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#define BITSET_WORD_BITS 64
+
+typedef struct BitSet {
+	uint64_t *words;
+	size_t capacity; // Number of allocated words
+} BitSet;
+
+/**
+ * Constructs an empty BitSet instance.
+ * @param set
+ */
+void BitSet_constructor(BitSet *set);
+
+/**
+ * Deallocates the memory used by the given BitSet instance.
+ * @param set
+ */
+void BitSet_destructor(BitSet *set);
+
+/**
+ * Sets or clears the bit at the given index. The set grows to fit the index.
+ * @param set
+ * @param index
+ * @param value
+ */
+void BitSet_set(BitSet *set, size_t index, bool value);
+
+/**
+ * Returns the bit at the given index, bits past the end of the set are cleared.
+ * @param set
+ * @param index
+ * @return bool
+ */
+bool BitSet_has(BitSet *set, size_t index);
+
+/**
+ * Returns the index of the first set bit at or after the given index.
+ * @param set
+ * @param index
+ * @return size_t The index of the bit, SIZE_MAX if there is none
+ */
+size_t BitSet_next(BitSet *set, size_t index);
+
+/**
+ * Clears all the bits in the set.
+ * @param set
+ */
+void BitSet_clear(BitSet *set);
+
+/**
+ * Sets all the bits of the other set in the set.
+ * @param set
+ * @param other
+ * @return bool Whether any bit of the set has changed
+ */
+bool BitSet_union(BitSet *set, BitSet *other);
+
+/**
+ * Clears all the bits of the other set in the set.
+ * @param set
+ * @param other
+ */
+void BitSet_subtract(BitSet *set, BitSet *other);
+
+/**
+ * Replaces the bits of the set with the bits of the other set.
+ * @param set
+ * @param other
+ */
+void BitSet_copy(BitSet *set, BitSet *other);
+
+/**
+ * Allocates and constructs an empty BitSet instance.
+ * @return BitSet*
+ */
+BitSet* BitSet_alloc();
+
+/**
+ * Destructs and deallocates the given BitSet instance.
+ * @param set
+ */
+void BitSet_free(BitSet *set);
+
+#endif
+
+/** End of file include/internal/BitSet.h **/
@@ -0,0 +1,56 @@
+/**
+ * @file include/internal/CallStack.h
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Segmented call stack for the recursive AST walkers.
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdbool.h>
+
+#ifndef CALL_STACK_H
+#define CALL_STACK_H
+
+/**
+ * Size of a single segment allocated on the heap (can be overridden at compile time).
+ */
+#ifndef CALL_STACK_SEGMENT_SIZE
+#define CALL_STACK_SEGMENT_SIZE (8 * 1024 * 1024)
+#endif
+
+/**
+ * Space kept free at the end of each segment, a new segment is started once it is reached.
+ * It has to be larger than the deepest non-guarded call chain between two guarded calls.
+ */
+#ifndef CALL_STACK_RED_ZONE
+#define CALL_STACK_RED_ZONE (256 * 1024)
+#endif
+
+/**
+ * Space of the native stack assumed to be available below the first check
+ * when the soft limit of RLIMIT_STACK is unlimited or cannot be queried.
+ */
+#ifndef CALL_STACK_NATIVE_SIZE
+#define CALL_STACK_NATIVE_SIZE (1024 * 1024)
+#endif
+
+typedef struct CallStackCall {
+	void (*function)(void *context);
+	void *context;
+} CallStackCall;
+
+/**
+ * Checks whether the current stack segment has reached its red zone.
+ * @return true if the next recursive call should be made using CallStack_extend, false otherwise
+ */
+bool CallStack_isExhausted();
+
+/**
+ * Calls the function on a new stack segment. The segment is freed once the function returns.
+ * @param function Function to call
+ * @param context Argument passed to the function
+ */
+void CallStack_extend(void (*function)(void *context), void *context);
+
+#endif
+
+/** End of file include/internal/CallStack.h **/
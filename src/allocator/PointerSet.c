@@ -13,7 +13,8 @@
 #include <stdint.h>
 
 int PointerSet_hash(void *ptr) {
-	return (uint64_t)ptr % ALLOCATOR_SET_SIZE;
+	// Allocated blocks are aligned to 16 bytes, the lowest bits would leave most of the buckets empty
+	return ((uint64_t)ptr >> 4) % ALLOCATOR_SET_SIZE;
 }
 
 void PointerSet_add(PointerSet *pointerSet, void *ptr) {
@@ -9,6 +9,8 @@
 
 #include "allocator/MemoryAllocator.h"
 #include "internal/Array.h"
+#include "internal/BitSet.h"
+#include "internal/CallStack.h"
 #include "internal/HashMap.h"
 #include "internal/Utils.h"
 #include "compiler/analyser/AnalyserResult.h"
@@ -18,14 +20,38 @@
 
 /* Private methods */
 String* __Analyser_stringifyType(ValueType type);
-BlockScope* __Analyser_createBlockScopeChaining(Analyser *analyser, BlockASTNode *block, BlockScope *parent);
+BlockScope* __Analyser_createBlockScopeChaining(BlockASTNode *block, BlockScope *parent);
 AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block);
+AnalyserResult __Analyser_analyseFunctionDeclaration(Analyser *analyser, FunctionDeclarationASTNode *function, BlockScope *scope);
 AnalyserResult __Analyser_resolveExpressionType(Analyser *analyser, ExpressionASTNode *node, BlockScope *scope, ValueType prefferedType, ValueType *outType);
 AnalyserResult __Analyser_collectFunctionDeclarations(Analyser *analyser);
-void __Analyser_createBlockScopeChaining_processNode(Analyser *analyser, ASTNode *node, BlockScope *parent);
+AnalyserResult __Analyser_collectFunctionSignature(Analyser *analyser, FunctionDeclaration *declaration);
+AnalyserResult __Analyser_registerOverload(Analyser *analyser, FunctionDeclaration *declaration);
 void __Analyser_registerBuiltInFunctions(Analyser *analyser);
 bool __Analyser_isReturnReachable_processNode(Analyser *analyser, StatementASTNode *node);
 bool __Analyser_isReturnReachable(Analyser *analyser, BlockASTNode *block);
+void __Analyser_analyseBlock_extended(void *context);
+void __Analyser_resolveExpressionType_extended(void *context);
+void __Analyser_isReturnReachable_extended(void *context);
+void __Analyser_createBlockScopeChaining_processNode(ASTNode *node, BlockScope *parent, Array *blocks);
+void __Analyser_registerVariable(Analyser *analyser, FunctionDeclaration *function, VariableDeclaration *declaration);
+void __Analyser_bindVariable(Analyser *analyser, BlockScope *scope, VariableDeclaration *declaration);
+void __Analyser_enterScope(Analyser *analyser, BlockScope *scope);
+void __Analyser_leaveScope(Analyser *analyser, BlockScope *scope);
+AnalyserResult __Analyser_resolveFunctionCallType(Analyser *analyser, FunctionCallASTNode *call, BlockScope *scope, ValueType prefferedType, ValueType *outType);
+AnalyserResult __Analyser_retypeCallArguments(Analyser *analyser, FunctionCallASTNode *call, FunctionDeclaration *declaration, BlockScope *scope);
+ResolvedCall* __Analyser_getResolvedCall(Analyser *analyser, FunctionCallASTNode *call, ValueType prefferedType);
+void __Analyser_memoizeCall(Analyser *analyser, FunctionCallASTNode *call, ValueType prefferedType, AnalyserResult result, ValueType type);
+String* __Analyser_getFunctionSelector(FunctionDeclarationASTNode *node);
+String* __Analyser_getCallSelector(FunctionCallASTNode *node);
+void __Analyser_addDependency(Analyser *analyser, size_t id);
+bool __Analyser_isDependency(FunctionDeclaration *function, Declaration *declaration);
+bool __Analyser_isTypeReferenceEqual(TypeReferenceASTNode *type, TypeReferenceASTNode *other);
+bool __Analyser_isSignatureEqual(FunctionDeclarationASTNode *node, FunctionDeclarationASTNode *other);
+void __Analyser_discardFunctionAnalysis(Analyser *analyser, FunctionDeclaration *declaration);
+void __Analyser_unregisterOverload(Analyser *analyser, FunctionDeclaration *declaration);
+AnalyserResult __Analyser_prepareFunctionDeclaration(Analyser *analyser, FunctionDeclaration *declaration);
+AnalyserResult __Analyser_reanalyseFunctionDeclaration(Analyser *analyser, FunctionDeclaration *declaration);
 
 
 ValueType Analyser_getTypeFromToken(enum TokenKind tokenKind) {
@@ -40,6 +66,9 @@ ValueType Analyser_getTypeFromToken(enum TokenKind tokenKind) {
 }
 
 size_t Analyser_nextId(Analyser *analyser) {
+	// Reserve a slot in the declarations table, so it can be indexed by id directly
+	Array_push(analyser->declarations, NULL);
+
 	return analyser->idCounter++;
 }
 
@@ -67,6 +96,7 @@ VariableDeclaration* new_VariableDeclaration(
 	declaration->id = analyser ? Analyser_nextId(analyser) : 0;
 	declaration->isConstant = isConstant;
 	declaration->isUsed = false;
+	declaration->scope = NULL;
 
 	if(node) {
 		declaration->node = node;
@@ -85,8 +115,8 @@ VariableDeclaration* new_VariableDeclaration(
 		declaration->isInitialized = isInitialized;
 	}
 
-	// Add declaration to the ids pool
-	HashMap_set(analyser->idsPool, String_fromLong(declaration->id)->value, declaration);
+	// Add declaration to the declarations table
+	Array_set(analyser->declarations, declaration->id, declaration);
 
 	return declaration;
 }
@@ -97,11 +127,16 @@ FunctionDeclaration* new_FunctionDeclaration(Analyser *analyser, FunctionDeclara
 	declaration->_type = DECLARATION_FUNCTION;
 	declaration->id = analyser ? Analyser_nextId(analyser) : 0;
 	declaration->node = node;
-	declaration->variables = HashMap_alloc();
+	declaration->variables = Array_alloc(0);
+	declaration->dependencies = NULL;
+	declaration->bindingsOffset = 0;
 	declaration->isUsed = false;
+	declaration->isAnalysed = false;
+	declaration->isTailRecursive = false;
+	declaration->isLeaf = false;
 
-	// Add declaration to the ids pool
-	HashMap_set(analyser->idsPool, String_fromLong(declaration->id)->value, declaration);
+	// Add declaration to the declarations table
+	Array_set(analyser->declarations, declaration->id, declaration);
 
 	return declaration;
 }
@@ -112,7 +147,8 @@ void VariableDeclaration_free(VariableDeclaration *declaration) {
 }
 
 void FunctionDeclaration_free(FunctionDeclaration *declaration) {
-	HashMap_free(declaration->variables);
+	Array_free(declaration->variables);
+	if(declaration->dependencies) Array_free(declaration->dependencies);
 	mem_free(declaration);
 }
 
@@ -120,24 +156,41 @@ void FunctionDeclaration_free(FunctionDeclaration *declaration) {
 BlockScope* BlockScope_alloc(BlockScope *parent) {
 	BlockScope *scope = (BlockScope*)mem_alloc(sizeof(BlockScope));
 	scope->parent = parent;
-	scope->variables = HashMap_alloc();
+	scope->declarations = NULL;
+	scope->bindingsOffset = 0;
 	scope->function = NULL;
 	scope->loop = NULL;
 	return scope;
 }
 
 void BlockScope_free(BlockScope *scope) {
-	HashMap_free(scope->variables);
+	if(scope->declarations) Array_free(scope->declarations);
 	mem_free(scope);
 }
 
+void BlockScope_addDeclaration(BlockScope *scope, VariableDeclaration *declaration) {
+	if(!scope->declarations) scope->declarations = Array_alloc(1);
+	Array_push(scope->declarations, declaration);
+}
+
 void Analyser_constructor(Analyser *analyser) {
 	analyser->globalScope = BlockScope_alloc(NULL);
 	analyser->overloads = HashMap_alloc();
-	analyser->functions = HashMap_alloc();
-	analyser->variables = HashMap_alloc();
-	analyser->idsPool = HashMap_alloc();
+	analyser->selectors = HashMap_alloc();
+	analyser->symbols = HashMap_alloc();
+	analyser->bindings = Array_alloc(0);
+	analyser->functions = Array_alloc(0);
+	analyser->variables = Array_alloc(0);
+	analyser->declarations = Array_alloc(0);
+	analyser->globals = BitSet_alloc();
+	analyser->dependencies = BitSet_alloc();
+	analyser->function = NULL;
 	analyser->idCounter = 1;
+	analyser->epoch = 0;
+	analyser->isAnalysed = false;
+
+	// Id 0 is never assigned to any declaration
+	Array_push(analyser->declarations, NULL);
 	analyser->ast = NULL;
 
 	// TODO: probably delete this
@@ -151,9 +204,14 @@ void Analyser_constructor(Analyser *analyser) {
 
 void Analyser_destructor(Analyser *analyser) {
 	if(analyser->globalScope) BlockScope_free(analyser->globalScope);
-	if(analyser->functions) HashMap_free(analyser->functions);
-	if(analyser->variables) HashMap_free(analyser->variables);
-	if(analyser->idsPool) HashMap_free(analyser->idsPool);
+	if(analyser->selectors) HashMap_free(analyser->selectors);
+	if(analyser->symbols) HashMap_free(analyser->symbols);
+	if(analyser->bindings) Array_free(analyser->bindings);
+	if(analyser->functions) Array_free(analyser->functions);
+	if(analyser->variables) Array_free(analyser->variables);
+	if(analyser->declarations) Array_free(analyser->declarations);
+	if(analyser->globals) BitSet_free(analyser->globals);
+	if(analyser->dependencies) BitSet_free(analyser->dependencies);
 	if(analyser->types) HashMap_free(analyser->types);
 	analyser->idCounter = 0;
 }
@@ -161,20 +219,14 @@ void Analyser_destructor(Analyser *analyser) {
 bool Analyser_isDeclarationGlobal(Analyser *analyser, size_t id) {
 	if(id == 0) return false;
 
-	String *key = String_fromLong(id);
-	bool isGlobal = HashMap_has(analyser->variables, key->value) || HashMap_has(analyser->functions, key->value);
-	String_free(key);
-
-	return isGlobal;
+	return BitSet_has(analyser->globals, id);
 }
 
 Declaration* Analyser_getDeclarationById(Analyser *analyser, size_t id) {
 	if(id == 0) return NULL;
+	if(id >= analyser->declarations->size) return NULL;
 
-	String *key = String_fromLong(id);
-	Declaration *declaration = HashMap_get(analyser->idsPool, key->value);
-	String_free(key);
-	return declaration;
+	return analyser->declarations->data[id];
 }
 
 FunctionDeclaration* Analyser_getFunctionById(Analyser *analyser, size_t id) {
@@ -198,18 +250,13 @@ VariableDeclaration* Analyser_getVariableById(Analyser *analyser, size_t id) {
 }
 
 VariableDeclaration* Analyser_getVariableByName(Analyser *analyser, char *name, BlockScope *scope) {
-	VariableDeclaration *declaration = NULL;
-
-	(void)analyser;
+	(void)scope;
 
-	while(scope) {
-		declaration = HashMap_get(scope->variables, name);
-		if(declaration) return declaration;
-
-		scope = scope->parent;
-	}
+	// Bindings of the scopes that are not entered are not in the table
+	Array /*<VariableDeclaration>*/ *bindings = HashMap_get(analyser->symbols, name);
+	if(!bindings || bindings->size == 0) return NULL;
 
-	return NULL;
+	return Array_get(bindings, bindings->size - 1);
 }
 
 enum BuiltInFunction Analyser_getBuiltInFunctionById(Analyser *analyser, size_t id) {
@@ -241,6 +288,45 @@ FunctionDeclaration* Analyser_getNearestFunctionDeclaration(Analyser *analyser,
 	return NULL;
 }
 
+void __Analyser_registerVariable(Analyser *analyser, FunctionDeclaration *function, VariableDeclaration *declaration) {
+	if(function) {
+		Array_push(function->variables, declaration);
+	} else {
+		Array_push(analyser->variables, declaration);
+		BitSet_set(analyser->globals, declaration->id, true);
+	}
+}
+
+void __Analyser_bindVariable(Analyser *analyser, BlockScope *scope, VariableDeclaration *declaration) {
+	Array /*<VariableDeclaration>*/ *bindings = HashMap_get(analyser->symbols, declaration->name->value);
+
+	if(!bindings) {
+		bindings = Array_alloc(1);
+		HashMap_set(analyser->symbols, declaration->name->value, bindings);
+	}
+
+	// Shadows the bindings of the outer scopes
+	Array_push(bindings, declaration);
+	Array_push(analyser->bindings, bindings);
+	declaration->scope = scope;
+}
+
+void __Analyser_enterScope(Analyser *analyser, BlockScope *scope) {
+	scope->bindingsOffset = analyser->bindings->size;
+
+	if(!scope->declarations) return;
+
+	for(size_t i = 0; i < scope->declarations->size; i++) {
+		__Analyser_bindVariable(analyser, scope, Array_get(scope->declarations, i));
+	}
+}
+
+void __Analyser_leaveScope(Analyser *analyser, BlockScope *scope) {
+	while(analyser->bindings->size > scope->bindingsOffset) {
+		Array_pop(Array_pop(analyser->bindings));
+	}
+}
+
 StatementASTNode /*<ForStatementASTNode | WhileStatementASTNode>*/* Analyser_getNearestLoop(Analyser *analyser, BlockScope *scope) {
 	(void)analyser;
 
@@ -259,22 +345,17 @@ bool __Analyser_isReturnReachable_processNode(Analyser *analyser, StatementASTNo
 		case NODE_IF_STATEMENT: {
 			IfStatementASTNode *ifStatement = (IfStatementASTNode*)node;
 
-			bool isReachable = true;
+			// Every branch must have a return statement (else-if chains are walked iteratively)
+			while(true) {
+				if(!__Analyser_isReturnReachable(analyser, ifStatement->body)) return false;
+				if(!ifStatement->alternate) return false;
 
-			// Every branch must have a return statement
-			isReachable &= __Analyser_isReturnReachable(analyser, ifStatement->body);
-
-			if(ifStatement->alternate) {
 				if(ifStatement->alternate->_type == NODE_BLOCK) {
-					isReachable &= __Analyser_isReturnReachable(analyser, (BlockASTNode*)ifStatement->alternate);
-				} else {
-					isReachable &= __Analyser_isReturnReachable_processNode(analyser, ifStatement->alternate);
+					return __Analyser_isReturnReachable(analyser, (BlockASTNode*)ifStatement->alternate);
 				}
-			} else {
-				isReachable = false;
-			}
 
-			return isReachable;
+				ifStatement = (IfStatementASTNode*)ifStatement->alternate;
+			}
 		} break;
 
 		default: return false;
@@ -282,6 +363,13 @@ bool __Analyser_isReturnReachable_processNode(Analyser *analyser, StatementASTNo
 }
 
 bool __Analyser_isReturnReachable(Analyser *analyser, BlockASTNode *block) {
+	// Continue on a new stack segment, deeply nested blocks would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		AnalyserCall call = {.analyser = analyser, .node = (ASTNode*)block};
+		CallStack_extend(__Analyser_isReturnReachable_extended, &call);
+		return call.isReachable;
+	}
+
 	for(size_t i = 0; i < block->statements->size; i++) {
 		StatementASTNode *statement = Array_get(block->statements, i);
 
@@ -293,14 +381,50 @@ bool __Analyser_isReturnReachable(Analyser *analyser, BlockASTNode *block) {
 	return false;
 }
 
+String* __Analyser_getFunctionSelector(FunctionDeclarationASTNode *node) {
+	String *selector = String_alloc(node->id->name->value);
+	String_appendChar(selector, '(');
+
+	Array /*<ParameterASTNode>*/ *parameters = node->parameterList->parameters;
+	for(size_t i = 0; i < parameters->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+
+		String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
+		assertf(externalName, "Parameter has no external or internal name");
+
+		String_append(selector, parameter->isLabeless ? "_" : externalName->value);
+		String_appendChar(selector, ':');
+	}
+
+	String_appendChar(selector, ')');
+
+	return selector;
+}
+
+String* __Analyser_getCallSelector(FunctionCallASTNode *node) {
+	String *selector = String_alloc(node->id->name->value);
+	String_appendChar(selector, '(');
+
+	Array /*<ArgumentASTNode>*/ *arguments = node->argumentList->arguments;
+	for(size_t i = 0; i < arguments->size; i++) {
+		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		String_append(selector, argument->label ? argument->label->name->value : "_");
+		String_appendChar(selector, ':');
+	}
+
+	String_appendChar(selector, ')');
+
+	return selector;
+}
+
 AnalyserResult __Analyser_resolveFunctionOverloadCandidates(
 	Analyser *analyser,
 	FunctionCallASTNode *node,
 	BlockScope *scope,
 	Array /*<FunctionDeclaration>*/ **outCandidates
 ) {
-	Array *overloads = HashMap_get(analyser->overloads, node->id->name->value);
-	if(!overloads) {
+	if(!HashMap_has(analyser->overloads, node->id->name->value)) {
 		return AnalyserError(
 			RESULT_ERROR_SEMANTIC_UNDEFINED_FUNCTION,
 			String_fromFormat("cannot find function '%s' in scope", node->id->name->value),
@@ -310,6 +434,16 @@ AnalyserResult __Analyser_resolveFunctionOverloadCandidates(
 
 	Array *candidates = Array_alloc(0);
 
+	// Only overloads with matching argument count and labels have to be typed
+	String *selector = __Analyser_getCallSelector(node);
+	Array *overloads = HashMap_get(analyser->selectors, selector->value);
+	String_free(selector);
+
+	if(!overloads) {
+		*outCandidates = candidates;
+		return AnalyserSuccess();
+	}
+
 	AnalyserResult lastError = AnalyserSuccess();
 
 	// Loop over possible candidates
@@ -319,9 +453,6 @@ AnalyserResult __Analyser_resolveFunctionOverloadCandidates(
 		Array *parameters = overload->node->parameterList->parameters;
 		Array *arguments = node->argumentList->arguments;
 
-		// Non-matching parameter count
-		if(parameters->size != arguments->size) continue;
-
 		// Loop over parameters
 		bool hasMatched = true;
 		for(size_t j = 0; j < parameters->size; j++) {
@@ -331,22 +462,6 @@ AnalyserResult __Analyser_resolveFunctionOverloadCandidates(
 			ValueType parameterType = parameter->type->type;
 			ValueType argumentType;
 
-			// Check for label
-			String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
-			assertf(externalName, "Parameter has no external or internal name");
-			if(parameter->isLabeless && argument->label) {
-				hasMatched = false;
-				break;
-			}
-			if(!parameter->isLabeless && !argument->label) {
-				hasMatched = false;
-				break;
-			}
-			if(!parameter->isLabeless && !String_equals(externalName, argument->label->name->value)) {
-				hasMatched = false;
-				break;
-			}
-
 			AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, parameterType, &argumentType);
 			if(!result.success) {
 				// Array_free(candidates);
@@ -396,22 +511,149 @@ ValueType Analyser_TypeReferenceToValueType(TypeReferenceASTNode *node) {
 }
 
 AnalyserResult Analyser_analyse(Analyser *analyser, ProgramASTNode *ast) {
-	// Reconstruct the analyser
+	// Reconstruct the analyser, the epoch is kept so resolutions memoized in the AST by previous runs are discarded
+	size_t epoch = analyser->epoch;
 	Analyser_destructor(analyser);
 	Analyser_constructor(analyser);
+	analyser->epoch = epoch + 1;
 
 	analyser->ast = ast;
 
 	// Register built-in functions
 	__Analyser_registerBuiltInFunctions(analyser);
 
-	__Analyser_createBlockScopeChaining(analyser, ast->block, NULL);
+	__Analyser_createBlockScopeChaining(ast->block, NULL);
 	analyser->globalScope = ast->block->scope;
 
 	AnalyserResult result = __Analyser_collectFunctionDeclarations(analyser);
 	if(!result.success) return result;
 
-	return __Analyser_analyseBlock(analyser, ast->block);
+	result = __Analyser_analyseBlock(analyser, ast->block);
+	analyser->isAnalysed = result.success;
+
+	return result;
+}
+
+bool Analyser_reanalyse(Analyser *analyser, Array /*<FunctionDeclarationASTNode>*/ *functions, AnalyserResult *outResult) {
+	assertf(analyser != NULL);
+	assertf(functions != NULL);
+
+	// Declarations of a failed analysis are incomplete
+	if(!analyser->isAnalysed) return false;
+
+	Array /*<FunctionDeclaration>*/ *changed = Array_alloc(functions->size);
+	Array /*<StatementASTNode>*/ *statements = analyser->ast->block->statements;
+	size_t index = 0;
+
+	// Function declarations are in the same order as in the AST, replaced nodes are found by comparing them
+	for(size_t i = 0; i < statements->size; i++) {
+		StatementASTNode *statement = Array_get(statements, i);
+		if(statement->_type != NODE_FUNCTION_DECLARATION) continue;
+
+		FunctionDeclaration *declaration = index < analyser->functions->size ? Array_get(analyser->functions, index++) : NULL;
+		FunctionDeclarationASTNode *node = (FunctionDeclarationASTNode*)statement;
+
+		if(declaration && declaration->node == node) continue;
+
+		// Added function or a node that is not listed in the changes
+		bool isListed = false;
+		for(size_t j = 0; j < functions->size && !isListed; j++) isListed = Array_get(functions, j) == node;
+
+		if(!declaration || !isListed || !String_equals(declaration->node->id->name, node->id->name->value)) {
+			Array_free(changed);
+			return false;
+		}
+
+		Array_push(changed, declaration);
+	}
+
+	// Removed function or a node that did not replace any declaration
+	if(index != analyser->functions->size || changed->size != functions->size) {
+		Array_free(changed);
+		return false;
+	}
+
+	// Overloads with a changed signature are registered again
+	BitSet signatures;
+	BitSet_constructor(&signatures);
+
+	for(size_t i = 0; i < changed->size; i++) {
+		FunctionDeclaration *declaration = Array_get(changed, i);
+		if(__Analyser_isSignatureEqual(declaration->node, Array_get(functions, i))) continue;
+
+		BitSet_set(&signatures, declaration->id, true);
+
+		// The global code is only analysed as a whole
+		Array *overloads = Analyser_getFunctionDeclarationsByName(analyser, declaration->node->id->name->value);
+
+		for(size_t j = 0; j < overloads->size; j++) {
+			FunctionDeclaration *overload = Array_get(overloads, j);
+			if(!BitSet_has(analyser->dependencies, overload->id)) continue;
+
+			BitSet_destructor(&signatures);
+			Array_free(changed);
+			return false;
+		}
+	}
+
+	// Calls resolved to any overload of the same name might be resolved differently now
+	for(size_t i = 0; i < changed->size; i++) {
+		FunctionDeclaration *declaration = Array_get(changed, i);
+		if(!BitSet_has(&signatures, declaration->id)) continue;
+
+		Array *overloads = Analyser_getFunctionDeclarationsByName(analyser, declaration->node->id->name->value);
+
+		for(size_t j = 0; j < analyser->functions->size; j++) {
+			FunctionDeclaration *function = Array_get(analyser->functions, j);
+
+			for(size_t k = 0; k < overloads->size && function->isAnalysed; k++) {
+				FunctionDeclaration *overload = Array_get(overloads, k);
+				if(__Analyser_isDependency(function, (Declaration*)overload)) function->isAnalysed = false;
+			}
+		}
+	}
+
+	*outResult = AnalyserSuccess();
+
+	// Replace the changed declarations first, so the other functions are resolved against the new signatures
+	BitSet prepared;
+	BitSet_constructor(&prepared);
+
+	for(size_t i = 0; i < changed->size && outResult->success; i++) {
+		FunctionDeclaration *declaration = Array_get(changed, i);
+		bool isSignatureChanged = BitSet_has(&signatures, declaration->id);
+
+		__Analyser_discardFunctionAnalysis(analyser, declaration);
+		if(isSignatureChanged) __Analyser_unregisterOverload(analyser, declaration);
+
+		declaration->node = Array_get(functions, i);
+		BitSet_set(&prepared, declaration->id, true);
+
+		*outResult = __Analyser_prepareFunctionDeclaration(analyser, declaration);
+		if(outResult->success && isSignatureChanged) *outResult = __Analyser_registerOverload(analyser, declaration);
+	}
+
+	// Dependent functions and the ones whose previous analysis failed
+	for(size_t i = 0; i < analyser->functions->size && outResult->success; i++) {
+		FunctionDeclaration *declaration = Array_get(analyser->functions, i);
+		if(declaration->isAnalysed || BitSet_has(&prepared, declaration->id)) continue;
+
+		__Analyser_discardFunctionAnalysis(analyser, declaration);
+		*outResult = __Analyser_prepareFunctionDeclaration(analyser, declaration);
+	}
+
+	for(size_t i = 0; i < analyser->functions->size && outResult->success; i++) {
+		FunctionDeclaration *declaration = Array_get(analyser->functions, i);
+		if(declaration->isAnalysed) continue;
+
+		*outResult = __Analyser_reanalyseFunctionDeclaration(analyser, declaration);
+	}
+
+	BitSet_destructor(&prepared);
+	BitSet_destructor(&signatures);
+	Array_free(changed);
+
+	return true;
 }
 
 
@@ -507,44 +749,62 @@ void __Analyser_registerBuiltInFunctions(Analyser *analyser) {
 	}
 }
 
-BlockScope* __Analyser_createBlockScopeChaining(Analyser *analyser, BlockASTNode *block, BlockScope *parent) {
+BlockScope* __Analyser_createBlockScopeChaining(BlockASTNode *block, BlockScope *parent) {
 	block->scope = BlockScope_alloc(parent);
 
-	for(size_t i = 0; i < block->statements->size; i++) {
-		StatementASTNode *statement = Array_get(block->statements, i);
+	// Blocks whose scope is already created, but their statements are not processed yet
+	Array /*<BlockASTNode>*/ *blocks = Array_alloc(0);
+	Array_push(blocks, block);
 
-		__Analyser_createBlockScopeChaining_processNode(analyser, statement, block->scope);
+	while(blocks->size > 0) {
+		BlockASTNode *current = Array_pop(blocks);
+
+		for(size_t i = 0; i < current->statements->size; i++) {
+			StatementASTNode *statement = Array_get(current->statements, i);
+
+			__Analyser_createBlockScopeChaining_processNode((ASTNode*)statement, current->scope, blocks);
+		}
 	}
 
+	Array_free(blocks);
+
 	return block->scope;
 }
 
-void __Analyser_createBlockScopeChaining_processNode(Analyser *analyser, ASTNode *node, BlockScope *parent) {
+void __Analyser_createBlockScopeChaining_processNode(ASTNode *node, BlockScope *parent, Array *blocks) {
 	switch(node->_type) {
 		case NODE_IF_STATEMENT: {
 			IfStatementASTNode *ifStatement = (IfStatementASTNode*)node;
-			__Analyser_createBlockScopeChaining(analyser, ifStatement->body, parent);
 
-			if(ifStatement->alternate) {
+			while(true) {
+				ifStatement->body->scope = BlockScope_alloc(parent);
+				Array_push(blocks, ifStatement->body);
+
+				if(!ifStatement->alternate) break;
+
 				if(ifStatement->alternate->_type == NODE_BLOCK) {
 					BlockASTNode *alternate = (BlockASTNode*)ifStatement->alternate;
-					__Analyser_createBlockScopeChaining(analyser, alternate, parent);
-				} else {
-					__Analyser_createBlockScopeChaining_processNode(analyser, ifStatement->alternate, parent);
+					alternate->scope = BlockScope_alloc(parent);
+					Array_push(blocks, alternate);
+					break;
 				}
+
+				ifStatement = (IfStatementASTNode*)ifStatement->alternate;
 			}
 		} break;
 
 		case NODE_WHILE_STATEMENT:
 		case NODE_FOR_STATEMENT: {
 			WhileStatementASTNode *loopStatement = (WhileStatementASTNode*)node;
-			BlockScope *child = __Analyser_createBlockScopeChaining(analyser, loopStatement->body, parent);
-			child->loop = (StatementASTNode*)loopStatement;
+			loopStatement->body->scope = BlockScope_alloc(parent);
+			loopStatement->body->scope->loop = (StatementASTNode*)loopStatement;
+			Array_push(blocks, loopStatement->body);
 		} break;
 
 		case NODE_FUNCTION_DECLARATION: {
 			FunctionDeclarationASTNode *function = (FunctionDeclarationASTNode*)node;
-			__Analyser_createBlockScopeChaining(analyser, function->body, parent);
+			function->body->scope = BlockScope_alloc(parent);
+			Array_push(blocks, function->body);
 		} break;
 
 		default: {
@@ -647,7 +907,7 @@ AnalyserResult __Analyser_validateTestCondition(Analyser *analyser, ASTNode *nod
 		);
 
 		// Add the new declaration to the scope of the while statement body
-		HashMap_set(conditionalStatemnt->body->scope->variables, newDeclaration->name->value, newDeclaration);
+		BlockScope_addDeclaration(conditionalStatemnt->body->scope, newDeclaration);
 
 		// Set the id of the identifier node to the id of the new declaration
 		identifier->id = newDeclaration->id;
@@ -655,17 +915,13 @@ AnalyserResult __Analyser_validateTestCondition(Analyser *analyser, ASTNode *nod
 		// Set the id from which the value is unwrapped
 		condition->fromId = declaration->id;
 
+		if(Analyser_isDeclarationGlobal(analyser, declaration->id)) __Analyser_addDependency(analyser, declaration->id);
+
 		// Try to find the nearest function scope
 		FunctionDeclaration *function = Analyser_getNearestFunctionDeclaration(analyser, conditionalStatemnt->body->scope);
 
 		// Register the variable declaration to the global/function scope
-		String *id = String_fromLong(newDeclaration->id);
-
-		if(function) {
-			HashMap_set(function->variables, id->value, newDeclaration);
-		} else {
-			HashMap_set(analyser->variables, id->value, newDeclaration);
-		}
+		__Analyser_registerVariable(analyser, function, newDeclaration);
 	} else {
 		// Get the type of the test expression
 		ValueType type;
@@ -697,9 +953,21 @@ AnalyserResult __Analyser_validateTestCondition(Analyser *analyser, ASTNode *nod
 }
 
 AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block) {
+	// Continue on a new stack segment, deeply nested blocks would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		AnalyserCall call = {.analyser = analyser, .node = (ASTNode*)block};
+		CallStack_extend(__Analyser_analyseBlock_extended, &call);
+		return call.result;
+	}
+
+	__Analyser_enterScope(analyser, block->scope);
+
 	for(size_t i = 0; i < block->statements->size; i++) {
 		StatementASTNode *statement = Array_get(block->statements, i);
 
+		// Declarations might change by the previous statement, memoized call resolutions are not valid anymore
+		analyser->epoch++;
+
 		switch(statement->_type) {
 			case NODE_VARIABLE_DECLARATION: {
 				VariableDeclarationASTNode *declarationNode = (VariableDeclarationASTNode*)statement;
@@ -786,10 +1054,10 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 					}
 
 					// Look for already existing variable with the same
-					VariableDeclaration *existingDeclaration = HashMap_get(block->scope->variables, declaration->name->value);
+					VariableDeclaration *existingDeclaration = Analyser_getVariableByName(analyser, declaration->name->value, block->scope);
 
 					// There is already a variable with the same name in the current scope
-					if(existingDeclaration && existingDeclaration->isUserDefined) {
+					if(existingDeclaration && existingDeclaration->scope == block->scope && existingDeclaration->isUserDefined) {
 						return AnalyserError(
 							RESULT_ERROR_SEMANTIC_VARIABLE_REDEFINITION, // TODO: Fixed
 							String_fromFormat("invalid redeclaration of '%s'", declaration->name->value),
@@ -818,18 +1086,10 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 					}
 
 					// Add the variable declaration to the current scope
-					HashMap_set(block->scope->variables, declaration->name->value, declaration);
+					__Analyser_bindVariable(analyser, block->scope, declaration);
 
 					// Register the variable declaration to the global/function scope
-					String *id = String_fromLong(declaration->id);
-
-					if(function) {
-						HashMap_set(function->variables, id->value, declaration);
-					} else {
-						HashMap_set(analyser->variables, id->value, declaration);
-					}
-
-					String_free(id);
+					__Analyser_registerVariable(analyser, function, declaration);
 				}
 			} break;
 
@@ -871,9 +1131,11 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 					);
 				}
 
-				if(HashMap_has(block->scope->variables, variable->name->value)) variable->isInitialized = true; // This is too strict
+				if(variable->scope == block->scope) variable->isInitialized = true; // This is too strict
 				variable->isUsed = true;
 				assignment->id->id = variable->id;
+
+				if(Analyser_isDeclarationGlobal(analyser, variable->id)) __Analyser_addDependency(analyser, variable->id);
 			} break;
 
 			case NODE_IF_STATEMENT: {
@@ -967,7 +1229,7 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 				forStatement->iterator->id = declaration->id;
 
 				// Add the new declaration to the scope of the for statement body
-				HashMap_set(forStatement->body->scope->variables, declaration->name->value, declaration);
+				BlockScope_addDeclaration(forStatement->body->scope, declaration);
 
 				// Additional stuff for the codegen
 				{
@@ -988,19 +1250,8 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 
 					// Register the variable declarations to the global/function scope
 					FunctionDeclaration *function = Analyser_getNearestFunctionDeclaration(analyser, block->scope);
-					String *iteratorId = String_fromLong(declaration->id);
-					String *endId = String_fromLong(endDeclaration->id);
-
-					if(function) {
-						HashMap_set(function->variables, iteratorId->value, declaration);
-						HashMap_set(function->variables, endId->value, endDeclaration);
-					} else {
-						HashMap_set(analyser->variables, iteratorId->value, declaration);
-						HashMap_set(analyser->variables, endId->value, endDeclaration);
-					}
-
-					String_free(iteratorId);
-					String_free(endId);
+					__Analyser_registerVariable(analyser, function, declaration);
+					__Analyser_registerVariable(analyser, function, endDeclaration);
 				}
 
 				// Analyse the body of the for statement
@@ -1020,38 +1271,8 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 					);
 				}
 
-				AnalyserResult result = __Analyser_analyseBlock(analyser, function->body);
+				AnalyserResult result = __Analyser_analyseFunctionDeclaration(analyser, function, block->scope);
 				if(!result.success) return result;
-
-				FunctionDeclaration *declaration = Analyser_getFunctionById(analyser, function->id->id);
-				assertf(declaration != NULL, "Cannot find function declaration with id %ld", function->id->id);
-
-				// TODO: handle implicit return
-
-				// If there is a variable in the global scope with the same name, it is an error
-				if(declaration->node->parameterList->parameters->size == 0) {
-					VariableDeclaration *variable = Analyser_getVariableByName(analyser, declaration->node->id->name->value, block->scope);
-
-					if(variable) {
-						return AnalyserError(
-							RESULT_ERROR_SEMANTIC_VARIABLE_REDEFINITION, // TODO: Fixed
-							String_fromFormat("invalid redeclaration of '%s'", declaration->node->id->name->value),
-							NULL
-						);
-					}
-				}
-
-				// Analyse the return statement reachability
-				if(declaration->returnType.type != TYPE_VOID && !__Analyser_isReturnReachable(analyser, function->body)) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_INVALID_RETURN,
-						String_fromFormat(
-							"missing return in global function expected to return '%s'",
-							__Analyser_stringifyType(declaration->returnType)->value
-						),
-						NULL
-					);
-				}
 			} break;
 
 			case NODE_RETURN_STATEMENT: {
@@ -1119,6 +1340,11 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 				// Assign the id of the function to the return statement for the codegen
 				returnStatement->id = function->id;
 
+				// Call of the resolved overload of the function itself is lowered into a jump to the start of its body
+				ExpressionASTNode *expression = returnStatement->expression;
+				returnStatement->isTailCall = expression && expression->_type == NODE_FUNCTION_CALL && ((FunctionCallASTNode*)expression)->id->id == function->id;
+				if(returnStatement->isTailCall) function->isTailRecursive = true;
+
 				function->isUsed = true;
 			} break;
 
@@ -1166,13 +1392,67 @@ AnalyserResult __Analyser_analyseBlock(Analyser *analyser, BlockASTNode *block)
 
 	}
 
+	// Bindings of the global scope stay visible after the analysis
+	if(block->scope->parent) __Analyser_leaveScope(analyser, block->scope);
+
 	// TODO: Uncomment this to print out all unhandled nodes
 	return AnalyserSuccess();
 }
 
+AnalyserResult __Analyser_analyseFunctionDeclaration(Analyser *analyser, FunctionDeclarationASTNode *function, BlockScope *scope) {
+	FunctionDeclaration *declaration = Analyser_getFunctionById(analyser, function->id->id);
+	assertf(declaration != NULL, "Cannot find function declaration with id %ld", function->id->id);
+
+	// Only the global variables declared before the function are visible in its body
+	declaration->bindingsOffset = analyser->bindings->size;
+
+	analyser->function = declaration;
+	AnalyserResult result = __Analyser_analyseBlock(analyser, function->body);
+	analyser->function = NULL;
+	if(!result.success) return result;
+
+	// TODO: handle implicit return
+
+	// If there is a variable in the global scope with the same name, it is an error
+	if(declaration->node->parameterList->parameters->size == 0) {
+		VariableDeclaration *variable = Analyser_getVariableByName(analyser, declaration->node->id->name->value, scope);
+
+		if(variable) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_VARIABLE_REDEFINITION, // TODO: Fixed
+				String_fromFormat("invalid redeclaration of '%s'", declaration->node->id->name->value),
+				NULL
+			);
+		}
+	}
+
+	// Analyse the return statement reachability
+	if(declaration->returnType.type != TYPE_VOID && !__Analyser_isReturnReachable(analyser, function->body)) {
+		return AnalyserError(
+			RESULT_ERROR_SEMANTIC_INVALID_RETURN,
+			String_fromFormat(
+				"missing return in global function expected to return '%s'",
+				__Analyser_stringifyType(declaration->returnType)->value
+			),
+			NULL
+		);
+	}
+
+	declaration->isAnalysed = true;
+
+	return AnalyserSuccess();
+}
+
 AnalyserResult __Analyser_resolveExpressionType(Analyser *analyser, ExpressionASTNode *node, BlockScope *scope, ValueType prefferedType, ValueType *outType) {
 	assertf(analyser != NULL);
 
+	// Continue on a new stack segment, deeply nested expressions would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		AnalyserCall call = {.analyser = analyser, .node = (ASTNode*)node, .scope = scope, .prefferedType = prefferedType, .outType = outType};
+		CallStack_extend(__Analyser_resolveExpressionType_extended, &call);
+		return call.result;
+	}
+
 	switch(node->_type) {
 		case NODE_LITERAL_EXPRESSION: {
 			// Literals are handled by parser, we just might need to retype them if requested
@@ -1198,12 +1478,12 @@ AnalyserResult __Analyser_resolveExpressionType(Analyser *analyser, ExpressionAS
 		case NODE_IDENTIFIER: {
 			IdentifierASTNode *identifier = (IdentifierASTNode*)node;
 
-			// This identifier node was already resolved
-			if(identifier->id != 0) {
-				VariableDeclaration *declaration = Analyser_getVariableById(analyser, identifier->id);
-				assertf(declaration);
+			// This identifier node was already resolved (unless the declaration was discarded by a re-analysis)
+			VariableDeclaration *resolved = identifier->id != 0 ? Analyser_getVariableById(analyser, identifier->id) : NULL;
+			if(resolved) {
+				if(Analyser_isDeclarationGlobal(analyser, resolved->id)) __Analyser_addDependency(analyser, resolved->id);
 
-				*outType = declaration->type;
+				*outType = resolved->type;
 				return AnalyserSuccess();
 			}
 
@@ -1239,329 +1519,83 @@ AnalyserResult __Analyser_resolveExpressionType(Analyser *analyser, ExpressionAS
 			identifier->id = declaration->id;
 			declaration->isUsed = true;
 			*outType = declaration->type;
+
+			if(Analyser_isDeclarationGlobal(analyser, declaration->id)) __Analyser_addDependency(analyser, declaration->id);
 		} break;
 
 		case NODE_FUNCTION_CALL: {
 			FunctionCallASTNode *call = (FunctionCallASTNode*)node;
 
-			// This function call node was already resolved
-			if(call->id->id != 0) {
-				FunctionDeclaration *declaration = Analyser_getFunctionById(analyser, call->id->id);
-				assertf(declaration);
+			// Overloaded calls are typed once for every candidate of the enclosing call, reuse the previous resolutions
+			ResolvedCall *resolved = __Analyser_getResolvedCall(analyser, call, prefferedType);
+			if(resolved) {
+				if(!resolved->result.success) return resolved->result;
 
-				// Only use already resolved type if the preffered type is the same, otherwise try to resolve it again
-				// Not sure about the nullable part
-				if(declaration->returnType.type == prefferedType.type && declaration->returnType.isNullable == prefferedType.isNullable) {
-					*outType = declaration->returnType;
-					return AnalyserSuccess();
+				// Arguments were typed for a different overload since then, type them for this one again
+				if(call->id->id != resolved->declaration->id) {
+					AnalyserResult result = __Analyser_retypeCallArguments(analyser, call, resolved->declaration, scope);
+					if(!result.success) return result;
 				}
-			}
 
-			// If not in global scope, look for non-global variable declaration
-			if(scope->parent) {
-				VariableDeclaration *declaration = Analyser_getVariableByName(analyser, call->id->name->value, scope);
+				__Analyser_addDependency(analyser, resolved->declaration->id);
 
-				if(declaration) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat(
-							"cannot call value of non-function type '%s'",
-							__Analyser_stringifyType(declaration->type)->value
-						),
-						NULL
-					);
-				}
+				*outType = resolved->type;
+				return AnalyserSuccess();
 			}
 
-			Array /*<FunctionDeclaration> | null*/ *overloads = Analyser_getFunctionDeclarationsByName(analyser, call->id->name->value);
-			Array /*<FunctionDeclaration> | null*/ *candidates = NULL;
-			bool hasMultipleCandidates = false;
-			FunctionDeclaration *declaration = NULL;
-
-			if(overloads && overloads->size > 1) {
-				AnalyserResult result = __Analyser_resolveFunctionOverloadCandidates(analyser, call, scope, &candidates);
-				if(!result.success) return result;
-
-				Array /*<FunctionDeclaration>*/ *betterCandidates = Array_alloc(1);
-
-				// Try to find the candidate with preffered return type
-				for(size_t i = 0; i < candidates->size; i++) {
-					FunctionDeclaration *candidate = Array_get(candidates, i);
-
-					if(prefferedType.type == TYPE_UNKNOWN || is_type_equal(prefferedType, candidate->returnType) || is_value_assignable(prefferedType, candidate->returnType)) {
-						// Multiple candidates matching
-						if(declaration) {
-							hasMultipleCandidates = true;
-						} else {
-							declaration = candidate;
-						}
-
-						Array_push(betterCandidates, candidate);
-					}
-				}
-
-				// If there are multiple candidates matching, try to find the best one
-				if(betterCandidates->size > 1) {
-					Array *arguments = call->argumentList->arguments;
-					Array /*<int>*/ *exactMatches = Array_alloc(betterCandidates->size);
-
-					for(size_t i = 0; i < arguments->size; i++) {
-						ArgumentASTNode *argument = Array_get(arguments, i);
+			AnalyserResult result = __Analyser_resolveFunctionCallType(analyser, call, scope, prefferedType, outType);
 
-						for(size_t j = 0; j < betterCandidates->size; j++) {
-							FunctionDeclaration *candidate = Array_get(betterCandidates, j);
-							ParameterASTNode *parameter = Array_get(candidate->node->parameterList->parameters, i);
+			// Failed resolution can leave the arguments typed for any of the candidates
+			if(!result.success) call->id->id = 0;
+			else __Analyser_addDependency(analyser, call->id->id);
 
-							ValueType type;
-							AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, (ValueType){.type = TYPE_UNKNOWN, .isNullable = false}, &type);
-							if(!result.success) return result;
+			__Analyser_memoizeCall(analyser, call, prefferedType, result, result.success ? *outType : (ValueType){.type = TYPE_INVALID, .isNullable = false});
 
-							int score = 0;
+			return result;
+		} break;
 
-							score += type.type == parameter->type->type.type;
-							score += type.isNullable == parameter->type->isNullable;
+		case NODE_UNARY_EXPRESSION: {
+			UnaryExpressionASTNode *unary = (UnaryExpressionASTNode*)node;
 
-							int *count = Array_get(exactMatches, j);
-							if(!count) {
-								count = mem_alloc(sizeof(int));
-								*count = 0;
-								Array_set(exactMatches, j, count);
-							}
+			switch(unary->operator) {
+				case OPERATOR_UNWRAP: {
+					ValueType type;
+					AnalyserResult result = __Analyser_resolveExpressionType(analyser, unary->argument, scope, (ValueType){.type = prefferedType.type, .isNullable = true}, &type);
+					if(!result.success) return result;
 
-							(*count) += score;
-						}
+					if(type.type == TYPE_NIL) {
+						return AnalyserError(
+							RESULT_ERROR_SEMANTIC_INVALID_TYPE,
+							String_fromFormat(
+								"'nil' literal cannot be force unwrapped",
+								__Analyser_stringifyType(type)->value
+							),
+							NULL
+						);
 					}
 
-					// Find the candidate with the most unique exact matches
-					int maxExactMatches = 0;
-					int count = 0;
-					size_t index = 0;
+					if(!type.isNullable) {
+						return AnalyserError(
+							RESULT_ERROR_SEMANTIC_INVALID_TYPE, // TODO ?
+							String_fromFormat("cannot force unwrap value of non-optional type '%s'", __Analyser_stringifyType(type)->value),
+							NULL
+						);
+					}
 
-					for(size_t i = 0; i < exactMatches->size; i++) {
-						int *exactMatchCount = Array_get(exactMatches, i);
+					unary->type = (ValueType){.type = type.type, .isNullable = false};
+				} break;
 
-						if(exactMatchCount && *exactMatchCount > maxExactMatches) {
-							maxExactMatches = *exactMatchCount;
-							count = 1;
-							index = i;
-						} else if(exactMatchCount && *exactMatchCount == maxExactMatches) {
-							count++;
-						}
-					}
+				case OPERATOR_NOT: {
+					ValueType type;
+					AnalyserResult result = __Analyser_resolveExpressionType(analyser, unary->argument, scope, prefferedType, &type);
+					if(!result.success) return result;
 
-					// Found the best candidate
-					if(count == 1) {
-						declaration = Array_get(betterCandidates, index);
-						hasMultipleCandidates = false;
-					}
-				}
-
-				Array_free(betterCandidates);
-			} else if(overloads) {
-				declaration = Array_get(overloads, 0);
-				assertf(declaration);
-			} else {
-				return AnalyserError(
-					RESULT_ERROR_SEMANTIC_UNDEFINED_FUNCTION,
-					String_fromFormat("cannot find '%s' in scope", call->id->name->value),
-					NULL
-				);
-			}
-
-			// Handle built-in 'write' function differently
-			if((!declaration || (overloads && overloads->size == 1)) && String_equals(call->id->name, "write")) {
-				Array /*<FunctionDeclaration>*/ *writeCandidates = Analyser_getFunctionDeclarationsByName(analyser, "write");
-				assertf(writeCandidates && writeCandidates->size > 0, "Cannot find built-in 'write' function");
-
-				// First function should be the built-in 'write' function
-				FunctionDeclaration *writeFunc = Array_get(writeCandidates, 0);
-				assertf(writeFunc);
-
-				if(writeFunc->node->builtin == FUNCTION_WRITE) {
-					declaration = writeFunc;
-
-					// Resolve all the arguments
-					Array /*<ArgumentASTNode>*/ *arguments = call->argumentList->arguments;
-
-					for(size_t i = 0; i < arguments->size; i++) {
-						ArgumentASTNode *argument = Array_get(arguments, i);
-
-						ValueType type;
-						AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, (ValueType){.type = TYPE_UNKNOWN, .isNullable = false}, &type);
-						if(!result.success) return result;
-
-						if((!is_type_valid(type.type) || type.type == TYPE_VOID) && type.type != TYPE_NIL) {
-							return AnalyserError(
-								RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-								String_fromFormat(
-									"cannot convert value of type '%s' to expected argument type 'Int? | Double? | String? | Bool?'",
-									__Analyser_stringifyType(type)->value
-								),
-								NULL
-							);
-						}
-					}
-
-					// Set properties of the call node
-					call->id->id = declaration->id;
-					declaration->isUsed = true;
-					*outType = declaration->returnType;
-
-					return AnalyserSuccess();
-				}
-			}
-
-			if(candidates) {
-				Array_free(candidates);
-				candidates = NULL;
-			}
-
-			if(!declaration) {
-				return AnalyserError(
-					RESULT_ERROR_SEMANTIC_UNDEFINED_FUNCTION,
-					String_fromFormat("no exact matches in call to global function '%s'", call->id->name->value),
-					NULL
-				);
-			}
-
-			if(hasMultipleCandidates) {
-				return AnalyserError(
-					RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-					String_fromFormat("ambiguous use of '%s'", call->id->name->value),
-					NULL
-				);
-			}
-
-			// Check for correct label names
-			Array /*<ArgumentASTNode>*/ *arguments = call->argumentList->arguments;
-			Array /*<ParameterASTNode>*/ *parameters = declaration->node->parameterList->parameters;
-			size_t length = max(arguments->size, parameters->size);
-
-			for(size_t i = 0; i < length; i++) {
-				ArgumentASTNode *argument = Array_get(arguments, i);
-				ParameterASTNode *parameter = Array_get(parameters, i);
-
-				// Missing argument for parameter
-				if(!argument) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat("missing argument for parameter '%s' in call", parameter->externalId->name->value),
-						NULL
-					);
-				}
-
-				// Too many arguments for parameters passed
-				if(!parameter) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat("extra argument in call"),
-						NULL
-					);
-				}
-
-				String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
-				assertf(externalName, "Parameter has no external or internal name");
-
-				// Parameter is labeless, but argument has a label
-				if(parameter->isLabeless && argument->label) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-						String_fromFormat("extraneous argument label '%s' in call", argument->label->name->value),
-						NULL
-					);
-				}
-
-				// Parameter has a label, but argument has no label
-				if(!parameter->isLabeless && !argument->label) {
-					return AnalyserError(
-						// RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat("missing argument label '%s' in call", externalName->value),
-						NULL
-					);
-				}
-
-				// Parameter has a label, but argument has a different label
-				if(!parameter->isLabeless && argument->label && !String_equals(externalName, argument->label->name->value)) {
-					return AnalyserError(
-						// RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat(
-							"incorrect argument label in call (have '%s', expected '%s')",
-							argument->label->name->value,
-							externalName->value
-						),
-						NULL
-					);
-				}
-
-				ValueType type;
-				AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, parameter->type->type, &type);
-				if(!result.success) return result;
-
-				// Is this really needed? Not sure so keeping it here
-				if(!is_value_assignable(parameter->type->type, type)) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
-						String_fromFormat(
-							"cannot convert value of type '%s' to expected argument type '%s'",
-							__Analyser_stringifyType(type)->value,
-							__Analyser_stringifyType(parameter->type->type)->value
-						),
-						NULL
-					);
-				}
-			}
-
-			call->id->id = declaration->id;
-			declaration->isUsed = true;
-			*outType = declaration->returnType;
-
-			return AnalyserSuccess();
-		} break;
-
-		case NODE_UNARY_EXPRESSION: {
-			UnaryExpressionASTNode *unary = (UnaryExpressionASTNode*)node;
-
-			switch(unary->operator) {
-				case OPERATOR_UNWRAP: {
-					ValueType type;
-					AnalyserResult result = __Analyser_resolveExpressionType(analyser, unary->argument, scope, (ValueType){.type = prefferedType.type, .isNullable = true}, &type);
-					if(!result.success) return result;
-
-					if(type.type == TYPE_NIL) {
-						return AnalyserError(
-							RESULT_ERROR_SEMANTIC_INVALID_TYPE,
-							String_fromFormat(
-								"'nil' literal cannot be force unwrapped",
-								__Analyser_stringifyType(type)->value
-							),
-							NULL
-						);
-					}
-
-					if(!type.isNullable) {
-						return AnalyserError(
-							RESULT_ERROR_SEMANTIC_INVALID_TYPE, // TODO ?
-							String_fromFormat("cannot force unwrap value of non-optional type '%s'", __Analyser_stringifyType(type)->value),
-							NULL
-						);
-					}
-
-					unary->type = (ValueType){.type = type.type, .isNullable = false};
-				} break;
-
-				case OPERATOR_NOT: {
-					ValueType type;
-					AnalyserResult result = __Analyser_resolveExpressionType(analyser, unary->argument, scope, prefferedType, &type);
-					if(!result.success) return result;
-
-					if(type.type != TYPE_BOOL) {
-						return AnalyserError(
-							RESULT_ERROR_SEMANTIC_INVALID_TYPE,
-							__Analyser_formatBooleanTestErrorMessage(type),
-							NULL
-						);
+					if(type.type != TYPE_BOOL) {
+						return AnalyserError(
+							RESULT_ERROR_SEMANTIC_INVALID_TYPE,
+							__Analyser_formatBooleanTestErrorMessage(type),
+							NULL
+						);
 					}
 
 					if(type.isNullable) {
@@ -1911,114 +1945,594 @@ AnalyserResult __Analyser_resolveExpressionType(Analyser *analyser, ExpressionAS
 	return AnalyserSuccess();
 }
 
-AnalyserResult __Analyser_collectFunctionDeclarations(Analyser *analyser) {
-	for(size_t i = 0; i < analyser->ast->block->statements->size; i++) {
-		StatementASTNode *statement = Array_get(analyser->ast->block->statements, i);
+AnalyserResult __Analyser_resolveFunctionCallType(Analyser *analyser, FunctionCallASTNode *call, BlockScope *scope, ValueType prefferedType, ValueType *outType) {
+	// This function call node was already resolved
+	if(call->id->id != 0) {
+		FunctionDeclaration *declaration = Analyser_getFunctionById(analyser, call->id->id);
+		assertf(declaration);
 
-		if(statement->_type != NODE_FUNCTION_DECLARATION) continue;
+		// Only use already resolved type if the preffered type is the same, otherwise try to resolve it again
+		// Not sure about the nullable part
+		if(declaration->returnType.type == prefferedType.type && declaration->returnType.isNullable == prefferedType.isNullable) {
+			*outType = declaration->returnType;
+			return AnalyserSuccess();
+		}
+	}
 
-		// Create a new function declaration
-		FunctionDeclarationASTNode *declarationNode = (FunctionDeclarationASTNode*)statement;
-		FunctionDeclaration *declaration = new_FunctionDeclaration(analyser, declarationNode);
+	// If not in global scope, look for non-global variable declaration
+	if(scope->parent) {
+		VariableDeclaration *declaration = Analyser_getVariableByName(analyser, call->id->name->value, scope);
 
-		// Mark block scope as function scope
-		declarationNode->body->scope->function = declaration;
+		if(declaration) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat(
+					"cannot call value of non-function type '%s'",
+					__Analyser_stringifyType(declaration->type)->value
+				),
+				NULL
+			);
+		}
+	}
 
-		// Register the function declaration to the global scope
-		HashMap_set(analyser->functions, String_fromLong(declaration->id)->value, declaration);
+	Array /*<FunctionDeclaration> | null*/ *overloads = Analyser_getFunctionDeclarationsByName(analyser, call->id->name->value);
+	Array /*<FunctionDeclaration> | null*/ *candidates = NULL;
+	bool hasMultipleCandidates = false;
+	FunctionDeclaration *declaration = NULL;
 
-		// Add id to the function declaration node
-		declarationNode->id->id = declaration->id;
+	if(overloads && overloads->size > 1) {
+		AnalyserResult result = __Analyser_resolveFunctionOverloadCandidates(analyser, call, scope, &candidates);
+		if(!result.success) return result;
 
-		// Resolve return type
-		if(declarationNode->returnType) {
-			declaration->returnType.type = Analyser_resolveBuiltInType(declarationNode->returnType->id->name);
-			declaration->returnType.isNullable = declarationNode->returnType->isNullable;
+		Array /*<FunctionDeclaration>*/ *betterCandidates = Array_alloc(1);
 
-			if(!is_type_valid(declaration->returnType.type)) {
-				return AnalyserError(
-					RESULT_ERROR_SYNTACTIC_ANALYSIS, // TODO: This should be everywhere, when checking types
-					String_fromFormat("cannot find type '%s' in scope", declarationNode->returnType->id->name->value),
-					NULL
-				);
+		// Try to find the candidate with preffered return type
+		for(size_t i = 0; i < candidates->size; i++) {
+			FunctionDeclaration *candidate = Array_get(candidates, i);
+
+			if(prefferedType.type == TYPE_UNKNOWN || is_type_equal(prefferedType, candidate->returnType) || is_value_assignable(prefferedType, candidate->returnType)) {
+				// Multiple candidates matching
+				if(declaration) {
+					hasMultipleCandidates = true;
+				} else {
+					declaration = candidate;
+				}
+
+				Array_push(betterCandidates, candidate);
 			}
-		} else {
-			declaration->returnType = (ValueType){.type = TYPE_VOID, .isNullable = false};
 		}
 
-		// TODO: Analyse function declaration
-		// Check for duplicate parameters
-		Array *parameterList = declarationNode->parameterList->parameters;
-		{
-			HashMap *variables = declaration->node->body->scope->variables;
+		// If there are multiple candidates matching, try to find the best one
+		if(betterCandidates->size > 1) {
+			Array *arguments = call->argumentList->arguments;
+			Array /*<int>*/ *exactMatches = Array_alloc(betterCandidates->size);
 
-			// This will effectively check for duplicate parameters + register them as local variables
-			for(size_t i = 0; i < parameterList->size; i++) {
-				ParameterASTNode *parameter = Array_get(parameterList, i);
-				String *name = parameter->internalId->name;
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
 
-				if(!parameter->type) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-						String_fromFormat("type annotation missing in parameter '%s'", name->value),
-						NULL
-					);
-				}
+				// Type of the argument does not depend on the candidate
+				ValueType type;
+				AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, (ValueType){.type = TYPE_UNKNOWN, .isNullable = false}, &type);
+				if(!result.success) return result;
 
-				// External paramter is missing (this is required in the assignment)
-				if(!parameter->externalId) {
-					return AnalyserError(
-						RESULT_ERROR_SYNTACTIC_ANALYSIS,
-						String_fromFormat("external parameter name missing in parameter '%s'", name->value),
-						NULL
-					);
+				for(size_t j = 0; j < betterCandidates->size; j++) {
+					FunctionDeclaration *candidate = Array_get(betterCandidates, j);
+					ParameterASTNode *parameter = Array_get(candidate->node->parameterList->parameters, i);
+
+					int score = 0;
+
+					score += type.type == parameter->type->type.type;
+					score += type.isNullable == parameter->type->isNullable;
+
+					int *count = Array_get(exactMatches, j);
+					if(!count) {
+						count = mem_alloc(sizeof(int));
+						*count = 0;
+						Array_set(exactMatches, j, count);
+					}
+
+					(*count) += score;
 				}
+			}
 
-				bool areNamesEqual = parameter->externalId && String_equals(name, parameter->externalId->name->value);
-				bool isUnderscoreDeclaration = parameter->isLabeless && areNamesEqual;
+			// Find the candidate with the most unique exact matches
+			int maxExactMatches = 0;
+			int count = 0;
+			size_t index = 0;
 
-				// Both name and label are the same (only if the parameter has an external name)
-				if(!isUnderscoreDeclaration && areNamesEqual) {
-					return AnalyserError(
-						RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
-						String_fromFormat("parameter name same as external label '%s'", name->value),
-						NULL
-					);
+			for(size_t i = 0; i < exactMatches->size; i++) {
+				int *exactMatchCount = Array_get(exactMatches, i);
+
+				if(exactMatchCount && *exactMatchCount > maxExactMatches) {
+					maxExactMatches = *exactMatchCount;
+					count = 1;
+					index = i;
+				} else if(exactMatchCount && *exactMatchCount == maxExactMatches) {
+					count++;
 				}
+			}
+
+			// Found the best candidate
+			if(count == 1) {
+				declaration = Array_get(betterCandidates, index);
+				hasMultipleCandidates = false;
+			}
+		}
+
+		Array_free(betterCandidates);
+	} else if(overloads) {
+		declaration = Array_get(overloads, 0);
+		assertf(declaration);
+	} else {
+		return AnalyserError(
+			RESULT_ERROR_SEMANTIC_UNDEFINED_FUNCTION,
+			String_fromFormat("cannot find '%s' in scope", call->id->name->value),
+			NULL
+		);
+	}
+
+	// Handle built-in 'write' function differently
+	if((!declaration || (overloads && overloads->size == 1)) && String_equals(call->id->name, "write")) {
+		Array /*<FunctionDeclaration>*/ *writeCandidates = Analyser_getFunctionDeclarationsByName(analyser, "write");
+		assertf(writeCandidates && writeCandidates->size > 0, "Cannot find built-in 'write' function");
+
+		// First function should be the built-in 'write' function
+		FunctionDeclaration *writeFunc = Array_get(writeCandidates, 0);
+		assertf(writeFunc);
+
+		if(writeFunc->node->builtin == FUNCTION_WRITE) {
+			declaration = writeFunc;
+
+			// Resolve all the arguments
+			Array /*<ArgumentASTNode>*/ *arguments = call->argumentList->arguments;
+
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
 
-				String *typeName = parameter->type->id->name;
-				enum BuiltInType resolvedType = Analyser_resolveBuiltInType(typeName);
+				ValueType type;
+				AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, (ValueType){.type = TYPE_UNKNOWN, .isNullable = false}, &type);
+				if(!result.success) return result;
 
-				if(!is_type_valid(resolvedType)) {
+				if((!is_type_valid(type.type) || type.type == TYPE_VOID) && type.type != TYPE_NIL) {
 					return AnalyserError(
-						RESULT_ERROR_SYNTACTIC_ANALYSIS, // TODO: Fixed
-						String_fromFormat("cannot find type '%s' in scope", typeName->value),
+						RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+						String_fromFormat(
+							"cannot convert value of type '%s' to expected argument type 'Int? | Double? | String? | Bool?'",
+							__Analyser_stringifyType(type)->value
+						),
 						NULL
 					);
 				}
+			}
 
-				// Create a new variable declaration
-				VariableDeclaration *variable = new_VariableDeclaration(
-					analyser,
-					NULL,
-					true,
-					(ValueType){.type = resolvedType, .isNullable = parameter->type->isNullable},
-					name,
-					false,
-					true
+			// Set properties of the call node
+			call->id->id = declaration->id;
+			declaration->isUsed = true;
+			*outType = declaration->returnType;
+
+			return AnalyserSuccess();
+		}
+	}
+
+	if(candidates) {
+		Array_free(candidates);
+		candidates = NULL;
+	}
+
+	if(!declaration) {
+		return AnalyserError(
+			RESULT_ERROR_SEMANTIC_UNDEFINED_FUNCTION,
+			String_fromFormat("no exact matches in call to global function '%s'", call->id->name->value),
+			NULL
+		);
+	}
+
+	if(hasMultipleCandidates) {
+		return AnalyserError(
+			RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+			String_fromFormat("ambiguous use of '%s'", call->id->name->value),
+			NULL
+		);
+	}
+
+	// Check for correct label names
+	Array /*<ArgumentASTNode>*/ *arguments = call->argumentList->arguments;
+	Array /*<ParameterASTNode>*/ *parameters = declaration->node->parameterList->parameters;
+	size_t length = max(arguments->size, parameters->size);
+
+	for(size_t i = 0; i < length; i++) {
+		ArgumentASTNode *argument = Array_get(arguments, i);
+		ParameterASTNode *parameter = Array_get(parameters, i);
+
+		// Missing argument for parameter
+		if(!argument) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat("missing argument for parameter '%s' in call", parameter->externalId->name->value),
+				NULL
+			);
+		}
+
+		// Too many arguments for parameters passed
+		if(!parameter) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat("extra argument in call"),
+				NULL
+			);
+		}
+
+		String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
+		assertf(externalName, "Parameter has no external or internal name");
+
+		// Parameter is labeless, but argument has a label
+		if(parameter->isLabeless && argument->label) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+				String_fromFormat("extraneous argument label '%s' in call", argument->label->name->value),
+				NULL
+			);
+		}
+
+		// Parameter has a label, but argument has no label
+		if(!parameter->isLabeless && !argument->label) {
+			return AnalyserError(
+				// RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat("missing argument label '%s' in call", externalName->value),
+				NULL
+			);
+		}
+
+		// Parameter has a label, but argument has a different label
+		if(!parameter->isLabeless && argument->label && !String_equals(externalName, argument->label->name->value)) {
+			return AnalyserError(
+				// RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat(
+					"incorrect argument label in call (have '%s', expected '%s')",
+					argument->label->name->value,
+					externalName->value
+				),
+				NULL
+			);
+		}
+
+		ValueType type;
+		AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, parameter->type->type, &type);
+		if(!result.success) return result;
+
+		// Is this really needed? Not sure so keeping it here
+		if(!is_value_assignable(parameter->type->type, type)) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_INVALID_FUNCTION_CALL_TYPE,
+				String_fromFormat(
+					"cannot convert value of type '%s' to expected argument type '%s'",
+					__Analyser_stringifyType(type)->value,
+					__Analyser_stringifyType(parameter->type->type)->value
+				),
+				NULL
+			);
+		}
+	}
+
+	call->id->id = declaration->id;
+	declaration->isUsed = true;
+	*outType = declaration->returnType;
+
+	return AnalyserSuccess();
+}
+
+AnalyserResult __Analyser_retypeCallArguments(Analyser *analyser, FunctionCallASTNode *call, FunctionDeclaration *declaration, BlockScope *scope) {
+	Array /*<ArgumentASTNode>*/ *arguments = call->argumentList->arguments;
+	Array /*<ParameterASTNode>*/ *parameters = declaration->node->parameterList->parameters;
+
+	for(size_t i = 0; i < arguments->size; i++) {
+		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		// Arguments of the built-in 'write' function are typed without any preference
+		ValueType parameterType = declaration->node->builtin == FUNCTION_WRITE ?
+			(ValueType){.type = TYPE_UNKNOWN, .isNullable = false} :
+			((ParameterASTNode*)Array_get(parameters, i))->type->type;
+
+		ValueType type;
+		AnalyserResult result = __Analyser_resolveExpressionType(analyser, argument->expression, scope, parameterType, &type);
+		if(!result.success) return result;
+	}
+
+	call->id->id = declaration->id;
+
+	return AnalyserSuccess();
+}
+
+ResolvedCall* __Analyser_getResolvedCall(Analyser *analyser, FunctionCallASTNode *call, ValueType prefferedType) {
+	Array /*<ResolvedCall>*/ *resolutions = call->resolutions;
+	if(!resolutions || resolutions->size == 0) return NULL;
+
+	// Resolutions from previous statements might depend on declarations that changed since then
+	if(((ResolvedCall*)Array_get(resolutions, 0))->epoch != analyser->epoch) {
+		for(size_t i = 0; i < resolutions->size; i++) {
+			mem_free(Array_get(resolutions, i));
+		}
+		Array_clear(resolutions);
+
+		return NULL;
+	}
+
+	for(size_t i = 0; i < resolutions->size; i++) {
+		ResolvedCall *resolved = Array_get(resolutions, i);
+
+		if(resolved->prefferedType.type == prefferedType.type && resolved->prefferedType.isNullable == prefferedType.isNullable) return resolved;
+	}
+
+	return NULL;
+}
+
+void __Analyser_memoizeCall(Analyser *analyser, FunctionCallASTNode *call, ValueType prefferedType, AnalyserResult result, ValueType type) {
+	if(!call->resolutions) call->resolutions = Array_alloc(1);
+
+	ResolvedCall *resolved = mem_alloc(sizeof(ResolvedCall));
+	resolved->epoch = analyser->epoch;
+	resolved->prefferedType = prefferedType;
+	resolved->type = type;
+	resolved->declaration = result.success ? Analyser_getFunctionById(analyser, call->id->id) : NULL;
+	resolved->result = result;
+
+	Array_push(call->resolutions, resolved);
+}
+
+void __Analyser_addDependency(Analyser *analyser, size_t id) {
+	if(!analyser->function) {
+		BitSet_set(analyser->dependencies, id, true);
+		return;
+	}
+
+	// Functions depend on a few declarations only, a list is smaller than a set indexed by id
+	Array *dependencies = analyser->function->dependencies;
+	Declaration *declaration = Analyser_getDeclarationById(analyser, id);
+
+	if(!dependencies) dependencies = analyser->function->dependencies = Array_alloc(1);
+	else if(dependencies->size > 0 && Array_get(dependencies, -1) == declaration) return;
+
+	Array_push(dependencies, declaration);
+}
+
+bool __Analyser_isDependency(FunctionDeclaration *function, Declaration *declaration) {
+	if(!function->dependencies) return false;
+
+	for(size_t i = 0; i < function->dependencies->size; i++) {
+		if(Array_get(function->dependencies, i) == declaration) return true;
+	}
+
+	return false;
+}
+
+bool __Analyser_isTypeReferenceEqual(TypeReferenceASTNode *type, TypeReferenceASTNode *other) {
+	if(!type || !other) return type == other;
+
+	return type->isNullable == other->isNullable && String_equals(type->id->name, other->id->name->value);
+}
+
+bool __Analyser_isSignatureEqual(FunctionDeclarationASTNode *node, FunctionDeclarationASTNode *other) {
+	Array *parameters = node->parameterList->parameters;
+	Array *otherParameters = other->parameterList->parameters;
+
+	if(parameters->size != otherParameters->size) return false;
+	if(!__Analyser_isTypeReferenceEqual(node->returnType, other->returnType)) return false;
+
+	for(size_t i = 0; i < parameters->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		ParameterASTNode *otherParameter = Array_get(otherParameters, i);
+
+		if(parameter->isLabeless != otherParameter->isLabeless) return false;
+		if(!__Analyser_isTypeReferenceEqual(parameter->type, otherParameter->type)) return false;
+
+		// Missing external name is reported by the analysis, labels are compared otherwise
+		if(!parameter->externalId || !otherParameter->externalId) {
+			if(parameter->externalId != otherParameter->externalId) return false;
+			continue;
+		}
+
+		if(!String_equals(parameter->externalId->name, otherParameter->externalId->name->value)) return false;
+	}
+
+	return true;
+}
+
+void __Analyser_discardFunctionAnalysis(Analyser *analyser, FunctionDeclaration *declaration) {
+	// Identifiers still referring to the discarded declarations are resolved again
+	Array *parameters = declaration->node->parameterList->parameters;
+
+	for(size_t i = 0; i < parameters->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		Array_set(analyser->declarations, parameter->internalId->id, NULL);
+	}
+
+	for(size_t i = 0; i < declaration->variables->size; i++) {
+		VariableDeclaration *variable = Array_get(declaration->variables, i);
+		Array_set(analyser->declarations, variable->id, NULL);
+	}
+
+	Array_clear(declaration->variables);
+	if(declaration->dependencies) Array_clear(declaration->dependencies);
+	declaration->isAnalysed = false;
+	declaration->isTailRecursive = false;
+	declaration->isLeaf = false;
+}
+
+void __Analyser_unregisterOverload(Analyser *analyser, FunctionDeclaration *declaration) {
+	String *selector = __Analyser_getFunctionSelector(declaration->node);
+	Array *lists[] = {
+		HashMap_get(analyser->selectors, selector->value),
+		HashMap_get(analyser->overloads, declaration->node->id->name->value)
+	};
+	String_free(selector);
+
+	for(size_t i = 0; i < sizeof(lists) / sizeof(*lists); i++) {
+		if(!lists[i]) continue;
+
+		// The declaration is missing if its previous registration failed
+		for(size_t j = 0; j < lists[i]->size; j++) {
+			if(Array_get(lists[i], j) != declaration) continue;
+
+			Array_remove(lists[i], j);
+			break;
+		}
+	}
+}
+
+AnalyserResult __Analyser_prepareFunctionDeclaration(Analyser *analyser, FunctionDeclaration *declaration) {
+	// Scopes are bound to the previous analysis, so the body gets new ones
+	__Analyser_createBlockScopeChaining(declaration->node->body, analyser->globalScope);
+
+	return __Analyser_collectFunctionSignature(analyser, declaration);
+}
+
+AnalyserResult __Analyser_reanalyseFunctionDeclaration(Analyser *analyser, FunctionDeclaration *declaration) {
+	Array *bindings = analyser->bindings;
+	Array /*<VariableDeclaration>*/ *hidden = Array_alloc(0);
+
+	// Hide the global variables declared after the function
+	while(bindings->size > declaration->bindingsOffset) {
+		Array_push(hidden, Array_pop(Array_pop(bindings)));
+	}
+
+	AnalyserResult result = __Analyser_analyseFunctionDeclaration(analyser, declaration->node, analyser->globalScope);
+
+	// Failed analysis does not leave the entered scopes
+	while(bindings->size > declaration->bindingsOffset) {
+		Array_pop(Array_pop(bindings));
+	}
+
+	while(hidden->size > 0) {
+		__Analyser_bindVariable(analyser, analyser->globalScope, Array_pop(hidden));
+	}
+
+	Array_free(hidden);
+
+	return result;
+}
+
+AnalyserResult __Analyser_collectFunctionDeclarations(Analyser *analyser) {
+	for(size_t i = 0; i < analyser->ast->block->statements->size; i++) {
+		StatementASTNode *statement = Array_get(analyser->ast->block->statements, i);
+
+		if(statement->_type != NODE_FUNCTION_DECLARATION) continue;
+
+		// Create a new function declaration
+		FunctionDeclarationASTNode *declarationNode = (FunctionDeclarationASTNode*)statement;
+		FunctionDeclaration *declaration = new_FunctionDeclaration(analyser, declarationNode);
+
+		// Register the function declaration to the global scope
+		Array_push(analyser->functions, declaration);
+		BitSet_set(analyser->globals, declaration->id, true);
+
+		AnalyserResult result = __Analyser_collectFunctionSignature(analyser, declaration);
+		if(!result.success) return result;
+
+		result = __Analyser_registerOverload(analyser, declaration);
+		if(!result.success) return result;
+	}
+
+	return AnalyserSuccess();
+}
+
+AnalyserResult __Analyser_collectFunctionSignature(Analyser *analyser, FunctionDeclaration *declaration) {
+	FunctionDeclarationASTNode *declarationNode = declaration->node;
+
+	// Mark block scope as function scope
+	declarationNode->body->scope->function = declaration;
+
+	// Add id to the function declaration node
+	declarationNode->id->id = declaration->id;
+
+	// Resolve return type
+	if(declarationNode->returnType) {
+		declaration->returnType.type = Analyser_resolveBuiltInType(declarationNode->returnType->id->name);
+		declaration->returnType.isNullable = declarationNode->returnType->isNullable;
+
+		if(!is_type_valid(declaration->returnType.type)) {
+			return AnalyserError(
+				RESULT_ERROR_SYNTACTIC_ANALYSIS, // TODO: This should be everywhere, when checking types
+				String_fromFormat("cannot find type '%s' in scope", declarationNode->returnType->id->name->value),
+				NULL
+			);
+		}
+	} else {
+		declaration->returnType = (ValueType){.type = TYPE_VOID, .isNullable = false};
+	}
+
+	// TODO: Analyse function declaration
+	// Check for duplicate parameters
+	Array *parameterList = declarationNode->parameterList->parameters;
+	{
+		BlockScope *scope = declaration->node->body->scope;
+
+		// This will effectively check for duplicate parameters + register them as local variables
+		for(size_t i = 0; i < parameterList->size; i++) {
+			ParameterASTNode *parameter = Array_get(parameterList, i);
+			String *name = parameter->internalId->name;
+
+			if(!parameter->type) {
+				return AnalyserError(
+					RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+					String_fromFormat("type annotation missing in parameter '%s'", name->value),
+					NULL
 				);
+			}
 
-				// Update the parameter with resolved type and id
-				parameter->type->type = variable->type;
-				parameter->internalId->id = variable->id;
+			// External paramter is missing (this is required in the assignment)
+			if(!parameter->externalId) {
+				return AnalyserError(
+					RESULT_ERROR_SYNTACTIC_ANALYSIS,
+					String_fromFormat("external parameter name missing in parameter '%s'", name->value),
+					NULL
+				);
+			}
 
-				if(!isUnderscoreDeclaration) {
-					// If the parameter is not in the hashmap yet
-					if(!HashMap_has(variables, name->value)) {
-						// Add the parameter to the hashmap
-						HashMap_set(variables, name->value, variable);
-						continue;
-					}
+			bool areNamesEqual = parameter->externalId && String_equals(name, parameter->externalId->name->value);
+			bool isUnderscoreDeclaration = parameter->isLabeless && areNamesEqual;
+
+			// Both name and label are the same (only if the parameter has an external name)
+			if(!isUnderscoreDeclaration && areNamesEqual) {
+				return AnalyserError(
+					RESULT_ERROR_SEMANTIC_OTHER, // TODO: Fixed
+					String_fromFormat("parameter name same as external label '%s'", name->value),
+					NULL
+				);
+			}
+
+			String *typeName = parameter->type->id->name;
+			enum BuiltInType resolvedType = Analyser_resolveBuiltInType(typeName);
+
+			if(!is_type_valid(resolvedType)) {
+				return AnalyserError(
+					RESULT_ERROR_SYNTACTIC_ANALYSIS, // TODO: Fixed
+					String_fromFormat("cannot find type '%s' in scope", typeName->value),
+					NULL
+				);
+			}
+
+			// Create a new variable declaration
+			VariableDeclaration *variable = new_VariableDeclaration(
+				analyser,
+				NULL,
+				true,
+				(ValueType){.type = resolvedType, .isNullable = parameter->type->isNullable},
+				name,
+				false,
+				true
+			);
+
+			// Update the parameter with resolved type and id
+			parameter->type->type = variable->type;
+			parameter->internalId->id = variable->id;
+
+			if(!isUnderscoreDeclaration) {
+				// Look for a previous parameter with the same name (parameter lists are short)
+				for(size_t j = 0; scope->declarations && j < scope->declarations->size; j++) {
+					VariableDeclaration *previous = Array_get(scope->declarations, j);
+					if(!String_equals(previous->name, name->value)) continue;
 
 					// There is already a parameter with the same name
 					return AnalyserError(
@@ -2027,80 +2541,117 @@ AnalyserResult __Analyser_collectFunctionDeclarations(Analyser *analyser) {
 						NULL
 					);
 				}
+
+				// Bind the parameter once the function body is entered
+				BlockScope_addDeclaration(scope, variable);
 			}
 		}
+	}
 
-		// Query the hashmap for the function declaration
-		String *name = declarationNode->id->name;
-		Array *overloads = HashMap_get(analyser->overloads, name->value);
+	return AnalyserSuccess();
+}
 
-		// No overloads yet, create a new array and add the function declaration
-		if(!overloads) {
-			// Allocate a new array to store possible overloads
-			overloads = Array_alloc(1);
+AnalyserResult __Analyser_registerOverload(Analyser *analyser, FunctionDeclaration *declaration) {
+	FunctionDeclarationASTNode *declarationNode = declaration->node;
+	Array *parameterList = declarationNode->parameterList->parameters;
 
-			// Add the array to the hashmap
-			HashMap_set(analyser->overloads, name->value, overloads);
+	// Register the function declaration to the overloads with the same argument labels
+	String *selector = __Analyser_getFunctionSelector(declarationNode);
+	Array *selectorOverloads = HashMap_get(analyser->selectors, selector->value);
 
-			// Add the function declaration to the array
-			Array_push(overloads, declaration);
+	if(!selectorOverloads) {
+		selectorOverloads = Array_alloc(1);
+		HashMap_set(analyser->selectors, selector->value, selectorOverloads);
+	}
 
-			continue;
-		}
+	Array_push(selectorOverloads, declaration);
+	String_free(selector);
+
+	// Query the hashmap for the function declaration
+	String *name = declarationNode->id->name;
+	Array *overloads = HashMap_get(analyser->overloads, name->value);
 
-		// Look for an overload with the same number of parameters
-		for(size_t i = 0; i < overloads->size; i++) {
-			FunctionDeclaration *overload = Array_get(overloads, i);
-			Array *parameters = overload->node->parameterList->parameters;
+	// No overloads yet, create a new array and add the function declaration
+	if(!overloads) {
+		// Allocate a new array to store possible overloads
+		overloads = Array_alloc(1);
 
-			// Different number of parameters, skip
-			if(parameters->size != parameterList->size) continue;
+		// Add the array to the hashmap
+		HashMap_set(analyser->overloads, name->value, overloads);
 
-			// Different return type, skip
-			if(!is_type_equal(overload->returnType, declaration->returnType)) continue;
+		// Add the function declaration to the array
+		Array_push(overloads, declaration);
 
-			// Check for parameters
-			bool isMatching = true;
-			for(size_t j = 0; j < parameters->size; j++) {
-				ParameterASTNode *parameter = Array_get(parameters, j);
-				ParameterASTNode *otherParameter = Array_get(parameterList, j);
+		return AnalyserSuccess();
+	}
 
-				// Different parameter types, skip
-				if(!is_type_equal(parameter->type->type, otherParameter->type->type)) {
-					isMatching = false;
-					break;
-				}
+	// Look for an overload with the same number of parameters
+	for(size_t i = 0; i < overloads->size; i++) {
+		FunctionDeclaration *overload = Array_get(overloads, i);
+		Array *parameters = overload->node->parameterList->parameters;
 
-				// Different external parameter name, skip
-				String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
-				String *otherExternalName = otherParameter->externalId ? otherParameter->externalId->name : otherParameter->internalId->name;
-				assertf(externalName, "Parameter has no external or internal name");
-				assertf(otherExternalName, "Parameter has no external or internal name");
+		// Different number of parameters, skip
+		if(parameters->size != parameterList->size) continue;
 
-				if(!String_equals(externalName, otherExternalName->value)) {
-					isMatching = false;
-					break;
-				}
+		// Different return type, skip
+		if(!is_type_equal(overload->returnType, declaration->returnType)) continue;
+
+		// Check for parameters
+		bool isMatching = true;
+		for(size_t j = 0; j < parameters->size; j++) {
+			ParameterASTNode *parameter = Array_get(parameters, j);
+			ParameterASTNode *otherParameter = Array_get(parameterList, j);
 
-				// Found a matching overload
-				isMatching = true;
+			// Different parameter types, skip
+			if(!is_type_equal(parameter->type->type, otherParameter->type->type)) {
+				isMatching = false;
+				break;
 			}
 
-			// Found a matching overload
-			if(isMatching) {
-				return AnalyserError(
-					RESULT_ERROR_SEMANTIC_VARIABLE_REDEFINITION, // TODO: Fixed
-					String_fromFormat("invalid redeclaration of '%s'", name->value),
-					NULL
-				);
+			// Different external parameter name, skip
+			String *externalName = parameter->externalId ? parameter->externalId->name : parameter->internalId->name;
+			String *otherExternalName = otherParameter->externalId ? otherParameter->externalId->name : otherParameter->internalId->name;
+			assertf(externalName, "Parameter has no external or internal name");
+			assertf(otherExternalName, "Parameter has no external or internal name");
+
+			if(!String_equals(externalName, otherExternalName->value)) {
+				isMatching = false;
+				break;
 			}
+
+			// Found a matching overload
+			isMatching = true;
 		}
 
-		// No matching overload found, add the function declaration to the array
-		Array_push(overloads, declaration);
+		// Found a matching overload
+		if(isMatching) {
+			return AnalyserError(
+				RESULT_ERROR_SEMANTIC_VARIABLE_REDEFINITION, // TODO: Fixed
+				String_fromFormat("invalid redeclaration of '%s'", name->value),
+				NULL
+			);
+		}
 	}
 
+	// No matching overload found, add the function declaration to the array
+	Array_push(overloads, declaration);
+
 	return AnalyserSuccess();
 }
 
+void __Analyser_analyseBlock_extended(void *context) {
+	AnalyserCall *call = context;
+	call->result = __Analyser_analyseBlock(call->analyser, (BlockASTNode*)call->node);
+}
+
+void __Analyser_resolveExpressionType_extended(void *context) {
+	AnalyserCall *call = context;
+	call->result = __Analyser_resolveExpressionType(call->analyser, (ExpressionASTNode*)call->node, call->scope, call->prefferedType, call->outType);
+}
+
+void __Analyser_isReturnReachable_extended(void *context) {
+	AnalyserCall *call = context;
+	call->isReachable = __Analyser_isReturnReachable(call->analyser, (BlockASTNode*)call->node);
+}
+
 /** End of file src/compiler/analyser/Analyser.c **/
@@ -6,18 +6,20 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "compiler/parser/ASTNodes.h"
 #include "compiler/codegen/Instruction.h"
 #include "compiler/codegen/Codegen.h"
 #include "internal/String.h"
 #include "internal/Array.h"
+#include "internal/CallStack.h"
 #include "assertf.h"
 
 void __Codegen_generate(Codegen *codegen);
 void __Codegen_generatePreamble();
 void __Codegen_generateVariableDeclaration(Codegen *codegen, VariableDeclaration *variable);
-void __Codegen_generateBuiltInFunctions();
+void __Codegen_generateBuiltInFunctions(Codegen *codegen);
 void __Codegen_generateUserFunctions(Codegen *codegen);
 void __Codegen_generateGlobalVariablesDeclarations(Codegen *codegen);
 void __Codegen_generateHelperVariables();
@@ -27,6 +29,8 @@ void __Codegen_generateOrd();
 void __Codegen_generateChr();
 void __Codegen_generateLength();
 void __Codegen_generateSubstring();
+void __Codegen_generateStringifyInt();
+void __Codegen_generateStringifyDouble();
 
 // Builtin function calls
 void __Codegen_callOrd(Codegen *codegen, FunctionCallASTNode *functionCall);
@@ -36,19 +40,23 @@ void __Codegen_callSubstring(Codegen *codegen, FunctionCallASTNode *functionCall
 void __Codegen_callDoubleToInt(Codegen *codegen, FunctionCallASTNode *functionCall);
 void __Codegen_callIntToDouble(Codegen *codegen, FunctionCallASTNode *functionCall);
 void __Codegen_callWrite(Codegen *codegen, FunctionCallASTNode *functionCall);
+void __Codegen_callStringify(Codegen *codegen, FunctionCallASTNode *functionCall, enum BuiltInFunction builtin);
+void __Codegen_convertStringify(Codegen *codegen, enum BuiltInFunction builtin, ValueType type);
 void __Codegen_callReadDouble();
 void __Codegen_callReadInt();
 void __Codegen_callReadString();
 
 // User functions
 void __Codegen_generateFunctionDeclaration(Codegen *codegen, FunctionDeclaration *functionDeclaration);
+void __Codegen_convertLeafFunction(Codegen *codegen, FunctionDeclaration *functionDeclaration, InstructionList *function);
+void __Codegen_generateLeafVariables(Codegen *codegen);
 
 // Walking AST functions
 void __Codegen_generateMain(Codegen *codegen);
 void __Codegen_evaluateIfStatement(Codegen *codegen, IfStatementASTNode *ifStatement);
 void __Codegen_evaluateWhileStatement(Codegen *codegen, WhileStatementASTNode *whileStatement);
 void __Codegen_evaluateBinaryExpression(Codegen *codegen, BinaryExpressionASTNode *binaryExpression);
-void __Codegen_evaluateBinaryOperator(BinaryExpressionASTNode *expression);
+void __Codegen_evaluateBinaryOperator(Codegen *codegen, BinaryExpressionASTNode *expression);
 void __Codegen_evaluateLiteral(LiteralExpressionASTNode *literal);
 void __Codegen_evaluateVariableDeclaration(Codegen *codegen, VariableDeclarationASTNode *variableDeclaration);
 void __Codegen_evaluateVariableDeclarationList(Codegen *codegen, VariableDeclarationListASTNode *declarationList);
@@ -58,6 +66,7 @@ void __Codegen_evaluateExpressionStatement(Codegen *codegen, ExpressionStatement
 void __Codegen_evaluateExpression(Codegen *codegen, ExpressionASTNode *expression);
 void __Codegen_evaluateBlock(Codegen *codegen, BlockASTNode *block);
 void __Codegen_evaluateFunctionCall(Codegen *codegen, FunctionCallASTNode *functionCall);
+void __Codegen_evaluateTailCall(Codegen *codegen, FunctionCallASTNode *functionCall);
 void __Codegen_evaluateStatement(Codegen *codegen, StatementASTNode *statementAstNode);
 void __Codegen_evaluateReturnStatement(Codegen *codegen, ReturnStatementASTNode *returnStatement);
 void __Codegen_evaluateBindingCondition(Codegen *codegen, OptionalBindingConditionASTNode *optionalBindingCondition);
@@ -65,6 +74,42 @@ void __Codegen_evaluateForStatement(Codegen *codegen, ForStatementASTNode *forSt
 void __Codegen_evaluateRangeOperator(enum OperatorType rangeOperator);
 void __Codegen_evaluateBreakStatement(BreakStatementASTNode *breakStatement);
 void __Codegen_evaluateContinueStatement(ContinueStatementASTNode *continueStatement);
+void __Codegen_evaluateCondition(Codegen *codegen, ExpressionASTNode *test, bool isJumpIfTrue, char *label, size_t id);
+void __Codegen_evaluateShortCircuit(Codegen *codegen, BinaryExpressionASTNode *expression);
+void __Codegen_evaluateExpression_extended(void *context);
+void __Codegen_evaluateCondition_extended(void *context);
+void __Codegen_evaluateBlock_extended(void *context);
+
+// Three-address lowering
+Operand __Codegen_lowerExpression(Codegen *codegen, ExpressionASTNode *expression, Operand *destination);
+Operand __Codegen_lowerBinaryExpression(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *destination);
+void __Codegen_lowerOperands(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *outLeft, Operand *outRight);
+void __Codegen_lowerAssignment(Codegen *codegen, ExpressionASTNode *expression, Operand destination);
+void __Codegen_lowerCondition(Codegen *codegen, ExpressionASTNode *test, bool isJumpIfTrue, char *label, size_t id);
+Operand __Codegen_lowerShortCircuit(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *destination);
+Operand __Codegen_lowerBuiltInFunction(Codegen *codegen, FunctionCallASTNode *functionCall, enum BuiltInFunction builtin, Operand *destination);
+Operand __Codegen_lowerSubstring(Codegen *codegen, Operand *arguments, Operand *destination);
+Operand __Codegen_lowerConcatenation(Codegen *codegen, ExpressionASTNode *expression, Operand *destination);
+Operand __Codegen_lowerSegments(Codegen *codegen, Array *segments, size_t count, Operand *destination);
+void __Codegen_lowerStringify(Codegen *codegen, FunctionCallASTNode *stringify, Operand *target, Operand *prefix);
+void __Codegen_lowerWrite(Codegen *codegen, ExpressionASTNode *expression);
+void __Codegen_appendSegment(Operand *target, Operand *prefix, Operand segment);
+Operand __Codegen_mergeLiterals(Array *segments, size_t start, size_t count, size_t *outNext);
+ExpressionASTNode* __Codegen_getWrittenValue(Codegen *codegen, ExpressionASTNode *segment);
+Array /*<ExpressionASTNode>*/* __Codegen_getConcatenationSegments(Codegen *codegen, ExpressionASTNode *expression);
+enum BuiltInFunction __Codegen_getStringify(Codegen *codegen, ExpressionASTNode *expression);
+bool __Codegen_isStringLiteral(ExpressionASTNode *expression);
+void __Codegen_lowerArguments(Codegen *codegen, Array *arguments, Operand *outArguments);
+bool __Codegen_isInlineBuiltIn(enum BuiltInFunction builtin);
+void __Codegen_lowerExpression_extended(void *context);
+bool __Codegen_isLowerable(Codegen *codegen, ExpressionASTNode *expression);
+bool __Codegen_hasCalls(Codegen *codegen, ExpressionASTNode *expression);
+Operand __Codegen_getVariableOperand(Codegen *codegen, size_t id);
+Operand __Codegen_getLiteralOperand(LiteralExpressionASTNode *literal);
+ValueType __Codegen_getExpressionType(Codegen *codegen, ExpressionASTNode *expression);
+Operand __Codegen_allocateTemporary(Codegen *codegen);
+void __Codegen_beginTemporaries(Codegen *codegen, InstructionList *body);
+void __Codegen_declareTemporaries(Codegen *codegen, InstructionList *list, InstructionList *body);
 
 // Optimalizations
 void __Codegen_generateCoalescing();
@@ -78,6 +123,20 @@ void Codegen_constructor(Codegen *codegen, Analyser *analyser) {
 
 	codegen->analyser = analyser;
 	codegen->frame = FRAME_GLOBAL;
+	codegen->lowering = LOWERING_THREE_ADDRESS;
+	codegen->temporaries = 0;
+	codegen->maxTemporaries = 0;
+	codegen->labels = 0;
+	codegen->leafTemporaries = 0;
+
+	FrameAllocator_constructor(&codegen->allocator);
+	InstructionList_constructor(&codegen->leafVariables);
+
+	for(size_t i = 0; i < ROUTINES_COUNT; i++) {
+		codegen->usedRoutines[i] = false;
+	}
+
+	InstructionList_constructor(&codegen->instructions);
 }
 
 void Codegen_destructor(Codegen *codegen) {
@@ -85,13 +144,26 @@ void Codegen_destructor(Codegen *codegen) {
 	assertf(codegen->analyser != NULL);
 
 	codegen->analyser = NULL;
+
+	FrameAllocator_destructor(&codegen->allocator);
+	InstructionList_destructor(&codegen->leafVariables);
+	InstructionList_destructor(&codegen->instructions);
 }
 
 void Codegen_generate(Codegen *codegen) {
 	assertf(codegen != NULL);
 	assertf(codegen->analyser != NULL);
 
+	InstructionList_select(&codegen->instructions);
 	__Codegen_generate(codegen);
+	InstructionList_select(NULL);
+}
+
+void Codegen_emit(Codegen *codegen, FILE *stream) {
+	assertf(codegen != NULL);
+	assertf(stream != NULL);
+
+	InstructionList_serialize(&codegen->instructions, stream);
 }
 
 
@@ -103,7 +175,6 @@ void __Codegen_generate(Codegen *codegen) {
 	Instruction_jump("main");
 	NEWLINE
 
-	__Codegen_generateBuiltInFunctions();
 	__Codegen_generateUserFunctions(codegen);
 
 	// Main
@@ -112,7 +183,18 @@ void __Codegen_generate(Codegen *codegen) {
 	NEWLINE
 
 	__Codegen_generateGlobalVariablesDeclarations(codegen);
+	__Codegen_generateLeafVariables(codegen);
+
+	InstructionList body;
+	__Codegen_beginTemporaries(codegen, &body);
 	__Codegen_generateMain(codegen);
+	__Codegen_declareTemporaries(codegen, &codegen->instructions, &body);
+
+	// Routines are generated once all the calls are known, the main body must not fall through to them
+	Instruction_exit(0);
+	NEWLINE
+
+	__Codegen_generateBuiltInFunctions(codegen);
 }
 
 void __Codegen_generatePreamble() {
@@ -132,18 +214,21 @@ void __Codegen_generateHelperVariables() {
 	Instruction_defvar("CONCAT_ARG1", FRAME_GLOBAL);
 	Instruction_defvar("CONCAT_ARG2", FRAME_GLOBAL);
 	Instruction_defvar("CONCAT_OUTPUT", FRAME_GLOBAL);
+	Instruction_defvar("DISCARD_TMP", FRAME_GLOBAL);
 
 	NEWLINE
 }
 
-void __Codegen_generateBuiltInFunctions() {
+void __Codegen_generateBuiltInFunctions(Codegen *codegen) {
 	COMMENT("--- [Built-in functions] ---")
 
-	__Codegen_generateOrd();
-	__Codegen_generateChr();
-	__Codegen_generateLength();
-	__Codegen_generateSubstring();
-	__Codegen_generateCoalescing();
+	if(codegen->usedRoutines[ROUTINE_ORD]) __Codegen_generateOrd();
+	if(codegen->usedRoutines[ROUTINE_CHR]) __Codegen_generateChr();
+	if(codegen->usedRoutines[ROUTINE_LENGTH]) __Codegen_generateLength();
+	if(codegen->usedRoutines[ROUTINE_SUBSTRING]) __Codegen_generateSubstring();
+	if(codegen->usedRoutines[ROUTINE_STRINGIFY_INT]) __Codegen_generateStringifyInt();
+	if(codegen->usedRoutines[ROUTINE_STRINGIFY_DOUBLE]) __Codegen_generateStringifyDouble();
+	if(codegen->usedRoutines[ROUTINE_COALESCING]) __Codegen_generateCoalescing();
 }
 
 void __Codegen_generateOrd() {
@@ -154,17 +239,9 @@ void __Codegen_generateOrd() {
 	Instruction_pushframe();
 	Instruction_defvar("RETVAL_ORD", FRAME_LOCAL);
 
-	// Overhead for calling length
-	Instruction_createframe();
-	Instruction_defvar("ARG1_LEN", FRAME_TEMPORARY);
-	Instruction_move_vars(FRAME_TEMPORARY, "ARG1_LEN", FRAME_LOCAL, "ARG1_ORD");
-
-	// Call length
-	Instruction_call("length");
-
-	// Handle length(...) return value
+	// Length of the string
 	Instruction_defvar("STRLEN_OUTPUT", FRAME_LOCAL);
-	Instruction_move_vars(FRAME_LOCAL, "STRLEN_OUTPUT", FRAME_TEMPORARY, "RETVAL_LEN");
+	Instruction_strlen(FRAME_LOCAL, "STRLEN_OUTPUT", "ARG1_ORD", FRAME_LOCAL);
 
 	// Return value can be implicitly zero
 	Instruction_move_int(FRAME_LOCAL, "RETVAL_ORD", 0);
@@ -260,18 +337,8 @@ void __Codegen_generateSubstring() {
 	Instruction_jump_ifeqs("substr_end");
 
 	// i >= length(string) and j > length(string)
-
-	// Overhead for calling length
-	Instruction_createframe();
-	Instruction_defvar("ARG1_LEN", FRAME_TEMPORARY);
-	Instruction_move_vars(FRAME_TEMPORARY, "ARG1_LEN", FRAME_LOCAL, "ARG1_SUBSTR");
-
-	// Call length
-	Instruction_call("length");
-
-	// Handle return value
 	Instruction_defvar("STRLEN_OUTPUT", FRAME_LOCAL);
-	Instruction_move_vars(FRAME_LOCAL, "STRLEN_OUTPUT", FRAME_TEMPORARY, "RETVAL_LEN");
+	Instruction_strlen(FRAME_LOCAL, "STRLEN_OUTPUT", "ARG1_SUBSTR", FRAME_LOCAL);
 
 	// Check if i >= length(string)
 	Instruction_pushs("ARG2_SUBSTR", FRAME_LOCAL);
@@ -324,6 +391,192 @@ void __Codegen_generateSubstring() {
 	NEWLINE
 }
 
+void __Codegen_generateStringifyInt() {
+	COMMENT("[Builtin] stringify(int)")
+	Instruction_label("stringify_int");
+
+	// Overhead
+	Instruction_pushframe();
+	Instruction_defvar("STRINGIFY_QUOTIENT", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_DIGIT", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_NEGATIVE", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_BORROW", FRAME_LOCAL);
+
+	Operand value = Operand_variable(FRAME_LOCAL, "ARG1_STRINGIFY");
+	Operand result = Operand_variable(FRAME_LOCAL, "RETVAL_STRINGIFY");
+	Operand quotient = Operand_variable(FRAME_LOCAL, "STRINGIFY_QUOTIENT");
+	Operand digit = Operand_variable(FRAME_LOCAL, "STRINGIFY_DIGIT");
+	Operand negative = Operand_variable(FRAME_LOCAL, "STRINGIFY_NEGATIVE");
+	Operand borrow = Operand_variable(FRAME_LOCAL, "STRINGIFY_BORROW");
+
+	String string;
+	String_constructor(&string, "");
+	Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+
+	// Digits are extracted from the non-positive value, the minimum Int has no positive counterpart
+	Instruction_emit(OPCODE_LT, 3, negative, value, Operand_int(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_int_loop"), negative, Operand_bool(true));
+	Instruction_emit(OPCODE_SUB, 3, value, Operand_int(0), value);
+
+	// Digits are prepended from the least significant one, zero has a single digit
+	Instruction_label("stringify_int_loop");
+	Instruction_emit(OPCODE_IDIV, 3, quotient, value, Operand_int(10));
+	Instruction_emit(OPCODE_MUL, 3, digit, quotient, Operand_int(10));
+	Instruction_emit(OPCODE_SUB, 3, digit, digit, value);
+
+	// Quotient rounded down instead of toward zero leaves a negative digit
+	Instruction_emit(OPCODE_LT, 3, borrow, digit, Operand_int(0));
+	Instruction_emit(OPCODE_JUMPIFNEQ, 3, Operand_label("stringify_int_digit"), borrow, Operand_bool(true));
+	Instruction_emit(OPCODE_ADD, 3, quotient, quotient, Operand_int(1));
+	Instruction_emit(OPCODE_ADD, 3, digit, digit, Operand_int(10));
+
+	Instruction_label("stringify_int_digit");
+	Instruction_emit(OPCODE_ADD, 3, digit, digit, Operand_int('0'));
+	Instruction_emit(OPCODE_INT2CHAR, 2, digit, digit);
+	Instruction_emit(OPCODE_CONCAT, 3, result, digit, result);
+	Instruction_emit(OPCODE_MOVE, 2, value, quotient);
+	Instruction_emit(OPCODE_JUMPIFNEQ, 3, Operand_label("stringify_int_loop"), value, Operand_int(0));
+
+	// Add negative sign if needed
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_int_end"), negative, Operand_bool(false));
+	String_set(&string, "-");
+	Instruction_emit(OPCODE_CONCAT, 3, result, Operand_string(&string), result);
+
+	Instruction_label("stringify_int_end");
+	Instruction_popframe();
+	Instruction_return();
+
+	String_destructor(&string);
+
+	NEWLINE
+}
+
+void __Codegen_generateStringifyDouble() {
+	COMMENT("[Builtin] stringify(double)")
+	Instruction_label("stringify_double");
+
+	// Overhead
+	Instruction_pushframe();
+	Instruction_defvar("STRINGIFY_INTEGER", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_FRACTION", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_DIVISOR", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_QUOTIENT", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_DIGIT", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_DIGITS", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_TRIMMED", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_POSITION", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_NEGATIVE", FRAME_LOCAL);
+	Instruction_defvar("STRINGIFY_CONDITION", FRAME_LOCAL);
+
+	Operand value = Operand_variable(FRAME_LOCAL, "ARG1_STRINGIFY");
+	Operand result = Operand_variable(FRAME_LOCAL, "RETVAL_STRINGIFY");
+	Operand integer = Operand_variable(FRAME_LOCAL, "STRINGIFY_INTEGER");
+	Operand fraction = Operand_variable(FRAME_LOCAL, "STRINGIFY_FRACTION");
+	Operand divisor = Operand_variable(FRAME_LOCAL, "STRINGIFY_DIVISOR");
+	Operand quotient = Operand_variable(FRAME_LOCAL, "STRINGIFY_QUOTIENT");
+	Operand digit = Operand_variable(FRAME_LOCAL, "STRINGIFY_DIGIT");
+	Operand digits = Operand_variable(FRAME_LOCAL, "STRINGIFY_DIGITS");
+	Operand trimmed = Operand_variable(FRAME_LOCAL, "STRINGIFY_TRIMMED");
+	Operand position = Operand_variable(FRAME_LOCAL, "STRINGIFY_POSITION");
+	Operand negative = Operand_variable(FRAME_LOCAL, "STRINGIFY_NEGATIVE");
+	Operand condition = Operand_variable(FRAME_LOCAL, "STRINGIFY_CONDITION");
+
+	// Zero is converted without the fractional part
+	String string;
+	String_constructor(&string, "0");
+	Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_end"), value, Operand_float(0));
+
+	String_set(&string, "");
+	Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+	Instruction_emit(OPCODE_MOVE, 2, digits, Operand_string(&string));
+	Instruction_emit(OPCODE_MOVE, 2, trimmed, Operand_string(&string));
+
+	// Digits are extracted from the absolute value
+	Instruction_emit(OPCODE_LT, 3, negative, value, Operand_float(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_parts"), negative, Operand_bool(false));
+	Instruction_emit(OPCODE_SUB, 3, value, Operand_float(0), value);
+
+	Instruction_label("stringify_double_parts");
+	Instruction_emit(OPCODE_FLOAT2INT, 2, integer, value);
+	Instruction_emit(OPCODE_INT2FLOAT, 2, integer, integer);
+	Instruction_emit(OPCODE_SUB, 3, fraction, value, integer);
+
+	// Find the divisor of the most significant digit of the integer part
+	Instruction_emit(OPCODE_MOVE, 2, divisor, Operand_float(1));
+	Instruction_label("stringify_double_divisor");
+	Instruction_emit(OPCODE_DIV, 3, quotient, integer, divisor);
+	Instruction_emit(OPCODE_LT, 3, condition, quotient, Operand_float(10));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_integer"), condition, Operand_bool(true));
+	Instruction_emit(OPCODE_MUL, 3, divisor, divisor, Operand_float(10));
+	Instruction_jump("stringify_double_divisor");
+
+	// Extract digits of the integer part, the remainder is computed the same way as the digit
+	Instruction_label("stringify_double_integer");
+	Instruction_emit(OPCODE_LT, 3, condition, divisor, Operand_float(1));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_fraction"), condition, Operand_bool(true));
+	Instruction_emit(OPCODE_DIV, 3, quotient, integer, divisor);
+	Instruction_emit(OPCODE_FLOAT2INT, 2, digit, quotient);
+	Instruction_emit(OPCODE_INT2FLOAT, 2, quotient, digit);
+	Instruction_emit(OPCODE_MUL, 3, quotient, quotient, divisor);
+	Instruction_emit(OPCODE_SUB, 3, integer, integer, quotient);
+	Instruction_emit(OPCODE_FLOAT2INT, 2, integer, integer);
+	Instruction_emit(OPCODE_INT2FLOAT, 2, integer, integer);
+	Instruction_emit(OPCODE_ADD, 3, digit, digit, Operand_int('0'));
+	Instruction_emit(OPCODE_INT2CHAR, 2, digit, digit);
+	Instruction_emit(OPCODE_CONCAT, 3, result, result, digit);
+	Instruction_emit(OPCODE_DIV, 3, divisor, divisor, Operand_float(10));
+	Instruction_jump("stringify_double_integer");
+
+	// Whole numbers get a zero fractional part
+	Instruction_label("stringify_double_fraction");
+	Instruction_emit(OPCODE_GT, 3, condition, fraction, Operand_float(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_digits"), condition, Operand_bool(true));
+	String_set(&string, ".0");
+	Instruction_emit(OPCODE_CONCAT, 3, result, result, Operand_string(&string));
+	Instruction_jump("stringify_double_sign");
+
+	// Extract at most 15 digits of the fractional part, the trailing zeros are not kept
+	Instruction_label("stringify_double_digits");
+	Instruction_emit(OPCODE_MOVE, 2, position, Operand_int(0));
+	Instruction_label("stringify_double_loop");
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_point"), position, Operand_int(15));
+	Instruction_emit(OPCODE_GT, 3, condition, fraction, Operand_float(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_point"), condition, Operand_bool(false));
+	Instruction_emit(OPCODE_MUL, 3, fraction, fraction, Operand_float(10));
+	Instruction_emit(OPCODE_FLOAT2INT, 2, digit, fraction);
+	Instruction_emit(OPCODE_INT2FLOAT, 2, quotient, digit);
+	Instruction_emit(OPCODE_SUB, 3, fraction, fraction, quotient);
+	Instruction_emit(OPCODE_ADD, 3, position, position, Operand_int(1));
+	Instruction_emit(OPCODE_ADD, 3, digit, digit, Operand_int('0'));
+	Instruction_emit(OPCODE_INT2CHAR, 2, digit, digit);
+	Instruction_emit(OPCODE_CONCAT, 3, digits, digits, digit);
+
+	String_set(&string, "0");
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_loop"), digit, Operand_string(&string));
+	Instruction_emit(OPCODE_MOVE, 2, trimmed, digits);
+	Instruction_jump("stringify_double_loop");
+
+	Instruction_label("stringify_double_point");
+	String_set(&string, ".");
+	Instruction_emit(OPCODE_CONCAT, 3, result, result, Operand_string(&string));
+	Instruction_emit(OPCODE_CONCAT, 3, result, result, trimmed);
+
+	// Add negative sign if needed
+	Instruction_label("stringify_double_sign");
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label("stringify_double_end"), negative, Operand_bool(false));
+	String_set(&string, "-");
+	Instruction_emit(OPCODE_CONCAT, 3, result, Operand_string(&string), result);
+
+	Instruction_label("stringify_double_end");
+	Instruction_popframe();
+	Instruction_return();
+
+	String_destructor(&string);
+
+	NEWLINE
+}
+
 void __Codegen_generateCoalescing() {
 	COMMENT("[Builtin] coalescing(a, b)")
 	Instruction_label("coalescing");
@@ -351,7 +604,7 @@ void __Codegen_generateCoalescing() {
 }
 
 void __Codegen_generateGlobalVariablesDeclarations(Codegen *codegen) {
-	Array *variables = HashMap_values(codegen->analyser->variables);
+	Array *variables = codegen->analyser->variables;
 
 	for(size_t i = 0; i < variables->size; i++) {
 		VariableDeclaration *declaration = (VariableDeclaration*)Array_get(variables, i);
@@ -362,7 +615,7 @@ void __Codegen_generateGlobalVariablesDeclarations(Codegen *codegen) {
 void __Codegen_generateUserFunctions(Codegen *codegen) {
 	COMMENT("--- [User-defined functions] ---")
 
-	Array *functions = HashMap_values(codegen->analyser->functions);
+	Array *functions = codegen->analyser->functions;
 
 	for(size_t i = 0; i < functions->size; i++) {
 		FunctionDeclaration *function = (FunctionDeclaration*)Array_get(functions, i);
@@ -371,10 +624,16 @@ void __Codegen_generateUserFunctions(Codegen *codegen) {
 }
 
 void __Codegen_generateFunctionDeclaration(Codegen *codegen, FunctionDeclaration *functionDeclaration) {
-	if(!is_func_generable(functionDeclaration->node->builtin)) {
+	// Functions not reachable from the main body are not generated at all
+	if(!is_func_generable(functionDeclaration->node->builtin) || !functionDeclaration->isUsed) {
 		return;
 	}
 
+	// The function is generated separately, its local variables are allocated once it is complete
+	InstructionList function;
+	InstructionList_constructor(&function);
+	InstructionList_select(&function);
+
 	COMMENT_FUNC(functionDeclaration->node)
 	codegen->frame = FRAME_LOCAL;
 	Instruction_label_func(functionDeclaration->id);
@@ -382,19 +641,111 @@ void __Codegen_generateFunctionDeclaration(Codegen *codegen, FunctionDeclaration
 	// Overhead
 	Instruction_pushframe();
 
-	Array *variables = HashMap_values(functionDeclaration->variables);
+	Array *variables = functionDeclaration->variables;
 	for(size_t i = 0; i < variables->size; i++) {
 		VariableDeclaration *declaration = (VariableDeclaration*)Array_get(variables, i);
 		__Codegen_generateVariableDeclaration(codegen, declaration);
 	}
 
+	// Temporary variables are declared here once the body is generated
+	InstructionList body;
+	__Codegen_beginTemporaries(codegen, &body);
+
+	// Self-recursive calls in the tail position continue here with the same frame
+	if(functionDeclaration->isTailRecursive) {
+		Instruction_label_id("func_body", functionDeclaration->id);
+	}
+
 	// Process body
 	__Codegen_evaluateBlock(codegen, functionDeclaration->node->body);
+	__Codegen_declareTemporaries(codegen, &function, &body);
 
 	// Implicit return
 	Instruction_return();
 	codegen->frame = FRAME_GLOBAL;
 	NEWLINE
+
+	FrameAllocator_allocate(&codegen->allocator, &function);
+
+	if(functionDeclaration->isLeaf) {
+		__Codegen_convertLeafFunction(codegen, functionDeclaration, &function);
+	}
+
+	InstructionList_select(&codegen->instructions);
+	InstructionList_append(&codegen->instructions, &function);
+	InstructionList_destructor(&function);
+}
+
+void __Codegen_convertLeafFunction(Codegen *codegen, FunctionDeclaration *functionDeclaration, InstructionList *function) {
+	// Leaf function is never active twice at the same time, so its variables can be global
+	InstructionList_select(&codegen->leafVariables);
+
+	Array *parameters = functionDeclaration->node->parameterList->parameters;
+	for(size_t i = 0; i < parameters->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		Instruction_defvar_id(parameter->internalId->id, FRAME_GLOBAL);
+	}
+
+	if(functionDeclaration->returnType.type != TYPE_VOID) {
+		Instruction_defretvar(functionDeclaration->id, FRAME_GLOBAL);
+	}
+
+	Array *instructions = function->instructions;
+	size_t count = 0;
+
+	for(size_t i = 0; i < instructions->size; i++) {
+		Instruction *instruction = Array_get(instructions, i);
+
+		// The caller does not create any frame for the function
+		if(instruction->opcode == OPCODE_PUSHFRAME || instruction->opcode == OPCODE_POPFRAME) continue;
+
+		bool isDeclaration = instruction->opcode == OPCODE_DEFVAR && instruction->operands[0].frame == FRAME_LOCAL;
+
+		for(int k = 0; k < INSTRUCTION_MAX_OPERANDS; k++) {
+			Operand *operand = &instruction->operands[k];
+			if(operand->type != OPERAND_VARIABLE || operand->frame != FRAME_LOCAL) continue;
+
+			// Leaf functions never call each other, all of them share the same temporary variables
+			if(operand->name && strcmp(operand->name, "tmp") == 0) operand->name = "leaf_tmp";
+			operand->frame = FRAME_GLOBAL;
+		}
+
+		if(!isDeclaration) {
+			Array_set(instructions, count++, instruction);
+			continue;
+		}
+
+		Operand *variable = &instruction->operands[0];
+
+		if(variable->name && strcmp(variable->name, "leaf_tmp") == 0) {
+			if(variable->id + 1 > codegen->leafTemporaries) codegen->leafTemporaries = variable->id + 1;
+		} else {
+			Array_push(codegen->leafVariables.instructions, instruction);
+		}
+
+		// The comment and the blank line around the declaration are removed with it
+		Instruction *previous = count > 0 ? Array_get(instructions, count - 1) : NULL;
+		Instruction *next = i + 1 < instructions->size ? Array_get(instructions, i + 1) : NULL;
+
+		if(previous && previous->opcode == OPCODE_COMMENT) count--;
+		if(next && next->opcode == OPCODE_NEWLINE) i++;
+	}
+
+	instructions->size = count;
+}
+
+void __Codegen_generateLeafVariables(Codegen *codegen) {
+	if(codegen->leafVariables.instructions->size == 0 && codegen->leafTemporaries == 0) return;
+
+	COMMENT("--- [Leaf function variables] ---")
+
+	InstructionList_append(&codegen->instructions, &codegen->leafVariables);
+
+	for(size_t i = 0; i < codegen->leafTemporaries; i++) {
+		Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_named_id(FRAME_GLOBAL, "leaf_tmp", i));
+	}
+
+	NEWLINE
 }
 
 void __Codegen_generateVariableDeclaration(Codegen *codegen, VariableDeclaration *variable) {
@@ -411,7 +762,14 @@ void __Codegen_generateMain(Codegen *codegen) {
 void __Codegen_evaluateReturnStatement(Codegen *codegen, ReturnStatementASTNode *returnStatement) {
 	FunctionDeclaration *functionDeclaration = Analyser_getFunctionById(codegen->analyser, returnStatement->id);
 
-	if(returnStatement->expression != NULL) {
+	if(returnStatement->isTailCall) {
+		__Codegen_evaluateTailCall(codegen, (FunctionCallASTNode*)returnStatement->expression);
+		return;
+	}
+
+	if(returnStatement->expression != NULL && codegen->lowering == LOWERING_THREE_ADDRESS && functionDeclaration->returnType.type != TYPE_VOID) {
+		__Codegen_lowerAssignment(codegen, returnStatement->expression, Operand_variable_named_id(codegen->frame, "ret", returnStatement->id));
+	} else if(returnStatement->expression != NULL) {
 		__Codegen_evaluateExpression(codegen, returnStatement->expression);
 
 		if(functionDeclaration->returnType.type != TYPE_VOID) {
@@ -480,40 +838,51 @@ void __Codegen_evaluateBindingCondition(Codegen *codegen, OptionalBindingConditi
 }
 
 void __Codegen_evaluateIfStatement(Codegen *codegen, IfStatementASTNode *ifStatement) {
-	COMMENT_IF(ifStatement->id)
-	if(ifStatement->test->_type == NODE_OPTIONAL_BINDING_CONDITION) {
-		OptionalBindingConditionASTNode *optionalBindingCondition = (OptionalBindingConditionASTNode*)ifStatement->test;
-		__Codegen_evaluateBindingCondition(codegen, optionalBindingCondition);
-	} else {
-		__Codegen_evaluateExpression(codegen, ifStatement->test);
-	}
+	// Else-if chain is generated iteratively, the end labels are emitted in reverse order afterwards
+	Array /*<IfStatementASTNode>*/ *chain = Array_alloc(0);
+
+	while(ifStatement != NULL) {
+		Array_push(chain, ifStatement);
+
+		COMMENT_IF(ifStatement->id)
+		if(ifStatement->test->_type == NODE_OPTIONAL_BINDING_CONDITION) {
+			OptionalBindingConditionASTNode *optionalBindingCondition = (OptionalBindingConditionASTNode*)ifStatement->test;
+			__Codegen_evaluateBindingCondition(codegen, optionalBindingCondition);
+			Instruction_pushs_bool(true);
+			Instruction_jump_ifneqs_id("if_else", ifStatement->id);
+		} else {
+			__Codegen_evaluateCondition(codegen, ifStatement->test, false, "if_else", ifStatement->id);
+		}
 
-	Instruction_pushs_bool(true);
-	Instruction_jump_ifneqs_id("if_else", ifStatement->id);
+		// Process body
+		COMMENT_IF_BLOCK(ifStatement->id)
+		__Codegen_evaluateBlock(codegen, ifStatement->body);
+		Instruction_jump_id("if_end", ifStatement->id);
 
-	// Process body
-	COMMENT_IF_BLOCK(ifStatement->id)
-	__Codegen_evaluateBlock(codegen, ifStatement->body);
-	Instruction_jump_id("if_end", ifStatement->id);
+		// Process else
+		Instruction_label_id("if_else", ifStatement->id);
+		if(ifStatement->alternate == NULL) break;
 
-	// Process else
-	Instruction_label_id("if_else", ifStatement->id);
-	if(ifStatement->alternate != NULL) {
 		COMMENT_ELSE_BLOCK(ifStatement->id)
 		switch(ifStatement->alternate->_type) {
 			case NODE_BLOCK:
 				__Codegen_evaluateBlock(codegen, (BlockASTNode*)ifStatement->alternate);
+				ifStatement = NULL;
 				break;
 			case NODE_IF_STATEMENT:
-				__Codegen_evaluateIfStatement(codegen, (IfStatementASTNode*)ifStatement->alternate);
+				ifStatement = (IfStatementASTNode*)ifStatement->alternate;
 				break;
 			default:
 				fassertf("[Codegen] Unexpected ASTNode type (evaluateIfStatement).");
 		}
+	}
 
+	while(chain->size > 0) {
+		IfStatementASTNode *current = Array_pop(chain);
+		Instruction_label_id("if_end", current->id);
 	}
 
-	Instruction_label_id("if_end", ifStatement->id);
+	Array_free(chain);
 }
 
 void __Codegen_evaluateWhileStatement(Codegen *codegen, WhileStatementASTNode *whileStatement) {
@@ -526,13 +895,12 @@ void __Codegen_evaluateWhileStatement(Codegen *codegen, WhileStatementASTNode *w
 	if(whileStatement->test->_type == NODE_OPTIONAL_BINDING_CONDITION) {
 		OptionalBindingConditionASTNode *optionalBindingCondition = (OptionalBindingConditionASTNode*)whileStatement->test;
 		__Codegen_evaluateBindingCondition(codegen, optionalBindingCondition);
+		Instruction_pushs_bool(true);
+		Instruction_jump_ifneqs_id("loop_end", whileStatement->id);
 	} else {
-		__Codegen_evaluateExpression(codegen, whileStatement->test);
+		__Codegen_evaluateCondition(codegen, whileStatement->test, false, "loop_end", whileStatement->id);
 	}
 
-	Instruction_pushs_bool(true);
-	Instruction_jump_ifneqs_id("loop_end", whileStatement->id);
-
 	// Process body
 	__Codegen_evaluateBlock(codegen, whileStatement->body);
 
@@ -543,13 +911,75 @@ void __Codegen_evaluateWhileStatement(Codegen *codegen, WhileStatementASTNode *w
 	Instruction_label_id("loop_end", whileStatement->id);
 }
 
+void __Codegen_evaluateCondition(Codegen *codegen, ExpressionASTNode *test, bool isJumpIfTrue, char *label, size_t id) {
+	// Continue on a new stack segment, long chains of the logical operators would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		CodegenCall call = {.codegen = codegen, .node = (ASTNode*)test, .label = label, .labelId = id, .isJumpIfTrue = isJumpIfTrue};
+		CallStack_extend(__Codegen_evaluateCondition_extended, &call);
+		return;
+	}
+
+	if(test->_type == NODE_UNARY_EXPRESSION && ((UnaryExpressionASTNode*)test)->operator == OPERATOR_NOT) {
+		__Codegen_evaluateCondition(codegen, ((UnaryExpressionASTNode*)test)->argument, !isJumpIfTrue, label, id);
+		return;
+	}
+
+	BinaryExpressionASTNode *binaryExpression = (BinaryExpressionASTNode*)test;
+	enum OperatorType operator = test->_type == NODE_BINARY_EXPRESSION ? binaryExpression->operator : OPERATOR_DEFAULT;
+
+	if(operator == OPERATOR_AND || operator == OPERATOR_OR) {
+		// The right operand is evaluated only if the left one does not decide the result
+		if(isJumpIfTrue == (operator == OPERATOR_OR)) {
+			__Codegen_evaluateCondition(codegen, binaryExpression->left, isJumpIfTrue, label, id);
+			__Codegen_evaluateCondition(codegen, binaryExpression->right, isJumpIfTrue, label, id);
+		} else {
+			size_t skipId = codegen->labels++;
+			__Codegen_evaluateCondition(codegen, binaryExpression->left, !isJumpIfTrue, "condition_skip", skipId);
+			__Codegen_evaluateCondition(codegen, binaryExpression->right, isJumpIfTrue, label, id);
+			Instruction_label_id("condition_skip", skipId);
+		}
+		return;
+	}
+
+	if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+		__Codegen_lowerCondition(codegen, test, isJumpIfTrue, label, id);
+		return;
+	}
+
+	__Codegen_evaluateExpression(codegen, test);
+	Instruction_pushs_bool(true);
+
+	if(isJumpIfTrue) {
+		Instruction_jump_ifeqs_id(label, id);
+	} else {
+		Instruction_jump_ifneqs_id(label, id);
+	}
+}
+
+void __Codegen_evaluateShortCircuit(Codegen *codegen, BinaryExpressionASTNode *expression) {
+	size_t id = codegen->labels++;
+
+	__Codegen_evaluateCondition(codegen, (ExpressionASTNode*)expression, false, "condition_false", id);
+	Instruction_pushs_bool(true);
+	Instruction_jump_id("condition_end", id);
+
+	Instruction_label_id("condition_false", id);
+	Instruction_pushs_bool(false);
+	Instruction_label_id("condition_end", id);
+}
+
 void __Codegen_evaluateBinaryExpression(Codegen *codegen, BinaryExpressionASTNode *binaryExpression) {
+	if(binaryExpression->operator == OPERATOR_AND || binaryExpression->operator == OPERATOR_OR) {
+		__Codegen_evaluateShortCircuit(codegen, binaryExpression);
+		return;
+	}
+
 	__Codegen_evaluateExpression(codegen, binaryExpression->left);
 	__Codegen_evaluateExpression(codegen, binaryExpression->right);
-	__Codegen_evaluateBinaryOperator(binaryExpression);
+	__Codegen_evaluateBinaryOperator(codegen, binaryExpression);
 }
 
-void __Codegen_evaluateBinaryOperator(BinaryExpressionASTNode *expression) {
+void __Codegen_evaluateBinaryOperator(Codegen *codegen, BinaryExpressionASTNode *expression) {
 	switch(expression->operator) {
 		case OPERATOR_PLUS: {
 			if(expression->type.type == TYPE_STRING) {
@@ -593,10 +1023,6 @@ void __Codegen_evaluateBinaryOperator(BinaryExpressionASTNode *expression) {
 			return;
 		case OPERATOR_NOT:
 			return Instruction_nots();
-		case OPERATOR_OR:
-			return Instruction_ors();
-		case OPERATOR_AND:
-			return Instruction_ands();
 		case OPERATOR_NULL_COALESCING: {
 			Instruction_createframe();
 			Instruction_defvar("ARG_RIGHT_COA", FRAME_TEMPORARY);
@@ -606,9 +1032,13 @@ void __Codegen_evaluateBinaryOperator(BinaryExpressionASTNode *expression) {
 			Instruction_pops("ARG_LEFT_COA", FRAME_TEMPORARY);
 
 			Instruction_call("coalescing");
+			codegen->usedRoutines[ROUTINE_COALESCING] = true;
 			Instruction_pushs("RETVAL_COA", FRAME_TEMPORARY);
 			return;
 		}
+		case OPERATOR_OR:
+		case OPERATOR_AND:
+			// Evaluated by the jumps (evaluateShortCircuit)
 		case OPERATOR_UNWRAP:
 		case OPERATOR_DEFAULT:
 		case OPERATOR_RANGE:
@@ -654,6 +1084,13 @@ void __Codegen_evaluateVariableDeclarator(Codegen *codegen, VariableDeclaratorAS
 	if(variableDeclarator->initializer == NULL) {
 		return;
 	}
+	if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+		Operand variable = __Codegen_getVariableOperand(codegen, variableDeclarator->pattern->id->id);
+		__Codegen_lowerAssignment(codegen, variableDeclarator->initializer, variable);
+		NEWLINE
+		return;
+	}
+
 	__Codegen_evaluateExpression(codegen, variableDeclarator->initializer);
 	if(Analyser_isDeclarationGlobal(codegen->analyser, variableDeclarator->pattern->id->id)) {
 		Instruction_pops_id(variableDeclarator->pattern->id->id, FRAME_GLOBAL);
@@ -664,6 +1101,12 @@ void __Codegen_evaluateVariableDeclarator(Codegen *codegen, VariableDeclaratorAS
 }
 
 void __Codegen_stackAssignment(Codegen *codegen, AssignmentStatementASTNode *assignmentStatement, bool isGlobalVariable) {
+	if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+		Operand variable = Operand_variable_id(isGlobalVariable ? FRAME_GLOBAL : codegen->frame, assignmentStatement->id->id);
+		__Codegen_lowerAssignment(codegen, assignmentStatement->expression, variable);
+		return;
+	}
+
 	__Codegen_evaluateExpression(codegen, assignmentStatement->expression);
 
 	if(isGlobalVariable) {
@@ -711,10 +1154,30 @@ void __Codegen_evaluateAssignmentStatement(Codegen *codegen, AssignmentStatement
 
 void __Codegen_evaluateExpressionStatement(Codegen *codegen, ExpressionStatementASTNode *expressionStatement) {
 	__Codegen_evaluateExpression(codegen, expressionStatement->expression);
-	Instruction_clears();
+
+	// Only the unused result is dropped, a function may be called while its caller has values on the stack
+	if(__Codegen_getExpressionType(codegen, expressionStatement->expression).type != TYPE_VOID) {
+		Instruction_pops("DISCARD_TMP", FRAME_GLOBAL);
+	}
 }
 
 void __Codegen_evaluateExpression(Codegen *codegen, ExpressionASTNode *expression) {
+	// Continue on a new stack segment, deeply nested expressions would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		CodegenCall call = {.codegen = codegen, .node = (ASTNode*)expression};
+		CallStack_extend(__Codegen_evaluateExpression_extended, &call);
+		return;
+	}
+
+	// The stack is used only where the value is consumed from it (arguments, operands of the stack-only operations)
+	if(codegen->lowering == LOWERING_THREE_ADDRESS && __Codegen_isLowerable(codegen, expression)) {
+		size_t temporaries = codegen->temporaries;
+		Operand result = __Codegen_lowerExpression(codegen, expression, NULL);
+		Instruction_emit(OPCODE_PUSHS, 1, result);
+		codegen->temporaries = temporaries;
+		return;
+	}
+
 	switch(expression->_type) {
 		case NODE_LITERAL_EXPRESSION: {
 			LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)expression;
@@ -733,6 +1196,8 @@ void __Codegen_evaluateExpression(Codegen *codegen, ExpressionASTNode *expressio
 			enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, functionCall->id->id);
 			if(is_func_builtin(builtin)) {
 				__Codegen_resolveBuiltInFunction(codegen, functionCall, builtin);
+			} else if(is_func_internal(builtin)) {
+				__Codegen_callStringify(codegen, functionCall, builtin);
 			} else {
 				__Codegen_evaluateFunctionCall(codegen, functionCall);
 			}
@@ -753,20 +1218,19 @@ void __Codegen_evaluateExpression(Codegen *codegen, ExpressionASTNode *expressio
 			InterpolationExpressionASTNode *interpolation = (InterpolationExpressionASTNode*)expression;
 			__Codegen_evaluateBinaryExpression(codegen, interpolation->concatenated);
 		} break;
-		case FUNCTION_INTERNAL_STRINGIFY_NUMBER:
-		case FUNCTION_INTERNAL_STRINGIFY_DOUBLE:
-		case FUNCTION_INTERNAL_STRINGIFY_INT:
-		case FUNCTION_INTERNAL_STRINGIFY_BOOL:
-		case FUNCTION_INTERNAL_STRINGIFY_STRING:
-		case FUNCTION_INTERNAL_MODULO:
-			// Internal functions are handled as user defined functions
-			break;
 		default:
 			fassertf("Unexpected ASTNode type. Analyser probably failed.");
 	}
 }
 
 void __Codegen_evaluateBlock(Codegen *codegen, BlockASTNode *block) {
+	// Continue on a new stack segment, deeply nested blocks would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		CodegenCall call = {.codegen = codegen, .node = (ASTNode*)block};
+		CallStack_extend(__Codegen_evaluateBlock_extended, &call);
+		return;
+	}
+
 	Array *statements = block->statements;
 
 	for(size_t i = 0; i < statements->size; ++i) {
@@ -822,6 +1286,12 @@ void __Codegen_callWrite(Codegen *codegen, FunctionCallASTNode *functionCall) {
 
 	for(size_t i = 0; i < arguments->size; ++i) {
 		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+			__Codegen_lowerWrite(codegen, argument->expression);
+			continue;
+		}
+
 		__Codegen_evaluateExpression(codegen, argument->expression);
 
 		Instruction_pops("WRITE_TMP", FRAME_GLOBAL);
@@ -829,6 +1299,67 @@ void __Codegen_callWrite(Codegen *codegen, FunctionCallASTNode *functionCall) {
 	}
 }
 
+void __Codegen_callStringify(Codegen *codegen, FunctionCallASTNode *functionCall, enum BuiltInFunction builtin) {
+	Array *arguments = functionCall->argumentList->arguments;
+	ArgumentASTNode *argument = Array_get(arguments, 0);
+
+	__Codegen_evaluateExpression(codegen, argument->expression);
+
+	// Overhead to call stringify
+	Instruction_createframe();
+	Instruction_defvar("ARG1_STRINGIFY", FRAME_TEMPORARY);
+	Instruction_pops("ARG1_STRINGIFY", FRAME_TEMPORARY);
+
+	__Codegen_convertStringify(codegen, builtin, __Codegen_getExpressionType(codegen, argument->expression));
+
+	// Handle return value
+	Instruction_pushs("RETVAL_STRINGIFY", FRAME_TEMPORARY);
+}
+
+void __Codegen_convertStringify(Codegen *codegen, enum BuiltInFunction builtin, ValueType type) {
+	Operand value = Operand_variable(FRAME_TEMPORARY, "ARG1_STRINGIFY");
+	Operand result = Operand_variable(FRAME_TEMPORARY, "RETVAL_STRINGIFY");
+	size_t id = codegen->labels++;
+
+	Instruction_defvar("RETVAL_STRINGIFY", FRAME_TEMPORARY);
+
+	String string;
+	String_constructor(&string, "nil");
+
+	// Values of a non-nullable type are converted without the check
+	if(type.isNullable || type.type == TYPE_NIL || type.type == TYPE_INVALID) {
+		Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+		Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("stringify_end", id), value, Operand_nil());
+	}
+
+	switch(builtin) {
+		case FUNCTION_INTERNAL_STRINGIFY_DOUBLE:
+			Instruction_call("stringify_double");
+			codegen->usedRoutines[ROUTINE_STRINGIFY_DOUBLE] = true;
+			break;
+		case FUNCTION_INTERNAL_STRINGIFY_INT:
+			Instruction_call("stringify_int");
+			codegen->usedRoutines[ROUTINE_STRINGIFY_INT] = true;
+			break;
+		case FUNCTION_INTERNAL_STRINGIFY_BOOL:
+			String_set(&string, "true");
+			Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+			Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("stringify_end", id), value, Operand_bool(true));
+			String_set(&string, "false");
+			Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(&string));
+			break;
+		case FUNCTION_INTERNAL_STRINGIFY_STRING:
+			Instruction_emit(OPCODE_MOVE, 2, result, value);
+			break;
+		default:
+			fassertf("[Codegen] Unexpected internal function (convertStringify).");
+	}
+
+	Instruction_label_id("stringify_end", id);
+
+	String_destructor(&string);
+}
+
 void __Codegen_callIntToDouble(Codegen *codegen, FunctionCallASTNode *functionCall) {
 	Array *arguments = functionCall->argumentList->arguments;
 	ArgumentASTNode *argument = Array_get(arguments, 0);
@@ -858,6 +1389,7 @@ void __Codegen_callLength(Codegen *codegen, FunctionCallASTNode *functionCall) {
 
 	// Call function
 	Instruction_call("length");
+	codegen->usedRoutines[ROUTINE_LENGTH] = true;
 
 	// Handle return value
 	Instruction_pushs("RETVAL_LEN", FRAME_TEMPORARY);
@@ -885,6 +1417,7 @@ void __Codegen_callSubstring(Codegen *codegen, FunctionCallASTNode *functionCall
 
 	// Call function
 	Instruction_call("substr");
+	codegen->usedRoutines[ROUTINE_SUBSTRING] = true;
 
 	// Handle return value
 	Instruction_pushs("RETVAL_SUBSTR", FRAME_TEMPORARY);
@@ -902,6 +1435,7 @@ void __Codegen_callOrd(Codegen *codegen, FunctionCallASTNode *functionCall) {
 
 	// Call function
 	Instruction_call("ord");
+	codegen->usedRoutines[ROUTINE_ORD] = true;
 
 	// Handle return value
 	Instruction_pushs("RETVAL_ORD", FRAME_TEMPORARY);
@@ -920,6 +1454,7 @@ void __Codegen_callChr(Codegen *codegen, FunctionCallASTNode *functionCall) {
 
 	// Call function
 	Instruction_call("chr");
+	codegen->usedRoutines[ROUTINE_CHR] = true;
 
 	// Handle return value
 	Instruction_pushs("RETVAL_CHR", FRAME_TEMPORARY);
@@ -938,6 +1473,22 @@ void __Codegen_evaluateFunctionCall(Codegen *codegen, FunctionCallASTNode *funct
 		__Codegen_evaluateExpression(codegen, argument->expression);
 	}
 
+	// Leaf functions take the arguments and leave the result in the global frame
+	if(functionDeclaration->isLeaf) {
+		for(int i = arguments->size - 1; i > -1; --i) {
+			ParameterASTNode *parameter = Array_get(parameters, i);
+			Instruction_pops_id(parameter->internalId->id, FRAME_GLOBAL);
+		}
+
+		Instruction_call_func(functionCall->id->id);
+
+		if(functionDeclaration->returnType.type != TYPE_VOID) {
+			Instruction_emit(OPCODE_PUSHS, 1, Operand_variable_named_id(FRAME_GLOBAL, "ret", functionCall->id->id));
+		}
+
+		return;
+	}
+
 	Instruction_createframe();
 
 	for(int i = arguments->size - 1; i > -1; --i) {
@@ -959,6 +1510,29 @@ void __Codegen_evaluateFunctionCall(Codegen *codegen, FunctionCallASTNode *funct
 	}
 }
 
+void __Codegen_evaluateTailCall(Codegen *codegen, FunctionCallASTNode *functionCall) {
+	Array *arguments = functionCall->argumentList->arguments;
+
+	FunctionDeclaration *functionDeclaration = Analyser_getFunctionById(codegen->analyser, functionCall->id->id);
+	assertf(functionDeclaration != NULL, "Could not find function declaration with id %ld", functionCall->id->id);
+	Array *parameters = functionDeclaration->node->parameterList->parameters;
+
+	// Arguments may read the parameters, all of them are evaluated before the first one is overwritten
+	for(size_t i = 0; i < arguments->size; ++i) {
+		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		__Codegen_evaluateExpression(codegen, argument->expression);
+	}
+
+	for(int i = arguments->size - 1; i > -1; --i) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		Instruction_pops_id(parameter->internalId->id, FRAME_LOCAL);
+	}
+
+	// Result of the call is the result of the current one, so the frame is reused instead of a new one
+	Instruction_jump_id("func_body", functionDeclaration->id);
+}
+
 void __Codegen_evaluateForStatement(Codegen *codegen, ForStatementASTNode *forStatement) {
 	size_t loopId = forStatement->id;
 	size_t iteratorId = forStatement->iterator->id;
@@ -967,27 +1541,58 @@ void __Codegen_evaluateForStatement(Codegen *codegen, ForStatementASTNode *forSt
 
 	COMMENT_FOR(loopId)
 
-	// Initialize iterator
-	__Codegen_evaluateExpression(codegen, range->start);
-	Instruction_pops_id(iteratorId, currentFrame);
+	if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+		__Codegen_lowerAssignment(codegen, range->start, Operand_variable_id(currentFrame, iteratorId));
+		__Codegen_lowerAssignment(codegen, range->end, Operand_variable_id(currentFrame, range->endId));
+	} else {
+		// Initialize iterator
+		__Codegen_evaluateExpression(codegen, range->start);
+		Instruction_pops_id(iteratorId, currentFrame);
 
-	// Initialize end
-	__Codegen_evaluateExpression(codegen, range->end);
-	Instruction_pops_id(range->endId, currentFrame);
+		// Initialize end
+		__Codegen_evaluateExpression(codegen, range->end);
+		Instruction_pops_id(range->endId, currentFrame);
+	}
 
 	// Star with value - 1 because we increment at the beginning of the loop
 	Instruction_add_int_id(currentFrame, iteratorId, currentFrame, iteratorId, -1);
 
+	// Derived induction variables follow the iterator
+	Array *inductions = forStatement->inductions;
+
+	for(size_t i = 0; i < inductions->size; i++) {
+		InductionVariable *induction = Array_get(inductions, i);
+		Instruction_mul_int_id(currentFrame, induction->id, currentFrame, iteratorId, induction->scale);
+		if(induction->offset != 0) Instruction_add_int_id(currentFrame, induction->id, currentFrame, induction->id, induction->offset);
+	}
+
 	Instruction_label_id("loop_start", loopId);
 
 	Instruction_add_int_id(currentFrame, iteratorId, currentFrame, iteratorId, 1);
-	Instruction_pushs_id(range->endId, currentFrame);
-	Instruction_pushs_id(iteratorId, currentFrame);
 
-	__Codegen_evaluateRangeOperator(range->operator);
+	for(size_t i = 0; i < inductions->size; i++) {
+		InductionVariable *induction = Array_get(inductions, i);
+		Instruction_add_int_id(currentFrame, induction->id, currentFrame, induction->id, induction->scale);
+	}
+	if(codegen->lowering == LOWERING_THREE_ADDRESS) {
+		// The a...b loop ends when b < i, the a..<b loop when !(b > i)
+		Operand condition = __Codegen_allocateTemporary(codegen);
+		Operand end = Operand_variable_id(currentFrame, range->endId);
+		Operand iterator = Operand_variable_id(currentFrame, iteratorId);
+		bool isClosed = range->operator == OPERATOR_RANGE;
+
+		Instruction_emit(isClosed ? OPCODE_LT : OPCODE_GT, 3, condition, end, iterator);
+		Instruction_emit(isClosed ? OPCODE_JUMPIFEQ : OPCODE_JUMPIFNEQ, 3, Operand_label_id("loop_end", loopId), condition, Operand_bool(true));
+		codegen->temporaries--;
+	} else {
+		Instruction_pushs_id(range->endId, currentFrame);
+		Instruction_pushs_id(iteratorId, currentFrame);
+
+		__Codegen_evaluateRangeOperator(range->operator);
 
-	Instruction_pushs_bool(true);
-	Instruction_jump_ifeqs_id("loop_end", loopId);
+		Instruction_pushs_bool(true);
+		Instruction_jump_ifeqs_id("loop_end", loopId);
+	}
 
 	__Codegen_evaluateBlock(codegen, forStatement->body);
 	Instruction_jump_id("loop_start", loopId);
@@ -1017,4 +1622,812 @@ void __Codegen_evaluateContinueStatement(ContinueStatementASTNode *continueState
 	Instruction_jump_id("loop_start", continueStatement->id);
 }
 
+// --- THREE-ADDRESS LOWERING ---
+
+Operand __Codegen_lowerExpression(Codegen *codegen, ExpressionASTNode *expression, Operand *destination) {
+	// Continue on a new stack segment, deeply nested expressions would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		CodegenCall call = {.codegen = codegen, .node = (ASTNode*)expression, .destination = destination};
+		CallStack_extend(__Codegen_lowerExpression_extended, &call);
+		return call.result;
+	}
+
+	switch(expression->_type) {
+		case NODE_LITERAL_EXPRESSION: {
+			return __Codegen_getLiteralOperand((LiteralExpressionASTNode*)expression);
+		}
+		case NODE_IDENTIFIER: {
+			return __Codegen_getVariableOperand(codegen, ((IdentifierASTNode*)expression)->id);
+		}
+		case NODE_UNARY_EXPRESSION: {
+			UnaryExpressionASTNode *unaryExpression = (UnaryExpressionASTNode*)expression;
+
+			// Other unary operators do not change the value in the target code
+			if(unaryExpression->operator != OPERATOR_NOT) {
+				return __Codegen_lowerExpression(codegen, unaryExpression->argument, destination);
+			}
+
+			size_t temporaries = codegen->temporaries;
+			Operand argument = __Codegen_lowerExpression(codegen, unaryExpression->argument, NULL);
+			codegen->temporaries = temporaries;
+
+			Operand result = destination ? *destination : __Codegen_allocateTemporary(codegen);
+			Instruction_emit(OPCODE_NOT, 2, result, argument);
+			return result;
+		}
+		case NODE_BINARY_EXPRESSION: {
+			BinaryExpressionASTNode *binaryExpression = (BinaryExpressionASTNode*)expression;
+			if(binaryExpression->operator == OPERATOR_NULL_COALESCING) break;
+
+			return __Codegen_lowerBinaryExpression(codegen, binaryExpression, destination);
+		}
+		case NODE_INTERPOLATION_EXPRESSION: {
+			InterpolationExpressionASTNode *interpolation = (InterpolationExpressionASTNode*)expression;
+			return __Codegen_lowerConcatenation(codegen, (ExpressionASTNode*)interpolation->concatenated, destination);
+		}
+		case NODE_FUNCTION_CALL: {
+			FunctionCallASTNode *functionCall = (FunctionCallASTNode*)expression;
+			enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, functionCall->id->id);
+			if(!__Codegen_isInlineBuiltIn(builtin)) break;
+
+			return __Codegen_lowerBuiltInFunction(codegen, functionCall, builtin, destination);
+		}
+		default:
+			break;
+	}
+
+	// The rest is evaluated on the data stack
+	__Codegen_evaluateExpression(codegen, expression);
+
+	Operand result = destination ? *destination : __Codegen_allocateTemporary(codegen);
+	Instruction_emit(OPCODE_POPS, 1, result);
+	return result;
+}
+
+Operand __Codegen_lowerBinaryExpression(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *destination) {
+	if(expression->operator == OPERATOR_AND || expression->operator == OPERATOR_OR) {
+		return __Codegen_lowerShortCircuit(codegen, expression, destination);
+	}
+
+	if(expression->operator == OPERATOR_PLUS && expression->type.type == TYPE_STRING) {
+		return __Codegen_lowerConcatenation(codegen, (ExpressionASTNode*)expression, destination);
+	}
+
+	size_t temporaries = codegen->temporaries;
+
+	Operand left, right;
+	__Codegen_lowerOperands(codegen, expression, &left, &right);
+
+	// The operands are read before the result is written, the result can reuse their temporaries
+	codegen->temporaries = temporaries;
+	Operand result = destination ? *destination : __Codegen_allocateTemporary(codegen);
+
+	switch(expression->operator) {
+		case OPERATOR_PLUS:
+			Instruction_emit(OPCODE_ADD, 3, result, left, right);
+			break;
+		case OPERATOR_MINUS:
+			Instruction_emit(OPCODE_SUB, 3, result, left, right);
+			break;
+		case OPERATOR_MUL:
+			Instruction_emit(OPCODE_MUL, 3, result, left, right);
+			break;
+		case OPERATOR_DIV:
+			Instruction_emit(expression->type.type == TYPE_INT ? OPCODE_IDIV : OPCODE_DIV, 3, result, left, right);
+			break;
+		case OPERATOR_EQUAL:
+			Instruction_emit(OPCODE_EQ, 3, result, left, right);
+			break;
+		case OPERATOR_NOT_EQUAL:
+			Instruction_emit(OPCODE_EQ, 3, result, left, right);
+			Instruction_emit(OPCODE_NOT, 2, result, result);
+			break;
+		case OPERATOR_LESS:
+			Instruction_emit(OPCODE_LT, 3, result, left, right);
+			break;
+		case OPERATOR_GREATER:
+			Instruction_emit(OPCODE_GT, 3, result, left, right);
+			break;
+		case OPERATOR_LESS_EQUAL:
+			// Negation of > is <=
+			Instruction_emit(OPCODE_GT, 3, result, left, right);
+			Instruction_emit(OPCODE_NOT, 2, result, result);
+			break;
+		case OPERATOR_GREATER_EQUAL:
+			// Negation of < is >=
+			Instruction_emit(OPCODE_LT, 3, result, left, right);
+			Instruction_emit(OPCODE_NOT, 2, result, result);
+			break;
+		default:
+			fassertf("[Codegen] Unexpected operator type (lowerBinaryExpression).");
+	}
+
+	return result;
+}
+
+void __Codegen_lowerOperands(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *outLeft, Operand *outRight) {
+	*outLeft = __Codegen_lowerExpression(codegen, expression->left, NULL);
+
+	// Variable read by the left operand could be modified by a function called in the right one
+	if(outLeft->type == OPERAND_VARIABLE && __Codegen_hasCalls(codegen, expression->right)) {
+		Operand copy = __Codegen_allocateTemporary(codegen);
+		Instruction_emit(OPCODE_MOVE, 2, copy, *outLeft);
+		*outLeft = copy;
+	}
+
+	*outRight = __Codegen_lowerExpression(codegen, expression->right, NULL);
+}
+
+void __Codegen_lowerAssignment(Codegen *codegen, ExpressionASTNode *expression, Operand destination) {
+	size_t temporaries = codegen->temporaries;
+	Operand result = __Codegen_lowerExpression(codegen, expression, &destination);
+
+	if(!Operand_isSameVariable(&result, &destination)) {
+		Instruction_emit(OPCODE_MOVE, 2, destination, result);
+	}
+
+	codegen->temporaries = temporaries;
+}
+
+Operand __Codegen_lowerShortCircuit(Codegen *codegen, BinaryExpressionASTNode *expression, Operand *destination) {
+	size_t id = codegen->labels++;
+	size_t temporaries = codegen->temporaries;
+
+	// The result is written only once the condition is decided, the destination may be read by the operands
+	__Codegen_evaluateCondition(codegen, (ExpressionASTNode*)expression, false, "condition_false", id);
+
+	codegen->temporaries = temporaries;
+	Operand result = destination ? *destination : __Codegen_allocateTemporary(codegen);
+
+	Instruction_emit(OPCODE_MOVE, 2, result, Operand_bool(true));
+	Instruction_jump_id("condition_end", id);
+	Instruction_label_id("condition_false", id);
+	Instruction_emit(OPCODE_MOVE, 2, result, Operand_bool(false));
+	Instruction_label_id("condition_end", id);
+
+	return result;
+}
+
+Operand __Codegen_lowerBuiltInFunction(Codegen *codegen, FunctionCallASTNode *functionCall, enum BuiltInFunction builtin, Operand *destination) {
+	size_t temporaries = codegen->temporaries;
+
+	Operand arguments[CODEGEN_MAX_INLINE_ARGUMENTS];
+	__Codegen_lowerArguments(codegen, functionCall->argumentList->arguments, arguments);
+
+	// Substring builds the result in its own temporaries, its arguments are read until the end
+	if(builtin == FUNCTION_SUBSTRING) {
+		Operand result = __Codegen_lowerSubstring(codegen, arguments, destination);
+		if(!destination) return result;
+
+		codegen->temporaries = temporaries;
+		return *destination;
+	}
+
+	// The arguments are read before the result is written, the result can reuse their temporaries
+	codegen->temporaries = temporaries;
+	Operand result = destination ? *destination : __Codegen_allocateTemporary(codegen);
+
+	switch(builtin) {
+		case FUNCTION_INT_TO_DOUBLE:
+			Instruction_emit(OPCODE_INT2FLOAT, 2, result, arguments[0]);
+			break;
+		case FUNCTION_DOUBLE_TO_INT:
+			Instruction_emit(OPCODE_FLOAT2INT, 2, result, arguments[0]);
+			break;
+		case FUNCTION_LENGTH:
+			Instruction_emit(OPCODE_STRLEN, 2, result, arguments[0]);
+			break;
+		case FUNCTION_CHR:
+			Instruction_emit(OPCODE_INT2CHAR, 2, result, arguments[0]);
+			break;
+		case FUNCTION_ORD: {
+			// Ord of an empty string is zero
+			size_t id = codegen->labels++;
+
+			String empty;
+			String_constructor(&empty, "");
+			Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("ord_empty", id), arguments[0], Operand_string(&empty));
+			String_destructor(&empty);
+
+			Instruction_emit(OPCODE_STRI2INT, 3, result, arguments[0], Operand_int(0));
+			Instruction_jump_id("ord_end", id);
+			Instruction_label_id("ord_empty", id);
+			Instruction_emit(OPCODE_MOVE, 2, result, Operand_int(0));
+			Instruction_label_id("ord_end", id);
+		} break;
+		case FUNCTION_INTERNAL_STRINGIFY_DOUBLE:
+		case FUNCTION_INTERNAL_STRINGIFY_INT:
+		case FUNCTION_INTERNAL_STRINGIFY_BOOL:
+		case FUNCTION_INTERNAL_STRINGIFY_STRING: {
+			// Constants are converted at compile time
+			if(arguments[0].type == OPERAND_NIL || arguments[0].type == OPERAND_INT || arguments[0].type == OPERAND_BOOL) {
+				String *string = arguments[0].type == OPERAND_INT ? String_fromLong(arguments[0].value.integer) : String_alloc("");
+				if(arguments[0].type == OPERAND_NIL) String_set(string, "nil");
+				if(arguments[0].type == OPERAND_BOOL) String_set(string, arguments[0].value.boolean ? "true" : "false");
+
+				Instruction_emit(OPCODE_MOVE, 2, result, Operand_string(string));
+				String_free(string);
+				break;
+			}
+
+			ArgumentASTNode *argument = Array_get(functionCall->argumentList->arguments, 0);
+
+			Instruction_createframe();
+			Instruction_defvar("ARG1_STRINGIFY", FRAME_TEMPORARY);
+			Instruction_emit(OPCODE_MOVE, 2, Operand_variable(FRAME_TEMPORARY, "ARG1_STRINGIFY"), arguments[0]);
+			__Codegen_convertStringify(codegen, builtin, __Codegen_getExpressionType(codegen, argument->expression));
+			Instruction_emit(OPCODE_MOVE, 2, result, Operand_variable(FRAME_TEMPORARY, "RETVAL_STRINGIFY"));
+		} break;
+		default:
+			fassertf("[Codegen] Unexpected built-in function (lowerBuiltInFunction).");
+	}
+
+	return result;
+}
+
+Operand __Codegen_lowerSubstring(Codegen *codegen, Operand *arguments, Operand *destination) {
+	Operand string = arguments[0], start = arguments[1], end = arguments[2];
+	size_t id = codegen->labels++;
+
+	Operand buffer = __Codegen_allocateTemporary(codegen);
+	Operand index = __Codegen_allocateTemporary(codegen);
+	Operand value = __Codegen_allocateTemporary(codegen);
+	Operand nil = Operand_label_id("substring_nil", id);
+
+	// i < 0, j < 0, i > j
+	Instruction_emit(OPCODE_LT, 3, value, start, Operand_int(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, nil, value, Operand_bool(true));
+	Instruction_emit(OPCODE_LT, 3, value, end, Operand_int(0));
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, nil, value, Operand_bool(true));
+	Instruction_emit(OPCODE_GT, 3, value, start, end);
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, nil, value, Operand_bool(true));
+
+	// i >= length(string), j > length(string)
+	Instruction_emit(OPCODE_STRLEN, 2, index, string);
+	Instruction_emit(OPCODE_LT, 3, value, start, index);
+	Instruction_emit(OPCODE_JUMPIFNEQ, 3, nil, value, Operand_bool(true));
+	Instruction_emit(OPCODE_GT, 3, value, end, index);
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, nil, value, Operand_bool(true));
+
+	// All checks passed, the characters are appended one by one
+	String empty;
+	String_constructor(&empty, "");
+	Instruction_emit(OPCODE_MOVE, 2, buffer, Operand_string(&empty));
+	String_destructor(&empty);
+
+	Instruction_emit(OPCODE_MOVE, 2, index, start);
+
+	Instruction_label_id("substring_loop", id);
+	Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("substring_end", id), index, end);
+	Instruction_emit(OPCODE_GETCHAR, 3, value, string, index);
+	Instruction_emit(OPCODE_CONCAT, 3, buffer, buffer, value);
+	Instruction_emit(OPCODE_ADD, 3, index, index, Operand_int(1));
+	Instruction_jump_id("substring_loop", id);
+
+	Instruction_label_id("substring_nil", id);
+	Instruction_emit(OPCODE_MOVE, 2, buffer, Operand_nil());
+	Instruction_label_id("substring_end", id);
+
+	// The destination may be one of the arguments, so it is written only at the end
+	if(destination) Instruction_emit(OPCODE_MOVE, 2, *destination, buffer);
+
+	return buffer;
+}
+
+Operand __Codegen_lowerConcatenation(Codegen *codegen, ExpressionASTNode *expression, Operand *destination) {
+	Array *segments = __Codegen_getConcatenationSegments(codegen, expression);
+	Operand result = __Codegen_lowerSegments(codegen, segments, segments->size, destination);
+
+	Array_free(segments);
+	return result;
+}
+
+Operand __Codegen_lowerSegments(Codegen *codegen, Array *segments, size_t count, Operand *destination) {
+	size_t temporaries = codegen->temporaries;
+
+	// The whole chain is built in a single accumulator, the destination may be read by the segments
+	Operand accumulator = __Codegen_allocateTemporary(codegen);
+	Operand result = destination ? *destination : accumulator;
+	size_t segmentTemporaries = codegen->temporaries;
+
+	if(count == 0) {
+		codegen->temporaries = temporaries;
+
+		String empty;
+		String_constructor(&empty, "");
+		Operand segment = Operand_string(&empty);
+		String_destructor(&empty);
+
+		return segment;
+	}
+
+	Operand first;
+	Operand *prefix = NULL;
+
+	for(size_t i = 0; i < count; i++) {
+		ExpressionASTNode *node = Array_get(segments, i);
+		size_t next = i + 1;
+		Operand segment;
+
+		if(__Codegen_isStringLiteral(node)) {
+			segment = __Codegen_mergeLiterals(segments, i, count, &next);
+			i = next - 1;
+		} else if(__Codegen_getStringify(codegen, node) != FUNCTION_NONE) {
+			__Codegen_lowerStringify(codegen, (FunctionCallASTNode*)node, next < count ? &accumulator : &result, prefix);
+
+			codegen->temporaries = segmentTemporaries;
+			prefix = &accumulator;
+			continue;
+		} else {
+			segment = __Codegen_lowerExpression(codegen, node, NULL);
+		}
+
+		if(next == count) {
+			// Single segment is the result itself, its temporary is kept allocated
+			if(!prefix) return segment;
+
+			__Codegen_appendSegment(&result, prefix, segment);
+		} else if(!prefix) {
+			// Variable read by the first segment could be modified by a function called in the following one
+			bool isModified = segment.type == OPERAND_VARIABLE && __Codegen_hasCalls(codegen, Array_get(segments, next));
+
+			// The first segment is concatenated with the second one directly, its temporary is kept until then
+			if(!isModified) {
+				first = segment;
+				prefix = &first;
+				continue;
+			}
+
+			__Codegen_appendSegment(&accumulator, NULL, segment);
+			prefix = &accumulator;
+		} else {
+			__Codegen_appendSegment(&accumulator, prefix, segment);
+			prefix = &accumulator;
+		}
+
+		codegen->temporaries = segmentTemporaries;
+	}
+
+	// The result is written by the last segment, it can reuse the accumulator
+	codegen->temporaries = temporaries;
+	if(!destination) __Codegen_allocateTemporary(codegen);
+
+	return result;
+}
+
+void __Codegen_lowerStringify(Codegen *codegen, FunctionCallASTNode *stringify, Operand *target, Operand *prefix) {
+	enum BuiltInFunction builtin = __Codegen_getStringify(codegen, (ExpressionASTNode*)stringify);
+	ArgumentASTNode *argument = Array_get(stringify->argumentList->arguments, 0);
+	ValueType type = __Codegen_getExpressionType(codegen, argument->expression);
+
+	Operand value = __Codegen_lowerExpression(codegen, argument->expression, NULL);
+	bool isNullable = type.isNullable || type.type == TYPE_NIL || type.type == TYPE_INVALID;
+
+	String string;
+	String_constructor(&string, "");
+
+	// Constants are converted at compile time
+	if(value.type == OPERAND_NIL || value.type == OPERAND_BOOL || value.type == OPERAND_STRING) {
+		if(value.type == OPERAND_NIL) String_set(&string, "nil");
+		if(value.type == OPERAND_BOOL) String_set(&string, value.value.boolean ? "true" : "false");
+
+		__Codegen_appendSegment(target, prefix, value.type == OPERAND_STRING ? value : Operand_string(&string));
+		String_destructor(&string);
+		return;
+	}
+
+	size_t id = codegen->labels++;
+
+	if(isNullable) {
+		Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("stringify_nil", id), value, Operand_nil());
+	}
+
+	if(builtin == FUNCTION_INTERNAL_STRINGIFY_BOOL) {
+		Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("stringify_false", id), value, Operand_bool(false));
+
+		String_set(&string, "true");
+		__Codegen_appendSegment(target, prefix, Operand_string(&string));
+		Instruction_jump_id("stringify_end", id);
+
+		Instruction_label_id("stringify_false", id);
+		String_set(&string, "false");
+		__Codegen_appendSegment(target, prefix, Operand_string(&string));
+	} else {
+		__Codegen_appendSegment(target, prefix, value);
+	}
+
+	if(isNullable) {
+		Instruction_jump_id("stringify_end", id);
+		Instruction_label_id("stringify_nil", id);
+
+		String_set(&string, "nil");
+		__Codegen_appendSegment(target, prefix, Operand_string(&string));
+	}
+
+	Instruction_label_id("stringify_end", id);
+
+	String_destructor(&string);
+}
+
+void __Codegen_lowerWrite(Codegen *codegen, ExpressionASTNode *expression) {
+	size_t temporaries = codegen->temporaries;
+	Array *segments = __Codegen_getConcatenationSegments(codegen, expression);
+
+	// Function called by a segment could write in between the parts, the segments up to it are concatenated first
+	size_t count = 0;
+	for(size_t i = 0; i < segments->size; i++) {
+		if(__Codegen_hasCalls(codegen, Array_get(segments, i))) count = i + 1;
+	}
+
+	if(count > 0) {
+		Instruction_emit(OPCODE_WRITE, 1, __Codegen_lowerSegments(codegen, segments, count, NULL));
+		codegen->temporaries = temporaries;
+	}
+
+	// The rest is written part by part, without building the string
+	for(size_t i = count; i < segments->size; i++) {
+		ExpressionASTNode *node = Array_get(segments, i);
+		ExpressionASTNode *value = __Codegen_getWrittenValue(codegen, node);
+
+		if(__Codegen_isStringLiteral(node)) {
+			size_t next;
+			Instruction_emit(OPCODE_WRITE, 1, __Codegen_mergeLiterals(segments, i, segments->size, &next));
+			i = next - 1;
+		} else if(value == node && __Codegen_getStringify(codegen, node) != FUNCTION_NONE) {
+			__Codegen_lowerStringify(codegen, (FunctionCallASTNode*)node, NULL, NULL);
+		} else {
+			Instruction_emit(OPCODE_WRITE, 1, __Codegen_lowerExpression(codegen, value, NULL));
+		}
+
+		codegen->temporaries = temporaries;
+	}
+
+	Array_free(segments);
+}
+
+void __Codegen_appendSegment(Operand *target, Operand *prefix, Operand segment) {
+	if(!target) {
+		Instruction_emit(OPCODE_WRITE, 1, segment);
+	} else if(prefix) {
+		Instruction_emit(OPCODE_CONCAT, 3, *target, *prefix, segment);
+	} else {
+		Instruction_emit(OPCODE_MOVE, 2, *target, segment);
+	}
+}
+
+Operand __Codegen_mergeLiterals(Array *segments, size_t start, size_t count, size_t *outNext) {
+	String merged;
+	String_constructor(&merged, "");
+
+	// Adjacent static segments are merged at compile time
+	size_t next = start;
+	for(; next < count && __Codegen_isStringLiteral(Array_get(segments, next)); next++) {
+		LiteralExpressionASTNode *literal = Array_get(segments, next);
+		String_append(&merged, literal->value.string->value);
+	}
+
+	Operand segment = Operand_string(&merged);
+	String_destructor(&merged);
+
+	*outNext = next;
+	return segment;
+}
+
+ExpressionASTNode* __Codegen_getWrittenValue(Codegen *codegen, ExpressionASTNode *segment) {
+	if(segment->_type != NODE_FUNCTION_CALL) return segment;
+
+	FunctionCallASTNode *functionCall = (FunctionCallASTNode*)segment;
+	enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, functionCall->id->id);
+	if(builtin != FUNCTION_INTERNAL_STRINGIFY_INT && builtin != FUNCTION_INTERNAL_STRINGIFY_BOOL) return segment;
+
+	ArgumentASTNode *argument = Array_get(functionCall->argumentList->arguments, 0);
+	ValueType type = __Codegen_getExpressionType(codegen, argument->expression);
+	enum BuiltInType expected = builtin == FUNCTION_INTERNAL_STRINGIFY_INT ? TYPE_INT : TYPE_BOOL;
+
+	// Integers and booleans are written in the same format they are stringified to, nil would be written as an empty string
+	if(type.type != expected || type.isNullable) return segment;
+
+	return argument->expression;
+}
+
+Array /*<ExpressionASTNode>*/* __Codegen_getConcatenationSegments(Codegen *codegen, ExpressionASTNode *expression) {
+	Array *segments = Array_alloc(0);
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	// The chain is flattened iteratively, deeply nested chains would overflow the stack otherwise
+	while(worklist->size > 0) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		switch(node->_type) {
+			case NODE_BINARY_EXPRESSION: {
+				BinaryExpressionASTNode *binaryExpression = (BinaryExpressionASTNode*)node;
+				if(binaryExpression->operator != OPERATOR_PLUS || binaryExpression->type.type != TYPE_STRING) break;
+
+				Array_push(worklist, binaryExpression->right);
+				Array_push(worklist, binaryExpression->left);
+			} continue;
+			case NODE_INTERPOLATION_EXPRESSION: {
+				Array_push(worklist, ((InterpolationExpressionASTNode*)node)->concatenated);
+			} continue;
+			case NODE_FUNCTION_CALL: {
+				if(__Codegen_getStringify(codegen, node) != FUNCTION_INTERNAL_STRINGIFY_STRING) break;
+
+				// Stringified string is the segment itself
+				ArgumentASTNode *argument = Array_get(((FunctionCallASTNode*)node)->argumentList->arguments, 0);
+				ValueType type = __Codegen_getExpressionType(codegen, argument->expression);
+				if(type.type != TYPE_STRING || type.isNullable) break;
+
+				Array_push(worklist, argument->expression);
+			} continue;
+			default:
+				break;
+		}
+
+		// Empty strings do not change the result
+		if(__Codegen_isStringLiteral(node) && ((LiteralExpressionASTNode*)node)->value.string->length == 0) continue;
+
+		Array_push(segments, node);
+	}
+
+	Array_free(worklist);
+	return segments;
+}
+
+enum BuiltInFunction __Codegen_getStringify(Codegen *codegen, ExpressionASTNode *expression) {
+	if(expression->_type != NODE_FUNCTION_CALL) return FUNCTION_NONE;
+
+	enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, ((FunctionCallASTNode*)expression)->id->id);
+
+	// Numbers are converted by the internal function
+	if(builtin != FUNCTION_INTERNAL_STRINGIFY_STRING && builtin != FUNCTION_INTERNAL_STRINGIFY_BOOL) return FUNCTION_NONE;
+
+	return builtin;
+}
+
+bool __Codegen_isStringLiteral(ExpressionASTNode *expression) {
+	return expression->_type == NODE_LITERAL_EXPRESSION && ((LiteralExpressionASTNode*)expression)->type.type == TYPE_STRING;
+}
+
+void __Codegen_lowerArguments(Codegen *codegen, Array *arguments, Operand *outArguments) {
+	assertf(arguments->size <= CODEGEN_MAX_INLINE_ARGUMENTS);
+
+	for(size_t i = 0; i < arguments->size; i++) {
+		ArgumentASTNode *argument = Array_get(arguments, i);
+		outArguments[i] = __Codegen_lowerExpression(codegen, argument->expression, NULL);
+
+		if(outArguments[i].type != OPERAND_VARIABLE) continue;
+
+		// Variable read by the argument could be modified by a function called in the following ones
+		for(size_t j = i + 1; j < arguments->size; j++) {
+			ArgumentASTNode *following = Array_get(arguments, j);
+			if(!__Codegen_hasCalls(codegen, following->expression)) continue;
+
+			Operand copy = __Codegen_allocateTemporary(codegen);
+			Instruction_emit(OPCODE_MOVE, 2, copy, outArguments[i]);
+			outArguments[i] = copy;
+			break;
+		}
+	}
+}
+
+void __Codegen_lowerCondition(Codegen *codegen, ExpressionASTNode *test, bool isJumpIfTrue, char *label, size_t id) {
+	size_t temporaries = codegen->temporaries;
+	BinaryExpressionASTNode *binaryExpression = (BinaryExpressionASTNode*)test;
+
+	enum OperatorType operator = test->_type == NODE_BINARY_EXPRESSION ? binaryExpression->operator : OPERATOR_DEFAULT;
+
+	if(operator == OPERATOR_EQUAL || operator == OPERATOR_NOT_EQUAL) {
+		// Equality is compared by the jump itself
+		Operand left, right;
+		__Codegen_lowerOperands(codegen, binaryExpression, &left, &right);
+
+		bool isJumpIfEqual = (operator == OPERATOR_EQUAL) == isJumpIfTrue;
+		Instruction_emit(isJumpIfEqual ? OPCODE_JUMPIFEQ : OPCODE_JUMPIFNEQ, 3, Operand_label_id(label, id), left, right);
+	} else if(operator == OPERATOR_LESS || operator == OPERATOR_GREATER || operator == OPERATOR_LESS_EQUAL || operator == OPERATOR_GREATER_EQUAL) {
+		// Negated comparisons (<= is !(>), >= is !(<)) jump on the opposite result instead
+		bool isLess = operator == OPERATOR_LESS || operator == OPERATOR_GREATER_EQUAL;
+		bool isNegated = operator == OPERATOR_LESS_EQUAL || operator == OPERATOR_GREATER_EQUAL;
+
+		Operand left, right;
+		__Codegen_lowerOperands(codegen, binaryExpression, &left, &right);
+
+		codegen->temporaries = temporaries;
+		Operand condition = __Codegen_allocateTemporary(codegen);
+
+		Instruction_emit(isLess ? OPCODE_LT : OPCODE_GT, 3, condition, left, right);
+		Instruction_emit(isNegated != isJumpIfTrue ? OPCODE_JUMPIFEQ : OPCODE_JUMPIFNEQ, 3, Operand_label_id(label, id), condition, Operand_bool(true));
+	} else {
+		Operand condition = __Codegen_lowerExpression(codegen, test, NULL);
+		Instruction_emit(isJumpIfTrue ? OPCODE_JUMPIFEQ : OPCODE_JUMPIFNEQ, 3, Operand_label_id(label, id), condition, Operand_bool(true));
+	}
+
+	codegen->temporaries = temporaries;
+}
+
+bool __Codegen_isLowerable(Codegen *codegen, ExpressionASTNode *expression) {
+	switch(expression->_type) {
+		case NODE_UNARY_EXPRESSION:
+			return ((UnaryExpressionASTNode*)expression)->operator == OPERATOR_NOT;
+		case NODE_BINARY_EXPRESSION:
+			return ((BinaryExpressionASTNode*)expression)->operator != OPERATOR_NULL_COALESCING;
+		case NODE_INTERPOLATION_EXPRESSION:
+			return true;
+		case NODE_FUNCTION_CALL: {
+			enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, ((FunctionCallASTNode*)expression)->id->id);
+			return __Codegen_isInlineBuiltIn(builtin);
+		}
+		default:
+			// Literals and variables are pushed directly
+			return false;
+	}
+}
+
+bool __Codegen_isInlineBuiltIn(enum BuiltInFunction builtin) {
+	switch(builtin) {
+		case FUNCTION_INT_TO_DOUBLE:
+		case FUNCTION_DOUBLE_TO_INT:
+		case FUNCTION_LENGTH:
+		case FUNCTION_SUBSTRING:
+		case FUNCTION_ORD:
+		case FUNCTION_CHR:
+		case FUNCTION_INTERNAL_STRINGIFY_DOUBLE:
+		case FUNCTION_INTERNAL_STRINGIFY_INT:
+		case FUNCTION_INTERNAL_STRINGIFY_BOOL:
+		case FUNCTION_INTERNAL_STRINGIFY_STRING:
+			return true;
+		default:
+			// Reading functions use the helper variables, write does not have a value
+			return false;
+	}
+}
+
+bool __Codegen_hasCalls(Codegen *codegen, ExpressionASTNode *expression) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	bool hasCalls = false;
+	size_t budget = CODEGEN_CALL_SEARCH_BUDGET;
+
+	while(worklist->size > 0 && !hasCalls) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		// Searching the whole operand at every level of a deeply nested expression would take quadratic time
+		if(budget-- == 0) {
+			hasCalls = true;
+			break;
+		}
+
+		switch(node->_type) {
+			case NODE_FUNCTION_CALL: {
+				FunctionCallASTNode *functionCall = (FunctionCallASTNode*)node;
+				enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(codegen->analyser, functionCall->id->id);
+
+				// Built-in and pure internal functions do not modify the variables
+				if(!is_func_builtin(builtin) && !is_func_pure(builtin)) {
+					hasCalls = true;
+					break;
+				}
+
+				Array *arguments = functionCall->argumentList->arguments;
+				for(size_t i = 0; i < arguments->size; i++) {
+					ArgumentASTNode *argument = Array_get(arguments, i);
+					Array_push(worklist, argument->expression);
+				}
+			} break;
+			case NODE_UNARY_EXPRESSION: {
+				Array_push(worklist, ((UnaryExpressionASTNode*)node)->argument);
+			} break;
+			case NODE_BINARY_EXPRESSION: {
+				BinaryExpressionASTNode *binaryExpression = (BinaryExpressionASTNode*)node;
+				Array_push(worklist, binaryExpression->left);
+				Array_push(worklist, binaryExpression->right);
+			} break;
+			case NODE_INTERPOLATION_EXPRESSION: {
+				Array_push(worklist, ((InterpolationExpressionASTNode*)node)->concatenated);
+			} break;
+			default:
+				break;
+		}
+	}
+
+	Array_free(worklist);
+
+	return hasCalls;
+}
+
+Operand __Codegen_getVariableOperand(Codegen *codegen, size_t id) {
+	return Operand_variable_id(Analyser_isDeclarationGlobal(codegen->analyser, id) ? FRAME_GLOBAL : codegen->frame, id);
+}
+
+Operand __Codegen_getLiteralOperand(LiteralExpressionASTNode *literal) {
+	switch(literal->type.type) {
+		case TYPE_NIL:
+			return Operand_nil();
+		case TYPE_INT:
+			return Operand_int(literal->value.integer);
+		case TYPE_DOUBLE:
+			return Operand_float(literal->value.floating);
+		case TYPE_BOOL:
+			return Operand_bool(literal->value.boolean);
+		case TYPE_STRING:
+			return Operand_string(literal->value.string);
+		default:
+			fassertf("[Codegen] Unknown or invalid literal type.");
+	}
+}
+
+ValueType __Codegen_getExpressionType(Codegen *codegen, ExpressionASTNode *expression) {
+	switch(expression->_type) {
+		case NODE_LITERAL_EXPRESSION:
+			return ((LiteralExpressionASTNode*)expression)->type;
+		case NODE_IDENTIFIER: {
+			VariableDeclaration *declaration = Analyser_getVariableById(codegen->analyser, ((IdentifierASTNode*)expression)->id);
+			if(declaration) return declaration->type;
+		} break;
+		case NODE_FUNCTION_CALL: {
+			FunctionDeclaration *function = Analyser_getFunctionById(codegen->analyser, ((FunctionCallASTNode*)expression)->id->id);
+			if(function) return function->returnType;
+		} break;
+		case NODE_UNARY_EXPRESSION:
+			return ((UnaryExpressionASTNode*)expression)->type;
+		case NODE_BINARY_EXPRESSION:
+			return ((BinaryExpressionASTNode*)expression)->type;
+		case NODE_INTERPOLATION_EXPRESSION:
+			return ((InterpolationExpressionASTNode*)expression)->concatenated->type;
+		default:
+			break;
+	}
+
+	// Unknown type may hold any value
+	return (ValueType){.type = TYPE_INVALID, .isNullable = true};
+}
+
+Operand __Codegen_allocateTemporary(Codegen *codegen) {
+	Operand temporary = Operand_variable_named_id(codegen->frame, "tmp", codegen->temporaries++);
+	if(codegen->temporaries > codegen->maxTemporaries) codegen->maxTemporaries = codegen->temporaries;
+
+	return temporary;
+}
+
+void __Codegen_beginTemporaries(Codegen *codegen, InstructionList *body) {
+	// The body is generated separately, its temporaries are declared in front of it
+	InstructionList_constructor(body);
+	InstructionList_select(body);
+
+	codegen->temporaries = 0;
+	codegen->maxTemporaries = 0;
+}
+
+void __Codegen_declareTemporaries(Codegen *codegen, InstructionList *list, InstructionList *body) {
+	InstructionList_select(list);
+
+	for(size_t i = 0; i < codegen->maxTemporaries; i++) {
+		Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_named_id(codegen->frame, "tmp", i));
+	}
+
+	InstructionList_append(list, body);
+	InstructionList_destructor(body);
+}
+
+void __Codegen_lowerExpression_extended(void *context) {
+	CodegenCall *call = context;
+	call->result = __Codegen_lowerExpression(call->codegen, (ExpressionASTNode*)call->node, call->destination);
+}
+
+void __Codegen_evaluateExpression_extended(void *context) {
+	CodegenCall *call = context;
+	__Codegen_evaluateExpression(call->codegen, (ExpressionASTNode*)call->node);
+}
+
+void __Codegen_evaluateCondition_extended(void *context) {
+	CodegenCall *call = context;
+	__Codegen_evaluateCondition(call->codegen, (ExpressionASTNode*)call->node, call->isJumpIfTrue, call->label, call->labelId);
+}
+
+void __Codegen_evaluateBlock_extended(void *context) {
+	CodegenCall *call = context;
+	__Codegen_evaluateBlock(call->codegen, (BlockASTNode*)call->node);
+}
+
 /** End of file src/compiler/codegen/Codegen.c **/
@@ -0,0 +1,449 @@
+/**
+ * @file src/compiler/codegen/FrameAllocator.c
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Reuse of the frame variables with disjoint lifetimes.
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "assertf.h"
+#include "allocator/MemoryAllocator.h"
+#include "internal/Array.h"
+#include "internal/BitSet.h"
+#include "compiler/codegen/Instruction.h"
+#include "compiler/codegen/FrameAllocator.h"
+
+typedef struct AllocatorVariable {
+	Operand operand; // The variable as declared
+	size_t index; // Index of the variable in the live sets
+	size_t start; // First instruction the variable is live at
+	size_t end; // Last instruction the variable is live at
+	bool isUsed;
+	struct AllocatorVariable *slot; // The variable whose declaration is shared
+} AllocatorVariable;
+
+typedef struct AllocatorBlock {
+	BasicBlock *range;
+	struct AllocatorBlock *successors[2];
+	BitSet use; // Variables read before they are written in the block
+	BitSet def; // Variables written in the block
+	BitSet liveIn;
+	BitSet liveOut;
+} AllocatorBlock;
+
+// Open addressing table of the values indexed by the name and the id of an operand
+typedef struct AllocatorTable {
+	Operand **keys;
+	void **values;
+	size_t capacity; // Power of two, at least twice the number of the keys
+} AllocatorTable;
+
+typedef struct AllocatorContext {
+	InstructionList *list;
+	Array /*<AllocatorVariable>*/ *variables;
+	AllocatorTable /*<AllocatorVariable>*/ variablesByName;
+	Array /*<AllocatorBlock>*/ *blocks;
+	AllocatorTable /*<AllocatorBlock>*/ blocksByLabel;
+} AllocatorContext;
+
+void __FrameAllocator_collectVariables(AllocatorContext *context);
+bool __FrameAllocator_buildBlocks(AllocatorContext *context);
+void __FrameAllocator_computeLiveness(AllocatorContext *context);
+void __FrameAllocator_computeLifetimes(AllocatorContext *context);
+size_t __FrameAllocator_assignSlots(AllocatorContext *context);
+void __FrameAllocator_rewrite(AllocatorContext *context);
+void __FrameAllocator_destroyContext(AllocatorContext *context);
+AllocatorVariable* __FrameAllocator_getVariable(AllocatorContext *context, Operand *operand);
+void __FrameAllocator_constructTable(AllocatorTable *table, size_t size);
+void __FrameAllocator_destructTable(AllocatorTable *table);
+void __FrameAllocator_setEntry(AllocatorTable *table, Operand *key, void *value);
+void* __FrameAllocator_getEntry(AllocatorTable *table, Operand *key);
+size_t __FrameAllocator_hashOperand(Operand *operand);
+void __FrameAllocator_extendLifetime(AllocatorVariable *variable, size_t position);
+int __FrameAllocator_compareStarts(const void *a, const void *b);
+
+void FrameAllocator_constructor(FrameAllocator *allocator) {
+	assertf(allocator != NULL);
+
+	allocator->variables = 0;
+	allocator->slots = 0;
+}
+
+void FrameAllocator_destructor(FrameAllocator *allocator) {
+	assertf(allocator != NULL);
+}
+
+void FrameAllocator_allocate(FrameAllocator *allocator, InstructionList *list) {
+	assertf(allocator != NULL);
+	assertf(list != NULL);
+
+	AllocatorContext context = {
+		.list = list,
+		.variables = Array_alloc(0),
+		.blocks = Array_alloc(0)
+	};
+
+	__FrameAllocator_collectVariables(&context);
+
+	// The list is left intact if the control flow leaves it by a jump
+	if(context.variables->size == 0 || !__FrameAllocator_buildBlocks(&context)) {
+		allocator->variables += context.variables->size;
+		allocator->slots += context.variables->size;
+		__FrameAllocator_destroyContext(&context);
+		return;
+	}
+
+	__FrameAllocator_computeLiveness(&context);
+	__FrameAllocator_computeLifetimes(&context);
+
+	allocator->variables += context.variables->size;
+	allocator->slots += __FrameAllocator_assignSlots(&context);
+
+	__FrameAllocator_rewrite(&context);
+	__FrameAllocator_destroyContext(&context);
+}
+
+void __FrameAllocator_collectVariables(AllocatorContext *context) {
+	Array *instructions = context->list->instructions;
+
+	for(size_t i = 0; i < instructions->size; i++) {
+		Instruction *instruction = Array_get(instructions, i);
+		if(instruction->opcode != OPCODE_DEFVAR || instruction->operands[0].frame != FRAME_LOCAL) continue;
+
+		AllocatorVariable *variable = mem_alloc(sizeof(AllocatorVariable));
+		variable->operand = instruction->operands[0];
+		variable->index = context->variables->size;
+		variable->start = SIZE_MAX;
+		variable->end = 0;
+		variable->isUsed = false;
+		variable->slot = NULL;
+
+		Array_push(context->variables, variable);
+	}
+
+	__FrameAllocator_constructTable(&context->variablesByName, context->variables->size);
+
+	for(size_t i = 0; i < context->variables->size; i++) {
+		AllocatorVariable *variable = Array_get(context->variables, i);
+		__FrameAllocator_setEntry(&context->variablesByName, &variable->operand, variable);
+	}
+}
+
+bool __FrameAllocator_buildBlocks(AllocatorContext *context) {
+	Array *instructions = context->list->instructions;
+	Array *ranges = InstructionList_getBasicBlocks(context->list);
+
+	size_t labels = 0;
+	for(size_t i = 0; i < instructions->size; i++) {
+		Instruction *instruction = Array_get(instructions, i);
+		if(instruction->opcode == OPCODE_LABEL) labels++;
+	}
+
+	__FrameAllocator_constructTable(&context->blocksByLabel, labels);
+
+	for(size_t i = 0; i < ranges->size; i++) {
+		AllocatorBlock *block = mem_alloc(sizeof(AllocatorBlock));
+		block->range = Array_get(ranges, i);
+		block->successors[0] = NULL;
+		block->successors[1] = NULL;
+		BitSet_constructor(&block->use);
+		BitSet_constructor(&block->def);
+		BitSet_constructor(&block->liveIn);
+		BitSet_constructor(&block->liveOut);
+		Array_push(context->blocks, block);
+
+		for(size_t j = block->range->start; j < block->range->end; j++) {
+			Instruction *instruction = Array_get(instructions, j);
+			if(instruction->opcode != OPCODE_LABEL) continue;
+
+			__FrameAllocator_setEntry(&context->blocksByLabel, &instruction->operands[0], block);
+		}
+	}
+
+	Array_free(ranges);
+
+	for(size_t i = 0; i < context->blocks->size; i++) {
+		AllocatorBlock *block = Array_get(context->blocks, i);
+		AllocatorBlock *next = i + 1 < context->blocks->size ? Array_get(context->blocks, i + 1) : NULL;
+
+		// The last instruction of the block decides where the control continues
+		Instruction *last = NULL;
+		for(size_t j = block->range->end; j > block->range->start && !last; j--) {
+			Instruction *instruction = Array_get(instructions, j - 1);
+			if(!is_opcode_pseudo(instruction->opcode)) last = instruction;
+		}
+
+		if(last && is_opcode_jump(last->opcode)) {
+			AllocatorBlock *target = __FrameAllocator_getEntry(&context->blocksByLabel, &last->operands[0]);
+			if(!target) return false;
+
+			block->successors[0] = target;
+			if(last->opcode != OPCODE_JUMP) block->successors[1] = next;
+		} else if(!last || (last->opcode != OPCODE_RETURN && last->opcode != OPCODE_EXIT)) {
+			// The calls return right after themselves
+			block->successors[0] = next;
+		}
+	}
+
+	return true;
+}
+
+void __FrameAllocator_computeLiveness(AllocatorContext *context) {
+	Array *instructions = context->list->instructions;
+
+	for(size_t i = 0; i < context->blocks->size; i++) {
+		AllocatorBlock *block = Array_get(context->blocks, i);
+
+		for(size_t j = block->range->start; j < block->range->end; j++) {
+			Instruction *instruction = Array_get(instructions, j);
+			if(is_opcode_pseudo(instruction->opcode) || instruction->opcode == OPCODE_DEFVAR) continue;
+
+			bool isAssignment = is_opcode_assignment(instruction->opcode);
+
+			// The operands are read before the result is written
+			for(int k = isAssignment ? 1 : 0; k < INSTRUCTION_MAX_OPERANDS; k++) {
+				AllocatorVariable *variable = __FrameAllocator_getVariable(context, &instruction->operands[k]);
+				if(variable && !BitSet_has(&block->def, variable->index)) BitSet_set(&block->use, variable->index, true);
+			}
+
+			AllocatorVariable *result = isAssignment ? __FrameAllocator_getVariable(context, &instruction->operands[0]) : NULL;
+			if(result) BitSet_set(&block->def, result->index, true);
+		}
+	}
+
+	BitSet live;
+	BitSet_constructor(&live);
+
+	// The live sets only grow, the blocks are visited backwards to converge faster
+	bool isChanged = true;
+	while(isChanged) {
+		isChanged = false;
+
+		for(size_t i = context->blocks->size; i > 0; i--) {
+			AllocatorBlock *block = Array_get(context->blocks, i - 1);
+
+			for(int j = 0; j < 2; j++) {
+				if(block->successors[j]) BitSet_union(&block->liveOut, &block->successors[j]->liveIn);
+			}
+
+			BitSet_copy(&live, &block->liveOut);
+			BitSet_subtract(&live, &block->def);
+			BitSet_union(&live, &block->use);
+
+			if(BitSet_union(&block->liveIn, &live)) isChanged = true;
+		}
+	}
+
+	BitSet_destructor(&live);
+}
+
+void __FrameAllocator_computeLifetimes(AllocatorContext *context) {
+	Array *instructions = context->list->instructions;
+
+	for(size_t i = 0; i < context->blocks->size; i++) {
+		AllocatorBlock *block = Array_get(context->blocks, i);
+
+		// Only the live variables are visited, most of them are live in a few blocks only
+		for(size_t j = BitSet_next(&block->liveIn, 0); j != SIZE_MAX; j = BitSet_next(&block->liveIn, j + 1)) {
+			__FrameAllocator_extendLifetime(Array_get(context->variables, j), block->range->start);
+		}
+
+		for(size_t j = BitSet_next(&block->liveOut, 0); j != SIZE_MAX; j = BitSet_next(&block->liveOut, j + 1)) {
+			__FrameAllocator_extendLifetime(Array_get(context->variables, j), block->range->end - 1);
+		}
+
+		for(size_t j = block->range->start; j < block->range->end; j++) {
+			Instruction *instruction = Array_get(instructions, j);
+			if(is_opcode_pseudo(instruction->opcode) || instruction->opcode == OPCODE_DEFVAR) continue;
+
+			for(int k = 0; k < INSTRUCTION_MAX_OPERANDS; k++) {
+				AllocatorVariable *variable = __FrameAllocator_getVariable(context, &instruction->operands[k]);
+				if(variable) __FrameAllocator_extendLifetime(variable, j);
+			}
+		}
+	}
+}
+
+size_t __FrameAllocator_assignSlots(AllocatorContext *context) {
+	Array *variables = Array_alloc(context->variables->size);
+
+	for(size_t i = 0; i < context->variables->size; i++) {
+		AllocatorVariable *variable = Array_get(context->variables, i);
+		if(variable->isUsed) Array_push(variables, variable);
+	}
+
+	qsort(variables->data, variables->size, sizeof(void*), __FrameAllocator_compareStarts);
+
+	// The slots of the live variables, each slot is represented by the variable that has it declared
+	Array *active = Array_alloc(0);
+	Array *freeSlots = Array_alloc(0);
+	size_t slots = 0;
+
+	for(size_t i = 0; i < variables->size; i++) {
+		AllocatorVariable *variable = Array_get(variables, i);
+
+		// The slot is reused only after its last variable is dead, not at the same instruction
+		for(size_t j = active->size; j > 0; j--) {
+			AllocatorVariable *occupant = Array_get(active, j - 1);
+			if(occupant->end >= variable->start) continue;
+
+			Array_remove(active, j - 1);
+			Array_push(freeSlots, occupant->slot);
+		}
+
+		if(freeSlots->size > 0) {
+			variable->slot = Array_pop(freeSlots);
+		} else {
+			variable->slot = variable;
+			slots++;
+		}
+
+		Array_push(active, variable);
+	}
+
+	Array_free(freeSlots);
+	Array_free(active);
+	Array_free(variables);
+
+	return slots;
+}
+
+void __FrameAllocator_rewrite(AllocatorContext *context) {
+	Array *instructions = context->list->instructions;
+	Array *output = Array_alloc(instructions->size);
+
+	for(size_t i = 0; i < instructions->size; i++) {
+		Instruction *instruction = Array_get(instructions, i);
+
+		if(instruction->opcode == OPCODE_DEFVAR) {
+			AllocatorVariable *variable = __FrameAllocator_getVariable(context, &instruction->operands[0]);
+
+			// The comment and the blank line around a removed declaration are removed with it
+			if(variable && variable->slot != variable) {
+				Instruction *previous = output->size > 0 ? Array_get(output, output->size - 1) : NULL;
+				Instruction *next = i + 1 < instructions->size ? Array_get(instructions, i + 1) : NULL;
+
+				if(previous && previous->opcode == OPCODE_COMMENT) Array_pop(output);
+				if(next && next->opcode == OPCODE_NEWLINE) i++;
+
+				continue;
+			}
+		}
+
+		for(int k = 0; k < INSTRUCTION_MAX_OPERANDS; k++) {
+			AllocatorVariable *variable = __FrameAllocator_getVariable(context, &instruction->operands[k]);
+			if(variable && variable->slot) instruction->operands[k] = variable->slot->operand;
+		}
+
+		Array_push(output, instruction);
+	}
+
+	Array_free(instructions);
+	context->list->instructions = output;
+}
+
+void __FrameAllocator_destroyContext(AllocatorContext *context) {
+	for(size_t i = 0; i < context->variables->size; i++) {
+		mem_free(Array_get(context->variables, i));
+	}
+
+	for(size_t i = 0; i < context->blocks->size; i++) {
+		AllocatorBlock *block = Array_get(context->blocks, i);
+
+		BitSet_destructor(&block->use);
+		BitSet_destructor(&block->def);
+		BitSet_destructor(&block->liveIn);
+		BitSet_destructor(&block->liveOut);
+		mem_free(block->range);
+		mem_free(block);
+	}
+
+	Array_free(context->variables);
+	__FrameAllocator_destructTable(&context->variablesByName);
+	Array_free(context->blocks);
+	__FrameAllocator_destructTable(&context->blocksByLabel);
+}
+
+AllocatorVariable* __FrameAllocator_getVariable(AllocatorContext *context, Operand *operand) {
+	if(operand->type != OPERAND_VARIABLE || operand->frame != FRAME_LOCAL) return NULL;
+
+	return __FrameAllocator_getEntry(&context->variablesByName, operand);
+}
+
+void __FrameAllocator_constructTable(AllocatorTable *table, size_t size) {
+	table->capacity = 1;
+	while(table->capacity < size * 2) table->capacity <<= 1;
+
+	table->keys = mem_calloc(table->capacity, sizeof(Operand*));
+	table->values = mem_calloc(table->capacity, sizeof(void*));
+}
+
+void __FrameAllocator_destructTable(AllocatorTable *table) {
+	if(!table->keys) return;
+
+	mem_free(table->keys);
+	mem_free(table->values);
+	table->keys = NULL;
+	table->values = NULL;
+	table->capacity = 0;
+}
+
+void __FrameAllocator_setEntry(AllocatorTable *table, Operand *key, void *value) {
+	size_t mask = table->capacity - 1;
+	size_t i = __FrameAllocator_hashOperand(key) & mask;
+
+	// The table is never filled over a half, so there is always an empty slot
+	while(table->keys[i] && !Operand_isSameName(table->keys[i], key)) i = (i + 1) & mask;
+
+	table->keys[i] = key;
+	table->values[i] = value;
+}
+
+void* __FrameAllocator_getEntry(AllocatorTable *table, Operand *key) {
+	if(!table->keys) return NULL;
+
+	size_t mask = table->capacity - 1;
+	size_t i = __FrameAllocator_hashOperand(key) & mask;
+
+	while(table->keys[i]) {
+		if(Operand_isSameName(table->keys[i], key)) return table->values[i];
+		i = (i + 1) & mask;
+	}
+
+	return NULL;
+}
+
+size_t __FrameAllocator_hashOperand(Operand *operand) {
+	// FNV-1a of the name followed by the id, the keys are compared by both of them
+	uint64_t hash = 14695981039346656037ULL;
+
+	for(char *ch = operand->name; ch && *ch; ch++) {
+		hash = (hash ^ (unsigned char)*ch) * 1099511628211ULL;
+	}
+
+	if(operand->hasId) hash = (hash ^ operand->id) * 1099511628211ULL;
+
+	return (size_t)hash;
+}
+
+void __FrameAllocator_extendLifetime(AllocatorVariable *variable, size_t position) {
+	if(position < variable->start) variable->start = position;
+	if(position > variable->end) variable->end = position;
+
+	variable->isUsed = true;
+}
+
+int __FrameAllocator_compareStarts(const void *a, const void *b) {
+	AllocatorVariable *left = *(AllocatorVariable**)a;
+	AllocatorVariable *right = *(AllocatorVariable**)b;
+
+	if(left->start != right->start) return left->start < right->start ? -1 : 1;
+
+	// Keeps the order of the declarations for the same start
+	return left->index < right->index ? -1 : left->index > right->index;
+}
+
+/** End of file src/compiler/codegen/FrameAllocator.c **/
@@ -6,15 +6,83 @@
  */
 
 #include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
 #include <stdbool.h>
 
 #include "assertf.h"
+#include "allocator/MemoryAllocator.h"
 #include "internal/String.h"
+#include "internal/Array.h"
 #include "compiler/codegen/Instruction.h"
-#include "compiler/codegen/Codegen.h"
+
+// List the emitted instructions are appended to
+InstructionList *__Instruction_list = NULL;
+
+char *__Instruction_opcodes[] = {
+	[OPCODE_MOVE] = "MOVE",
+	[OPCODE_CREATEFRAME] = "CREATEFRAME",
+	[OPCODE_PUSHFRAME] = "PUSHFRAME",
+	[OPCODE_POPFRAME] = "POPFRAME",
+	[OPCODE_DEFVAR] = "DEFVAR",
+	[OPCODE_CALL] = "CALL",
+	[OPCODE_RETURN] = "RETURN",
+	[OPCODE_PUSHS] = "PUSHS",
+	[OPCODE_POPS] = "POPS",
+	[OPCODE_CLEARS] = "CLEARS",
+	[OPCODE_ADD] = "ADD",
+	[OPCODE_SUB] = "SUB",
+	[OPCODE_MUL] = "MUL",
+	[OPCODE_DIV] = "DIV",
+	[OPCODE_IDIV] = "IDIV",
+	[OPCODE_ADDS] = "ADDS",
+	[OPCODE_SUBS] = "SUBS",
+	[OPCODE_MULS] = "MULS",
+	[OPCODE_DIVS] = "DIVS",
+	[OPCODE_IDIVS] = "IDIVS",
+	[OPCODE_LT] = "LT",
+	[OPCODE_GT] = "GT",
+	[OPCODE_EQ] = "EQ",
+	[OPCODE_LTS] = "LTS",
+	[OPCODE_GTS] = "GTS",
+	[OPCODE_EQS] = "EQS",
+	[OPCODE_AND] = "AND",
+	[OPCODE_OR] = "OR",
+	[OPCODE_NOT] = "NOT",
+	[OPCODE_ANDS] = "ANDS",
+	[OPCODE_ORS] = "ORS",
+	[OPCODE_NOTS] = "NOTS",
+	[OPCODE_INT2FLOAT] = "INT2FLOAT",
+	[OPCODE_FLOAT2INT] = "FLOAT2INT",
+	[OPCODE_INT2CHAR] = "INT2CHAR",
+	[OPCODE_STRI2INT] = "STRI2INT",
+	[OPCODE_INT2FLOATS] = "INT2FLOATS",
+	[OPCODE_FLOAT2INTS] = "FLOAT2INTS",
+	[OPCODE_INT2CHARS] = "INT2CHARS",
+	[OPCODE_STRI2INTS] = "STRI2INTS",
+	[OPCODE_READ] = "READ",
+	[OPCODE_WRITE] = "WRITE",
+	[OPCODE_CONCAT] = "CONCAT",
+	[OPCODE_STRLEN] = "STRLEN",
+	[OPCODE_GETCHAR] = "GETCHAR",
+	[OPCODE_SETCHAR] = "SETCHAR",
+	[OPCODE_TYPE] = "TYPE",
+	[OPCODE_LABEL] = "LABEL",
+	[OPCODE_JUMP] = "JUMP",
+	[OPCODE_JUMPIFEQ] = "JUMPIFEQ",
+	[OPCODE_JUMPIFNEQ] = "JUMPIFNEQ",
+	[OPCODE_JUMPIFEQS] = "JUMPIFEQS",
+	[OPCODE_JUMPIFNEQS] = "JUMPIFNEQS",
+	[OPCODE_EXIT] = "EXIT",
+	[OPCODE_BREAK] = "BREAK",
+	[OPCODE_DPRINT] = "DPRINT"
+};
 
 char * __Instruction_getFrame(enum Frame frame);
-void __Instruction_escape_string(String *string);
+void __Instruction_serializeName(Operand *operand, FILE *stream);
+void __Instruction_serializeString(String *string, FILE *stream);
+void __Instruction_serializeOperand(Operand *operand, FILE *stream);
+void __Instruction_serializeInstruction(Instruction *instruction, FILE *stream);
 
 char * __Instruction_getFrame(enum Frame frame) {
 	switch(frame) {
@@ -29,300 +97,526 @@ char * __Instruction_getFrame(enum Frame frame) {
 	}
 }
 
-void __Instruction_escape_string(String *string) {
-	String buffer;
-	String_constructor(&buffer, "");
+// --- LIST ---
+
+void InstructionList_constructor(InstructionList *list) {
+	assertf(list != NULL);
+
+	list->instructions = Array_alloc(0);
+}
+
+void InstructionList_destructor(InstructionList *list) {
+	assertf(list != NULL);
+
+	if(__Instruction_list == list) __Instruction_list = NULL;
+
+	Array_free(list->instructions);
+	list->instructions = NULL;
+}
+
+void InstructionList_select(InstructionList *list) {
+	__Instruction_list = list;
+}
+
+void InstructionList_append(InstructionList *list, InstructionList *other) {
+	assertf(list != NULL);
+	assertf(other != NULL);
+
+	// Reserving the exact size would reallocate the list on every append
+	for(size_t i = 0; i < other->instructions->size; i++) {
+		Array_push(list->instructions, Array_get(other->instructions, i));
+	}
+}
+
+Array* InstructionList_getBasicBlocks(InstructionList *list) {
+	assertf(list != NULL);
+
+	Array *blocks = Array_alloc(0);
+	size_t start = 0;
+	bool isBlockEnd = false;
+
+	for(size_t i = 0; i < list->instructions->size; i++) {
+		Instruction *instruction = Array_get(list->instructions, i);
+		if(is_opcode_pseudo(instruction->opcode)) continue;
+
+		if((instruction->opcode == OPCODE_LABEL || isBlockEnd) && i > start) {
+			BasicBlock *block = mem_alloc(sizeof(BasicBlock));
+			block->start = start;
+			block->end = i;
+			Array_push(blocks, block);
+
+			start = i;
+		}
+
+		isBlockEnd = is_opcode_block_end(instruction->opcode);
+	}
+
+	if(list->instructions->size > start) {
+		BasicBlock *block = mem_alloc(sizeof(BasicBlock));
+		block->start = start;
+		block->end = list->instructions->size;
+		Array_push(blocks, block);
+	}
+
+	return blocks;
+}
+
+void InstructionList_serialize(InstructionList *list, FILE *stream) {
+	assertf(list != NULL);
+	assertf(stream != NULL);
+
+	for(size_t i = 0; i < list->instructions->size; i++) {
+		__Instruction_serializeInstruction(Array_get(list->instructions, i), stream);
+	}
+}
+
+void __Instruction_serializeInstruction(Instruction *instruction, FILE *stream) {
+	switch(instruction->opcode) {
+		case OPCODE_HEADER: {
+			fprintf(stream, ".IFJcode23\n");
+		} return;
+
+		case OPCODE_COMMENT: {
+			fprintf(stream, "# %s\n", instruction->comment->value);
+		} return;
+
+		case OPCODE_NEWLINE: {
+			fprintf(stream, "\n");
+		} return;
+
+		default: break;
+	}
+
+	fputs(__Instruction_opcodes[instruction->opcode], stream);
+
+	for(size_t i = 0; i < INSTRUCTION_MAX_OPERANDS && instruction->operands[i].type != OPERAND_NONE; i++) {
+		fputc(' ', stream);
+		__Instruction_serializeOperand(&instruction->operands[i], stream);
+	}
+
+	fputc('\n', stream);
+}
+
+void __Instruction_serializeOperand(Operand *operand, FILE *stream) {
+	switch(operand->type) {
+		case OPERAND_VARIABLE: {
+			fprintf(stream, "%s@", __Instruction_getFrame(operand->frame));
+			__Instruction_serializeName(operand, stream);
+		} break;
+
+		case OPERAND_LABEL: {
+			__Instruction_serializeName(operand, stream);
+		} break;
+
+		case OPERAND_TYPE: {
+			fputs(operand->name, stream);
+		} break;
+
+		case OPERAND_INT: {
+			fprintf(stream, "int@%ld", operand->value.integer);
+		} break;
+
+		case OPERAND_FLOAT: {
+			fprintf(stream, "float@%a", operand->value.floating);
+		} break;
+
+		case OPERAND_BOOL: {
+			fprintf(stream, "bool@%s", operand->value.boolean ? "true" : "false");
+		} break;
+
+		case OPERAND_NIL: {
+			fprintf(stream, "nil@nil");
+		} break;
+
+		case OPERAND_STRING: {
+			fprintf(stream, "string@");
+			__Instruction_serializeString(operand->value.string, stream);
+		} break;
+
+		default: {
+			fassertf("Invalid operand. Something went wrong.");
+		}
+	}
+}
+
+void __Instruction_serializeName(Operand *operand, FILE *stream) {
+	fputc('$', stream);
+
+	if(operand->name) fputs(operand->name, stream);
+	if(operand->name && operand->hasId) fputc('_', stream);
+	if(operand->hasId) fprintf(stream, "%lu", operand->id);
+}
 
+void __Instruction_serializeString(String *string, FILE *stream) {
 	for(size_t i = 0; i < string->length; i++) {
 		unsigned char c = string->value[i];
-		if(c < 10) {
-			String *replacement = String_fromFormat("\\00%d", c);
-			String_append(&buffer, replacement->value);
-			String_free(replacement);
-		} else if(c <= 32 || c == 35 || c == 92) {
-			String *replacement = String_fromFormat("\\0%d", c);
-			String_append(&buffer, replacement->value);
-			String_free(replacement);
-		} else if (c > 126) {
-            String *replacement = String_fromFormat("\\%d", c);
-            String_append(&buffer, replacement->value);
-            String_free(replacement);
-        } else {
-			String_appendChar(&buffer, c);
+
+		// Whitespace, control characters, '#', '\\' and non-ASCII characters are written as escape sequences
+		if(c <= 32 || c == 35 || c == 92 || c > 126) {
+			fprintf(stream, "\\%03d", c);
+		} else {
+			fputc(c, stream);
 		}
 	}
+}
+
+// --- OPERANDS ---
+
+Operand Operand_variable(enum Frame frame, char *name) {
+	return (Operand){.type = OPERAND_VARIABLE, .frame = frame, .name = name};
+}
+
+Operand Operand_variable_id(enum Frame frame, size_t id) {
+	return (Operand){.type = OPERAND_VARIABLE, .frame = frame, .id = id, .hasId = true};
+}
+
+Operand Operand_variable_named_id(enum Frame frame, char *name, size_t id) {
+	return (Operand){.type = OPERAND_VARIABLE, .frame = frame, .name = name, .id = id, .hasId = true};
+}
 
-	String_set(string, buffer.value);
+Operand Operand_label(char *name) {
+	return (Operand){.type = OPERAND_LABEL, .name = name};
+}
+
+Operand Operand_label_id(char *name, size_t id) {
+	return (Operand){.type = OPERAND_LABEL, .name = name, .id = id, .hasId = true};
+}
+
+Operand Operand_type(char *name) {
+	return (Operand){.type = OPERAND_TYPE, .name = name};
+}
+
+Operand Operand_int(long value) {
+	return (Operand){.type = OPERAND_INT, .value.integer = value};
+}
+
+Operand Operand_float(double value) {
+	return (Operand){.type = OPERAND_FLOAT, .value.floating = value};
+}
+
+Operand Operand_bool(bool value) {
+	return (Operand){.type = OPERAND_BOOL, .value.boolean = value};
+}
+
+Operand Operand_nil() {
+	return (Operand){.type = OPERAND_NIL};
+}
+
+Operand Operand_string(String *value) {
+	// The literal may be modified (or allocated on the stack) after the instruction is emitted
+	return (Operand){.type = OPERAND_STRING, .value.string = String_clone(value)};
+}
+
+bool Operand_isSameVariable(Operand *a, Operand *b) {
+	if(a->type != OPERAND_VARIABLE || b->type != OPERAND_VARIABLE || a->frame != b->frame) return false;
+
+	return Operand_isSameName(a, b);
+}
+
+bool Operand_isSameName(Operand *a, Operand *b) {
+	if(a->hasId != b->hasId || (a->hasId && a->id != b->id)) return false;
+	if(!a->name || !b->name) return a->name == b->name;
+
+	return strcmp(a->name, b->name) == 0;
+}
+
+// --- EMITTING ---
+
+Instruction* Instruction_emit(enum Opcode opcode, int count, ...) {
+	assertf(__Instruction_list != NULL, "No instruction list is selected");
+	assertf(count >= 0 && count <= INSTRUCTION_MAX_OPERANDS);
+
+	Instruction *instruction = mem_alloc(sizeof(Instruction));
+	instruction->opcode = opcode;
+	instruction->comment = NULL;
+
+	va_list args;
+	va_start(args, count);
+
+	for(int i = 0; i < INSTRUCTION_MAX_OPERANDS; i++) {
+		instruction->operands[i] = i < count ? va_arg(args, Operand) : (Operand){.type = OPERAND_NONE};
+	}
+
+	va_end(args);
+
+	Array_push(__Instruction_list->instructions, instruction);
+
+	return instruction;
+}
+
+void Instruction_comment(String *comment) {
+	Instruction *instruction = Instruction_emit(OPCODE_COMMENT, 0);
+	instruction->comment = comment;
 }
 
 // --- INSTUCTIONS ---
 
 void Instruction_pushframe() {
-	INSTRUCTION_NULLARY("PUSHFRAME")
+	INSTRUCTION_NULLARY(OPCODE_PUSHFRAME)
 }
 
 void Instruction_defvar_id(size_t id, enum Frame frame) {
-	fprintf(stdout, "DEFVAR %s@$%lu\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_id(frame, id));
 }
 
 void Instruction_defretvar(size_t id, enum Frame frame) {
-	fprintf(stdout, "DEFVAR %s@$ret_%lu\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_named_id(frame, "ret", id));
 }
 
 void Instruction_popretvar(size_t id, enum Frame frame) {
-	fprintf(stdout, "POPS %s@$ret_%lu\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_POPS, 1, Operand_variable_named_id(frame, "ret", id));
 }
 
 void Instruction_return() {
-	INSTRUCTION_NULLARY("RETURN")
+	INSTRUCTION_NULLARY(OPCODE_RETURN)
+}
+
+void Instruction_exit(int code) {
+	Instruction_emit(OPCODE_EXIT, 1, Operand_int(code));
 }
 
 void Instruction_readString(char *var, enum Frame frame) {
-	fprintf(stdout, "READ %s@$%s string\n", __Instruction_getFrame(frame), var);
+	Instruction_emit(OPCODE_READ, 2, Operand_variable(frame, var), Operand_type("string"));
 }
 
 void Instruction_readInt(char *var, enum Frame frame) {
-	fprintf(stdout, "READ %s@$%s int\n", __Instruction_getFrame(frame), var);
+	Instruction_emit(OPCODE_READ, 2, Operand_variable(frame, var), Operand_type("int"));
 }
 
 void Instruction_readFloat(char *var, enum Frame frame) {
-	fprintf(stdout, "READ %s@$%s float\n", __Instruction_getFrame(frame), var);
+	Instruction_emit(OPCODE_READ, 2, Operand_variable(frame, var), Operand_type("float"));
 }
 
 /// --- PUSH COMMANDS ---
 
 void Instruction_pushs_nil() {
-	fprintf(stdout, "PUSHS nil@nil\n");
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_nil());
 }
 
 void Instruction_pushs_bool(bool value) {
-	fprintf(stdout, "PUSHS bool@%s\n", value ? "true" : "false");
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_bool(value));
 }
 
 void Instruction_write(char *id, enum Frame frame) {
-	fprintf(stdout, "WRITE %s@$%s\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_WRITE, 1, Operand_variable(frame, id));
 }
 
 // TODO: This is very bad shortcut, should be fixed
 void Instruction_pops(char *where, enum Frame frame) {
-	fprintf(stdout, "POPS %s@$%s\n", __Instruction_getFrame(frame), where);
+	Instruction_emit(OPCODE_POPS, 1, Operand_variable(frame, where));
 }
 
 void Instruction_defvar(char *where, enum Frame frame) {
-	fprintf(stdout, "DEFVAR %s@$%s\n", __Instruction_getFrame(frame), where);
+	Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable(frame, where));
 }
 
 void Instruction_pushs_int(long value) {
-	// TODO: This should be int@%d
-	fprintf(stdout, "PUSHS int@%ld\n", value);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_int(value));
 }
 
 void Instruction_pushs_float(double value) {
-	fprintf(stdout, "PUSHS float@%a\n", value);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_float(value));
 }
 
 void Instruction_pushs_string(String *string) {
-	__Instruction_escape_string(string);
-	fprintf(stdout, "PUSHS string@%s\n", string->value);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_string(string));
 }
 
 void Instruction_pushs_id(size_t id, enum Frame frame) {
-	fprintf(stdout, "PUSHS %s@$%lu\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_variable_id(frame, id));
 }
 
 void Instruction_pushs(char *var, enum Frame frame) {
-	fprintf(stdout, "PUSHS %s@$%s\n", __Instruction_getFrame(frame), var);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_variable(frame, var));
 }
 
 
 void Instruction_pops_id(size_t id, enum Frame frame) {
-	fprintf(stdout, "POPS %s@$%lu\n", __Instruction_getFrame(frame), id);
+	Instruction_emit(OPCODE_POPS, 1, Operand_variable_id(frame, id));
 }
 
 void Instruction_pops_named_id(char * name, size_t id, enum Frame frame) {
-    fprintf(stdout, "POPS %s@$%s_%lu\n", __Instruction_getFrame(frame), name, id);
+	Instruction_emit(OPCODE_POPS, 1, Operand_variable_named_id(frame, name, id));
 }
 
 void Instruction_clears() {
-	INSTRUCTION_NULLARY("CLEARS")
+	INSTRUCTION_NULLARY(OPCODE_CLEARS)
 }
 
 void Instruction_adds() {
-	INSTRUCTION_NULLARY("ADDS")
+	INSTRUCTION_NULLARY(OPCODE_ADDS)
 }
 
 void Instruction_subs() {
-	INSTRUCTION_NULLARY("SUBS")
+	INSTRUCTION_NULLARY(OPCODE_SUBS)
 }
 
 void Instruction_muls() {
-	INSTRUCTION_NULLARY("MULS")
+	INSTRUCTION_NULLARY(OPCODE_MULS)
 }
 
 void Instruction_divs() {
-	INSTRUCTION_NULLARY("DIVS")
+	INSTRUCTION_NULLARY(OPCODE_DIVS)
 }
 
 void Instruction_idivs() {
-	INSTRUCTION_NULLARY("IDIVS")
+	INSTRUCTION_NULLARY(OPCODE_IDIVS)
 }
 
 void Instruction_lts() {
-	INSTRUCTION_NULLARY("LTS")
+	INSTRUCTION_NULLARY(OPCODE_LTS)
 }
 
 void Instruction_gts() {
-	INSTRUCTION_NULLARY("GTS")
+	INSTRUCTION_NULLARY(OPCODE_GTS)
 }
 
 void Instruction_eqs() {
-	INSTRUCTION_NULLARY("EQS")
+	INSTRUCTION_NULLARY(OPCODE_EQS)
 }
 
 void Instruction_ands() {
-	INSTRUCTION_NULLARY("ANDS")
+	INSTRUCTION_NULLARY(OPCODE_ANDS)
 }
 
 void Instruction_ors() {
-	INSTRUCTION_NULLARY("ORS")
+	INSTRUCTION_NULLARY(OPCODE_ORS)
 }
 
 void Instruction_nots() {
-	INSTRUCTION_NULLARY("NOTS")
+	INSTRUCTION_NULLARY(OPCODE_NOTS)
 }
 
 void Instruction_int2floats() {
-	INSTRUCTION_NULLARY("INT2FLOATS")
+	INSTRUCTION_NULLARY(OPCODE_INT2FLOATS)
 }
 
 void Instruction_float2ints() {
-	INSTRUCTION_NULLARY("FLOAT2INTS")
+	INSTRUCTION_NULLARY(OPCODE_FLOAT2INTS)
 }
 
 void Instruction_strlen(enum Frame resultScope, char *result, char *input, enum Frame inputScope) {
-	fprintf(stdout, "STRLEN %s@$%s %s@$%s\n", __Instruction_getFrame(resultScope), result, __Instruction_getFrame(inputScope), input);
+	Instruction_emit(OPCODE_STRLEN, 2, Operand_variable(resultScope, result), Operand_variable(inputScope, input));
 }
 
 void Instruction_int2char(enum Frame resultScope, char *result, enum Frame inputScope, char *input) {
-	fprintf(stdout, "INT2CHAR %s@$%s %s@$%s\n", __Instruction_getFrame(resultScope), result, __Instruction_getFrame(inputScope), input);
+	Instruction_emit(OPCODE_INT2CHAR, 2, Operand_variable(resultScope, result), Operand_variable(inputScope, input));
 }
 
 void Instruction_stri2int(enum Frame resultScope, char *result, enum Frame inputScope, char *input, int index) {
-	fprintf(stdout, "STRI2INT %s@$%s %s@$%s int@%d\n", __Instruction_getFrame(resultScope), result, __Instruction_getFrame(inputScope), input, index);
+	Instruction_emit(OPCODE_STRI2INT, 3, Operand_variable(resultScope, result), Operand_variable(inputScope, input), Operand_int(index));
 }
 
 void Instruction_label(char *label) {
-	fprintf(stdout, "LABEL $%s\n", label);
-}
-
-void Instruction_jump_ifeqs_chr_end() {
-	fprintf(stdout, "JUMPIFEQS $chr_empty\n");
+	Instruction_emit(OPCODE_LABEL, 1, Operand_label(label));
 }
 
 void Instruction_jump(char *label) {
-	fprintf(stdout, "JUMP $%s\n", label);
+	Instruction_emit(OPCODE_JUMP, 1, Operand_label(label));
 }
 
 void Instruction_move_vars(enum Frame destinationScope, char *destination, enum Frame sourceScope, char *source) {
-	fprintf(stdout, "MOVE %s@$%s %s@$%s\n", __Instruction_getFrame(destinationScope), destination, __Instruction_getFrame(sourceScope), source);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable(destinationScope, destination), Operand_variable(sourceScope, source));
 }
 
 void Instruction_popframe() {
-	INSTRUCTION_NULLARY("POPFRAME")
+	INSTRUCTION_NULLARY(OPCODE_POPFRAME)
 }
 
 void Instruction_call(char *label) {
-	fprintf(stdout, "CALL $%s\n", label);
+	Instruction_emit(OPCODE_CALL, 1, Operand_label(label));
 }
 
 void Instruction_createframe() {
-	INSTRUCTION_NULLARY("CREATEFRAME")
+	INSTRUCTION_NULLARY(OPCODE_CREATEFRAME)
 }
 
 void Instruction_jump_ifeqs(char *label) {
-	fprintf(stdout, "JUMPIFEQS $%s\n", label);
+	Instruction_emit(OPCODE_JUMPIFEQS, 1, Operand_label(label));
 }
 
 void Instruction_getchar(enum Frame resultScope, char *result, enum Frame inputScope, char *input, enum Frame indexScope, char *index) {
-	fprintf(stdout, "GETCHAR %s@$%s %s@$%s %s@$%s\n", __Instruction_getFrame(resultScope), result, __Instruction_getFrame(inputScope), input, __Instruction_getFrame(indexScope), index);
+	Instruction_emit(OPCODE_GETCHAR, 3, Operand_variable(resultScope, result), Operand_variable(inputScope, input), Operand_variable(indexScope, index));
 }
 
 void Instruction_concat(enum Frame resultScope, char *result, enum Frame input1Scope, char *input1, enum Frame input2Scope, char *input2) {
-	fprintf(stdout, "CONCAT %s@$%s %s@$%s %s@$%s\n", __Instruction_getFrame(resultScope), result, __Instruction_getFrame(input1Scope), input1, __Instruction_getFrame(input2Scope), input2);
+	Instruction_emit(OPCODE_CONCAT, 3, Operand_variable(resultScope, result), Operand_variable(input1Scope, input1), Operand_variable(input2Scope, input2));
 }
 
 void Instruction_call_func(size_t id) {
-	fprintf(stdout, "CALL $func_%lu\n", id);
+	Instruction_emit(OPCODE_CALL, 1, Operand_label_id("func", id));
 }
 
 void Instruction_label_func(size_t id) {
-	fprintf(stdout, "LABEL $func_%lu\n", id);
+	Instruction_emit(OPCODE_LABEL, 1, Operand_label_id("func", id));
 }
 
 void Instruction_pushs_func_result(size_t id) {
-	fprintf(stdout, "PUSHS TF@$ret_%lu\n", id);
+	Instruction_emit(OPCODE_PUSHS, 1, Operand_variable_named_id(FRAME_TEMPORARY, "ret", id));
 }
 
 void Instruction_move_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source) {
-	fprintf(stdout, "MOVE %s@$%lu %s@$%lu\n", __Instruction_getFrame(destinationScope), destination, __Instruction_getFrame(sourceScope), source);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_variable_id(sourceScope, source));
 }
 
 void Instruction_move_int(enum Frame destinationScope, char *destination, int value) {
-	fprintf(stdout, "MOVE %s@$%s int@%d\n", __Instruction_getFrame(destinationScope), destination, value);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable(destinationScope, destination), Operand_int(value));
 }
 
 void Instruction_move_string(enum Frame destinationScope, char *destination, String *value) {
-	__Instruction_escape_string(value);
-	fprintf(stdout, "MOVE %s@$%s string@%s\n", __Instruction_getFrame(destinationScope), destination, value->value);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable(destinationScope, destination), Operand_string(value));
 }
 
 void Instruction_move_nil(enum Frame destinationScope, char *destination) {
-	fprintf(stdout, "MOVE %s@$%s nil@nil\n", __Instruction_getFrame(destinationScope), destination);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable(destinationScope, destination), Operand_nil());
 }
 
 void Instruction_move_int_id(enum Frame destinationScope, size_t destination, long int value) {
-	fprintf(stdout, "MOVE %s@$%lu int@%ld\n", __Instruction_getFrame(destinationScope), destination, value);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_int(value));
 }
 
 void Instruction_move_string_id(enum Frame destinationScope, size_t destination, String *value) {
-	__Instruction_escape_string(value);
-	fprintf(stdout, "MOVE %s@$%lu string@%s\n", __Instruction_getFrame(destinationScope), destination, value->value);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_string(value));
 }
 
 void Instruction_move_nil_id(enum Frame destinationScope, size_t destination) {
-	fprintf(stdout, "MOVE %s@$%lu nil@nil\n", __Instruction_getFrame(destinationScope), destination);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_nil());
 }
 
 void Instruction_move_float_id(enum Frame destinationScope, size_t destination, double value) {
-	fprintf(stdout, "MOVE %s@$%lu float@%a\n", __Instruction_getFrame(destinationScope), destination, value);
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_float(value));
 }
 
 void Instruction_move_bool_id(enum Frame destinationScope, size_t destination, bool value) {
-	fprintf(stdout, "MOVE %s@$%lu bool@%s\n", __Instruction_getFrame(destinationScope), destination, value ? "true" : "false");
+	Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(destinationScope, destination), Operand_bool(value));
 }
 
 void Instruction_add_int(enum Frame destinationScope, char *destination, enum Frame sourceScope, char *source, int value) {
-	fprintf(stdout, "ADD %s@$%s %s@$%s int@%d\n", __Instruction_getFrame(destinationScope), destination, __Instruction_getFrame(sourceScope), source, value);
+	Instruction_emit(OPCODE_ADD, 3, Operand_variable(destinationScope, destination), Operand_variable(sourceScope, source), Operand_int(value));
+}
+
+void Instruction_add_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, long int value) {
+	Instruction_emit(OPCODE_ADD, 3, Operand_variable_id(destinationScope, destination), Operand_variable_id(sourceScope, source), Operand_int(value));
 }
 
-void Instruction_add_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, int value) {
-    fprintf(stdout, "ADD %s@$%lu %s@$%lu int@%d\n", __Instruction_getFrame(destinationScope), destination, __Instruction_getFrame(sourceScope), source, value);
+void Instruction_mul_int_id(enum Frame destinationScope, size_t destination, enum Frame sourceScope, size_t source, long int value) {
+	Instruction_emit(OPCODE_MUL, 3, Operand_variable_id(destinationScope, destination), Operand_variable_id(sourceScope, source), Operand_int(value));
 }
 
 void Instruction_label_id(char *label, size_t id) {
-    fprintf(stdout, "LABEL $%s_%lu\n", label, id);
+	Instruction_emit(OPCODE_LABEL, 1, Operand_label_id(label, id));
 }
 
 void Instruction_jump_id(char *label, size_t id) {
-    fprintf(stdout, "JUMP $%s_%lu\n", label, id);
+	Instruction_emit(OPCODE_JUMP, 1, Operand_label_id(label, id));
 }
 
 void Instruction_jump_ifeqs_id(char *label, size_t id) {
-    fprintf(stdout, "JUMPIFEQS $%s_%lu\n", label, id);
+	Instruction_emit(OPCODE_JUMPIFEQS, 1, Operand_label_id(label, id));
 }
 
 void Instruction_jump_ifneqs_id(char *label, size_t id) {
-    fprintf(stdout, "JUMPIFNEQS $%s_%lu\n", label, id);
+	Instruction_emit(OPCODE_JUMPIFNEQS, 1, Operand_label_id(label, id));
 }
 
 /** End of file src/compiler/codegen/Instruction.c **/
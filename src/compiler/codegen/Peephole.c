@@ -0,0 +1,325 @@
+/**
+ * @file src/compiler/codegen/Peephole.c
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Peephole optimization of the generated instruction list.
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdbool.h>
+
+#include "assertf.h"
+#include "internal/Array.h"
+#include "compiler/codegen/Instruction.h"
+#include "compiler/codegen/Peephole.h"
+
+#define PEEPHOLE_MAX_WINDOW 4
+
+/**
+ * Rewrites the window in place, returns the number of the instructions the window is replaced with (or -1 if the rule does not match).
+ */
+typedef int (*PeepholeRewrite)(Instruction **window);
+
+int __Peephole_rewritePushPop(Instruction **window);
+int __Peephole_rewritePushMovePop(Instruction **window);
+int __Peephole_rewriteStackOperation(Instruction **window);
+int __Peephole_rewriteHelperSource(Instruction **window);
+int __Peephole_rewriteHelperResult(Instruction **window);
+int __Peephole_rewriteCompareJump(Instruction **window);
+int __Peephole_rewriteNegatedJump(Instruction **window);
+int __Peephole_rewriteOperandJump(Instruction **window);
+int __Peephole_rewriteJumpNext(Instruction **window);
+
+struct {
+	size_t size;
+	PeepholeRewrite rewrite;
+} __Peephole_rules[PEEPHOLE_RULES_COUNT] = {
+	[PEEPHOLE_PUSH_POP] = {2, __Peephole_rewritePushPop},
+	[PEEPHOLE_PUSH_MOVE_POP] = {3, __Peephole_rewritePushMovePop},
+	[PEEPHOLE_STACK_OPERATION] = {4, __Peephole_rewriteStackOperation},
+	[PEEPHOLE_HELPER_SOURCE] = {2, __Peephole_rewriteHelperSource},
+	[PEEPHOLE_HELPER_RESULT] = {2, __Peephole_rewriteHelperResult},
+	[PEEPHOLE_COMPARE_JUMP] = {3, __Peephole_rewriteCompareJump},
+	[PEEPHOLE_NEGATED_JUMP] = {3, __Peephole_rewriteNegatedJump},
+	[PEEPHOLE_OPERAND_JUMP] = {3, __Peephole_rewriteOperandJump},
+	[PEEPHOLE_JUMP_NEXT] = {2, __Peephole_rewriteJumpNext}
+};
+
+const char *__Peephole_ruleNames[PEEPHOLE_RULES_COUNT] = {
+	[PEEPHOLE_PUSH_POP] = "push_pop",
+	[PEEPHOLE_PUSH_MOVE_POP] = "push_move_pop",
+	[PEEPHOLE_STACK_OPERATION] = "stack_operation",
+	[PEEPHOLE_HELPER_SOURCE] = "helper_source",
+	[PEEPHOLE_HELPER_RESULT] = "helper_result",
+	[PEEPHOLE_COMPARE_JUMP] = "compare_jump",
+	[PEEPHOLE_NEGATED_JUMP] = "negated_jump",
+	[PEEPHOLE_OPERAND_JUMP] = "operand_jump",
+	[PEEPHOLE_JUMP_NEXT] = "jump_next"
+};
+
+void __Peephole_reduce(Peephole *peephole, Array *output);
+size_t __Peephole_countInstructions(Array *instructions);
+bool __Peephole_getWindow(Array *output, Instruction **window, size_t size);
+bool __Peephole_isHelperVariable(Operand *operand);
+bool __Peephole_isPushTrue(Instruction *instruction);
+bool __Peephole_getOperandOpcode(enum Opcode opcode, enum Opcode *outOpcode);
+
+void Peephole_constructor(Peephole *peephole) {
+	assertf(peephole != NULL);
+
+	for(size_t i = 0; i < PEEPHOLE_RULES_COUNT; i++) {
+		peephole->hits[i] = 0;
+	}
+
+	peephole->inputSize = 0;
+	peephole->outputSize = 0;
+}
+
+void Peephole_destructor(Peephole *peephole) {
+	assertf(peephole != NULL);
+}
+
+void Peephole_optimize(Peephole *peephole, InstructionList *list) {
+	assertf(peephole != NULL);
+	assertf(list != NULL);
+
+	Array *output = Array_alloc(list->instructions->size);
+	peephole->inputSize += __Peephole_countInstructions(list->instructions);
+
+	for(size_t i = 0; i < list->instructions->size; i++) {
+		Instruction *instruction = Array_get(list->instructions, i);
+		Array_push(output, instruction);
+
+		if(!is_opcode_pseudo(instruction->opcode)) __Peephole_reduce(peephole, output);
+	}
+
+	Array_free(list->instructions);
+	list->instructions = output;
+	peephole->outputSize += __Peephole_countInstructions(list->instructions);
+}
+
+void Peephole_printStats(Peephole *peephole, FILE *stream) {
+	assertf(peephole != NULL);
+	assertf(stream != NULL);
+
+	fprintf(stream, "peephole: %zu -> %zu instructions\n", peephole->inputSize, peephole->outputSize);
+
+	for(size_t i = 0; i < PEEPHOLE_RULES_COUNT; i++) {
+		fprintf(stream, "  %-16s %zu\n", __Peephole_ruleNames[i], peephole->hits[i]);
+	}
+}
+
+void __Peephole_reduce(Peephole *peephole, Array *output) {
+	Instruction *window[PEEPHOLE_MAX_WINDOW];
+	bool isRewritten = true;
+
+	// The result of a rewrite can be matched again by any of the rules
+	while(isRewritten) {
+		isRewritten = false;
+
+		for(size_t rule = 0; rule < PEEPHOLE_RULES_COUNT && !isRewritten; rule++) {
+			size_t size = __Peephole_rules[rule].size;
+			if(!__Peephole_getWindow(output, window, size)) continue;
+
+			int length = __Peephole_rules[rule].rewrite(window);
+			if(length < 0) continue;
+
+			output->size -= size;
+			for(int i = 0; i < length; i++) {
+				Array_push(output, window[i]);
+			}
+
+			peephole->hits[rule]++;
+			isRewritten = true;
+		}
+	}
+}
+
+size_t __Peephole_countInstructions(Array *instructions) {
+	size_t count = 0;
+
+	for(size_t i = 0; i < instructions->size; i++) {
+		Instruction *instruction = Array_get(instructions, i);
+		if(!is_opcode_pseudo(instruction->opcode)) count++;
+	}
+
+	return count;
+}
+
+bool __Peephole_getWindow(Array *output, Instruction **window, size_t size) {
+	if(output->size < size) return false;
+
+	for(size_t i = 0; i < size; i++) {
+		window[i] = output->data[output->size - size + i];
+		if(is_opcode_pseudo(window[i]->opcode)) return false;
+	}
+
+	return true;
+}
+
+bool __Peephole_isHelperVariable(Operand *operand) {
+	return operand->type == OPERAND_VARIABLE && operand->frame == FRAME_GLOBAL && operand->name && !operand->hasId;
+}
+
+bool __Peephole_isPushTrue(Instruction *instruction) {
+	return instruction->opcode == OPCODE_PUSHS && instruction->operands[0].type == OPERAND_BOOL && instruction->operands[0].value.boolean;
+}
+
+bool __Peephole_getOperandOpcode(enum Opcode opcode, enum Opcode *outOpcode) {
+	switch(opcode) {
+		case OPCODE_ADDS: *outOpcode = OPCODE_ADD; return true;
+		case OPCODE_SUBS: *outOpcode = OPCODE_SUB; return true;
+		case OPCODE_MULS: *outOpcode = OPCODE_MUL; return true;
+		case OPCODE_DIVS: *outOpcode = OPCODE_DIV; return true;
+		case OPCODE_IDIVS: *outOpcode = OPCODE_IDIV; return true;
+		case OPCODE_LTS: *outOpcode = OPCODE_LT; return true;
+		case OPCODE_GTS: *outOpcode = OPCODE_GT; return true;
+		case OPCODE_EQS: *outOpcode = OPCODE_EQ; return true;
+		case OPCODE_ANDS: *outOpcode = OPCODE_AND; return true;
+		case OPCODE_ORS: *outOpcode = OPCODE_OR; return true;
+		default: return false;
+	}
+}
+
+// --- RULES ---
+
+int __Peephole_rewritePushPop(Instruction **window) {
+	Instruction *push = window[0];
+	Instruction *pop = window[1];
+	if(push->opcode != OPCODE_PUSHS || pop->opcode != OPCODE_POPS) return -1;
+
+	// Assigning the variable to itself
+	if(Operand_isSameVariable(&push->operands[0], &pop->operands[0])) return 0;
+
+	push->opcode = OPCODE_MOVE;
+	push->operands[1] = push->operands[0];
+	push->operands[0] = pop->operands[0];
+
+	return 1;
+}
+
+int __Peephole_rewritePushMovePop(Instruction **window) {
+	Instruction *push = window[0];
+	Instruction *move = window[1];
+	Instruction *pop = window[2];
+	if(push->opcode != OPCODE_PUSHS || move->opcode != OPCODE_MOVE || pop->opcode != OPCODE_POPS) return -1;
+
+	// The pushed value would be overwritten before it is popped
+	if(Operand_isSameVariable(&push->operands[0], &move->operands[0])) return -1;
+
+	push->opcode = OPCODE_MOVE;
+	push->operands[1] = push->operands[0];
+	push->operands[0] = pop->operands[0];
+
+	window[0] = move;
+	window[1] = push;
+
+	return 2;
+}
+
+int __Peephole_rewriteStackOperation(Instruction **window) {
+	Instruction *left = window[0];
+	Instruction *right = window[1];
+	Instruction *operation = window[2];
+	Instruction *pop = window[3];
+	if(left->opcode != OPCODE_PUSHS || right->opcode != OPCODE_PUSHS || pop->opcode != OPCODE_POPS) return -1;
+
+	enum Opcode opcode;
+	if(!__Peephole_getOperandOpcode(operation->opcode, &opcode)) return -1;
+
+	operation->opcode = opcode;
+	operation->operands[0] = pop->operands[0];
+	operation->operands[1] = left->operands[0];
+	operation->operands[2] = right->operands[0];
+
+	window[0] = operation;
+
+	return 1;
+}
+
+int __Peephole_rewriteHelperSource(Instruction **window) {
+	Instruction *move = window[0];
+	Instruction *instruction = window[1];
+	if(move->opcode != OPCODE_MOVE || !__Peephole_isHelperVariable(&move->operands[0])) return -1;
+	if(instruction->opcode == OPCODE_DEFVAR) return -1;
+
+	bool isRead = false;
+
+	// The destination of an assignment is not read
+	for(int i = is_opcode_assignment(instruction->opcode) ? 1 : 0; i < INSTRUCTION_MAX_OPERANDS; i++) {
+		if(!Operand_isSameVariable(&instruction->operands[i], &move->operands[0])) continue;
+
+		instruction->operands[i] = move->operands[1];
+		isRead = true;
+	}
+
+	if(!isRead) return -1;
+
+	window[0] = instruction;
+
+	return 1;
+}
+
+int __Peephole_rewriteHelperResult(Instruction **window) {
+	Instruction *instruction = window[0];
+	Instruction *move = window[1];
+	if(move->opcode != OPCODE_MOVE || !__Peephole_isHelperVariable(&move->operands[1])) return -1;
+	if(!is_opcode_assignment(instruction->opcode) || !Operand_isSameVariable(&instruction->operands[0], &move->operands[1])) return -1;
+
+	instruction->operands[0] = move->operands[0];
+
+	return 1;
+}
+
+int __Peephole_rewriteCompareJump(Instruction **window) {
+	Instruction *compare = window[0];
+	Instruction *jump = window[2];
+	if(compare->opcode != OPCODE_EQS || !__Peephole_isPushTrue(window[1])) return -1;
+	if(jump->opcode != OPCODE_JUMPIFEQS && jump->opcode != OPCODE_JUMPIFNEQS) return -1;
+
+	window[0] = jump;
+
+	return 1;
+}
+
+int __Peephole_rewriteNegatedJump(Instruction **window) {
+	Instruction *negation = window[0];
+	Instruction *jump = window[2];
+	if(negation->opcode != OPCODE_NOTS || !__Peephole_isPushTrue(window[1])) return -1;
+	if(jump->opcode != OPCODE_JUMPIFEQS && jump->opcode != OPCODE_JUMPIFNEQS) return -1;
+
+	jump->opcode = jump->opcode == OPCODE_JUMPIFEQS ? OPCODE_JUMPIFNEQS : OPCODE_JUMPIFEQS;
+
+	window[0] = window[1];
+	window[1] = jump;
+
+	return 2;
+}
+
+int __Peephole_rewriteOperandJump(Instruction **window) {
+	Instruction *left = window[0];
+	Instruction *right = window[1];
+	Instruction *jump = window[2];
+	if(left->opcode != OPCODE_PUSHS || right->opcode != OPCODE_PUSHS) return -1;
+	if(jump->opcode != OPCODE_JUMPIFEQS && jump->opcode != OPCODE_JUMPIFNEQS) return -1;
+
+	jump->opcode = jump->opcode == OPCODE_JUMPIFEQS ? OPCODE_JUMPIFEQ : OPCODE_JUMPIFNEQ;
+	jump->operands[1] = left->operands[0];
+	jump->operands[2] = right->operands[0];
+
+	window[0] = jump;
+
+	return 1;
+}
+
+int __Peephole_rewriteJumpNext(Instruction **window) {
+	Instruction *jump = window[0];
+	Instruction *label = window[1];
+	if(jump->opcode != OPCODE_JUMP || label->opcode != OPCODE_LABEL) return -1;
+	if(!Operand_isSameName(&jump->operands[0], &label->operands[0])) return -1;
+
+	window[0] = label;
+
+	return 1;
+}
+
+/** End of file src/compiler/codegen/Peephole.c **/
@@ -17,21 +17,21 @@
 
 bool __Lexer_resolveEscapedChar(char ch, char *out);
 
-LexerResult __Lexer_tokenizeWhitespace(Lexer *lexer);
-LexerResult __Lexer_tokenizeSpace(Lexer *lexer);
-LexerResult __Lexer_tokenizeNewLine(Lexer *lexer);
-LexerResult __Lexer_tokenizeSingleLineComment(Lexer *lexer);
-LexerResult __Lexer_tokenizeMultiLineComment(Lexer *lexer);
-
-LexerResult __Lexer_tokenizeString(Lexer *lexer);
-LexerResult __Lexer_tokenizeIdentifier(Lexer *lexer);
-LexerResult __Lexer_tokenizeNumberLiteral(Lexer *lexer);
-LexerResult __Lexer_tokenizeIntegerBasedLiteral(Lexer *lexer, int base);
-LexerResult __Lexer_tokenizeBinaryLiteral(Lexer *lexer);
-LexerResult __Lexer_tokenizeOctalLiteral(Lexer *lexer);
-LexerResult __Lexer_tokenizeHexadecimalLiteral(Lexer *lexer);
-LexerResult __Lexer_tokenizeDecimalLiteral(Lexer *lexer);
-LexerResult __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer);
+enum ResultType __Lexer_tokenizeWhitespace(Lexer *lexer);
+enum ResultType __Lexer_tokenizeSpace(Lexer *lexer);
+enum ResultType __Lexer_tokenizeNewLine(Lexer *lexer);
+enum ResultType __Lexer_tokenizeSingleLineComment(Lexer *lexer);
+enum ResultType __Lexer_tokenizeMultiLineComment(Lexer *lexer);
+
+enum ResultType __Lexer_tokenizeString(Lexer *lexer);
+enum ResultType __Lexer_tokenizeIdentifier(Lexer *lexer);
+enum ResultType __Lexer_tokenizeNumberLiteral(Lexer *lexer);
+enum ResultType __Lexer_tokenizeIntegerBasedLiteral(Lexer *lexer, int base);
+enum ResultType __Lexer_tokenizeBinaryLiteral(Lexer *lexer);
+enum ResultType __Lexer_tokenizeOctalLiteral(Lexer *lexer);
+enum ResultType __Lexer_tokenizeHexadecimalLiteral(Lexer *lexer);
+enum ResultType __Lexer_tokenizeDecimalLiteral(Lexer *lexer);
+enum ResultType __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer);
 
 void Lexer_constructor(Lexer *lexer) {
 	if(!lexer) return;
@@ -44,6 +44,7 @@ void Lexer_constructor(Lexer *lexer) {
 	lexer->line = 1;
 	lexer->column = 1;
 	lexer->whitespace = WHITESPACE_NONE;
+	lexer->error = LexerSuccess();
 }
 
 void Lexer_destructor(Lexer *lexer) {
@@ -134,13 +135,20 @@ bool Lexer_isAtEnd(Lexer *lexer) {
 #define is_identifier_start(ch) ((ch) == '_' || is_alpha(ch))
 #define is_identifier_part(ch) (is_identifier_start(ch) || is_decimal_digit(ch))
 
-#define fetch_next_whitespace(lexer) enum WhitespaceType __wh_bit = lexer->whitespace; LexerResult __wh_res = __Lexer_tokenizeWhitespace(lexer); if(!__wh_res.success) return __wh_res; __wh_bit |= left_to_right_whitespace(lexer->whitespace);
+// Whitespace is skipped between every two tokens, so the scanners only return the result type and the details of an error are left in `lexer->error`
+// The same holds for the token scanners, only `Lexer_nextToken` and `Lexer_peekToken` build a full result out of it
+#define is_scan_error(type) ((type) != RESULT_SUCCESS && (type) != RESULT_NO_MATCH)
+
+#define LexerFail(message, markers) (lexer->error = LexerError(message, markers), lexer->error.type)
+#define LexerFailCustom(resultType, message, markers) (lexer->error = LexerErrorCustom(resultType, message, markers), lexer->error.type)
+
+#define fetch_next_whitespace(lexer) enum WhitespaceType __wh_bit = lexer->whitespace; enum ResultType __wh_res = __Lexer_tokenizeWhitespace(lexer); if(is_scan_error(__wh_res)) return __wh_res; __wh_bit |= left_to_right_whitespace(lexer->whitespace);
 
 #define ERROR_MARKER(from, to) Array_fromArgs(1, Token_alloc(TOKEN_MARKER, TOKEN_CARET, WHITESPACE_NONE, TextRange_construct(lexer->currentChar, lexer->currentChar + 1, lexer->line, lexer->column), (union TokenValue){0}))
 
-LexerResult __Lexer_tokenizeWhitespace(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeWhitespace(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
 	// enum WhitespaceType prev = lexer->whitespace;       // Save previous ws in case of no match
 
@@ -149,27 +157,27 @@ LexerResult __Lexer_tokenizeWhitespace(Lexer *lexer) {
 
 	bool matched = false;
 	bool hasMatch = false;
-	LexerResult res;
+	enum ResultType res;
 
 	do {
 		matched = false;
 
 		res = __Lexer_tokenizeSpace(lexer);
-		if(!res.success) return res;
-		if(res.type != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
+		if(is_scan_error(res)) return res;
+		if(res != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
 		// TODO: Free the results here
 
 		res = __Lexer_tokenizeNewLine(lexer);
-		if(!res.success) return res;
-		if(res.type != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
+		if(is_scan_error(res)) return res;
+		if(res != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
 
 		res = __Lexer_tokenizeSingleLineComment(lexer);
-		if(!res.success) return res;
-		if(res.type != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
+		if(is_scan_error(res)) return res;
+		if(res != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
 
 		res = __Lexer_tokenizeMultiLineComment(lexer);
-		if(!res.success) return res;
-		if(res.type != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
+		if(is_scan_error(res)) return res;
+		if(res != RESULT_NO_MATCH) whitespace = max(whitespace, lexer->whitespace & WHITESPACE_MASK_LEFT), matched = true;
 
 		hasMatch |= matched;
 	} while(matched);
@@ -177,16 +185,16 @@ LexerResult __Lexer_tokenizeWhitespace(Lexer *lexer) {
 	// lexer->whitespace = hasMatch ? whitespace : prev;
 	lexer->whitespace = whitespace;
 
-	return hasMatch ? LexerSuccess() : LexerNoMatch();
+	return hasMatch ? RESULT_SUCCESS : RESULT_NO_MATCH;
 }
 
-LexerResult __Lexer_tokenizeSpace(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeSpace(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
 	char ch = *lexer->currentChar;
 
-	if(!is_space_like(ch)) return LexerNoMatch();
+	if(!is_space_like(ch)) return RESULT_NO_MATCH;
 
 	while((ch = *lexer->currentChar) && is_space_like(ch)) {
 		Lexer_advance(lexer);
@@ -194,16 +202,16 @@ LexerResult __Lexer_tokenizeSpace(Lexer *lexer) {
 
 	lexer->whitespace = WHITESPACE_LEFT_SPACE;
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
-LexerResult __Lexer_tokenizeNewLine(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeNewLine(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
 	char ch = *lexer->currentChar;
 
-	if(!is_newline(ch)) return LexerNoMatch();
+	if(!is_newline(ch)) return RESULT_NO_MATCH;
 
 	while((ch = *lexer->currentChar) && is_newline(ch)) {
 		Lexer_advance(lexer);
@@ -211,14 +219,14 @@ LexerResult __Lexer_tokenizeNewLine(Lexer *lexer) {
 
 	lexer->whitespace = WHITESPACE_LEFT_NEWLINE;
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
-LexerResult __Lexer_tokenizeSingleLineComment(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeSingleLineComment(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
-	if(!is_single_line_comment(lexer)) return LexerNoMatch();
+	if(!is_single_line_comment(lexer)) return RESULT_NO_MATCH;
 
 	while(!Lexer_isAtEnd(lexer) && !Lexer_match(lexer, "\n")) {
 		Lexer_advance(lexer);
@@ -226,15 +234,15 @@ LexerResult __Lexer_tokenizeSingleLineComment(Lexer *lexer) {
 
 	lexer->whitespace = WHITESPACE_LEFT_NEWLINE;
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
-LexerResult __Lexer_tokenizeMultiLineComment(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeMultiLineComment(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
-	if(!is_multi_line_comment_start(lexer)) return LexerNoMatch();
-	// if(!is_multi_line_comment(lexer)) return LexerNoMatch();
+	if(!is_multi_line_comment_start(lexer)) return RESULT_NO_MATCH;
+	// if(!is_multi_line_comment(lexer)) return RESULT_NO_MATCH;
 	// if(is_multi_line_comment_end(lexer)) return LexerError(
 	// 		String_fromFormat("unexpected end of block comment"),
 	// 		ERROR_MARKER(0, 1)
@@ -257,14 +265,16 @@ LexerResult __Lexer_tokenizeMultiLineComment(Lexer *lexer) {
 	}
 
 	// There are still comments left
-	if(depth != 0) return LexerError(
+	if(depth != 0) {
+		return LexerFail(
 			String_fromFormat("unterminated '/*' comment"),
 			ERROR_MARKER(0, 1)
-	);
+		);
+	}
 
 	lexer->whitespace = whitespace;
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
 
@@ -284,8 +294,10 @@ void Lexer_setSource(Lexer *lexer, char *source) {
 Token* Lexer_getUpcomingToken(Lexer *lexer) {
 	assertf(lexer != NULL);
 
-	Token *token = Array_get(lexer->tokens, lexer->currentTokenIndex + 1);
-	if(!token) return NULL;
+	size_t index = lexer->currentTokenIndex + 1;
+	if(index >= lexer->tokens->size) return NULL;
+
+	Token *token = lexer->tokens->data[index];
 
 	// Move to the next token
 	lexer->currentTokenIndex++;
@@ -293,7 +305,7 @@ Token* Lexer_getUpcomingToken(Lexer *lexer) {
 	return token;
 }
 
-LexerResult Lexer_tokenizeNextToken(Lexer *lexer) {
+enum ResultType Lexer_tokenizeNextToken(Lexer *lexer) {
 	assertf(lexer != NULL);
 
 	char ch = *lexer->currentChar;
@@ -310,11 +322,11 @@ LexerResult Lexer_tokenizeNextToken(Lexer *lexer) {
 	{
 		enum WhitespaceType prev = lexer->whitespace;               // Save previous ws in case of no match
 
-		LexerResult res = __Lexer_tokenizeWhitespace(lexer);
-		if(!res.success) return res;
+		enum ResultType res = __Lexer_tokenizeWhitespace(lexer);
+		if(is_scan_error(res)) return res;
 
 		// Some whitespace matched
-		if(res.type != RESULT_NO_MATCH) return Lexer_tokenizeNextToken(lexer);
+		if(res != RESULT_NO_MATCH) return Lexer_tokenizeNextToken(lexer);
 
 		lexer->whitespace = prev;
 	}
@@ -332,7 +344,7 @@ LexerResult Lexer_tokenizeNextToken(Lexer *lexer) {
 
 		Array_push(lexer->tokens, token);
 
-		return LexerSuccess();
+		return RESULT_SUCCESS;
 	}
 	// Match string literals
 	else if(ch == '"') {
@@ -352,11 +364,11 @@ LexerResult Lexer_tokenizeNextToken(Lexer *lexer) {
 	// Something other
 	else {
 		// Try to match punctuators and operators
-		LexerResult result = __Lexer_tokenizePunctuatorsAndOperators(lexer);
-		if(result.success && result.type != RESULT_NO_MATCH) return result;
+		enum ResultType res = __Lexer_tokenizePunctuatorsAndOperators(lexer);
+		if(res != RESULT_NO_MATCH) return res;
 
 		// Invalid character
-		return LexerError(
+		return LexerFail(
 			String_fromFormat("unexpected token '%s'", format_char(ch)),
 			ERROR_MARKER(0, 1)
 		);
@@ -364,80 +376,77 @@ LexerResult Lexer_tokenizeNextToken(Lexer *lexer) {
 }
 
 LexerResult Lexer_nextToken(Lexer *lexer) {
+	Token *token = Lexer_next(lexer);
+	if(!token) return lexer->error;
+
+	LexerResult result = LexerSuccess();
+	result.token = token;
+	return result;
+}
+
+Token* Lexer_next(Lexer *lexer) {
 	assertf(lexer != NULL);
 	assertf(lexer->source != NULL, "Cannot process the next token: No source set");
 
 	// If there are already processed tokens, return the next one
-	Token *cachedToken = Lexer_getUpcomingToken(lexer);
-	if(cachedToken) {
-		LexerResult result = LexerSuccess();
-		result.token = cachedToken;
-		return result;
-	}
+	Token *token = Lexer_getUpcomingToken(lexer);
+	if(token) return token;
 
 	// Otherwise tokenize the next token
-	LexerResult result = Lexer_tokenizeNextToken(lexer);
-	if(!result.success) return result;
+	enum ResultType res = Lexer_tokenizeNextToken(lexer);
+	if(is_scan_error(res)) return NULL;
 
-	// Return the result with token
-	result.token = Lexer_getUpcomingToken(lexer);
-	if(!result.token) {
+	token = Lexer_getUpcomingToken(lexer);
+	if(!token) {
 		warnf("The tokenization resulted in no tokens, trying to tokenize the next one");
-		return Lexer_nextToken(lexer);
+		return Lexer_next(lexer);
 	}
 
-	return result;
+	return token;
 }
 
 LexerResult Lexer_peekToken(Lexer *lexer, int offset) {
 	assertf(lexer != NULL);
 
-	int index = lexer->currentTokenIndex + offset;
-
-	// If there are no tokens yet, move the index to the first one
-	// EDIT: This is would always skip the first token, which is incorrect
-	// if(lexer->currentTokenIndex == -1) index++;
-
 	// Peeking before the start of the token stream
-	if(index < 0) {
+	if(lexer->currentTokenIndex + offset < 0) {
 		LexerResult result = LexerSuccess();
 		result.token = NULL;
 		warnf("Peeking before the start of the token stream, returning NULL");
 		return result;
 	}
 
-	// Peeking before the end of the token stream
-	if(offset < 0) {
-		LexerResult result = LexerSuccess();
-		result.token = Array_get(lexer->tokens, index);
-		return result;
-	}
+	Token *token = Lexer_peek(lexer, offset);
+	if(!token) return lexer->error;
 
-	// Peeking at the end of the token stream (or after the token stream)
-	Token *token = Array_get(lexer->tokens, index);
-	if(token) {
-		LexerResult result = LexerSuccess();
-		result.token = token;
-		return result;
-	}
-
-	// Save current index for backtracking (since peeking should not consume the tokens)
-	size_t backtrack = lexer->currentTokenIndex;
-
-	// Peeking after the end of the token stream
 	LexerResult result = LexerSuccess();
-	while((result = Lexer_nextToken(lexer)).token && result.token->type != TOKEN_EOF) {
-		// If the target token is found, return it
-		if(lexer->currentTokenIndex == index) return (lexer->currentTokenIndex = backtrack), result;
-	}
+	result.token = token;
+	return result;
+}
 
-	lexer->currentTokenIndex = backtrack;
+Token* Lexer_peek(Lexer *lexer, int offset) {
+	assertf(lexer != NULL);
 
-	// Exit if something fails
-	if(!result.success) return result;
+	int index = lexer->currentTokenIndex + offset;
+	Array *tokens = lexer->tokens;
+
+	// Already processed tokens are read directly (negative index wraps around and fails the check)
+	if((size_t)index < tokens->size) return tokens->data[index];
+	if(index < 0) return NULL;
+
+	// Tokenize ahead, the position in the token stream is not changed,
+	// so the tokens will be consumed by `Lexer_nextToken` later
+	while((size_t)index >= tokens->size) {
+		// Peeking after the end of the token stream always results in EOF token
+		if(tokens->size > 0 && ((Token*)tokens->data[tokens->size - 1])->type == TOKEN_EOF) {
+			return tokens->data[tokens->size - 1];
+		}
 
-	// This will be always an EOF token
-	return result;
+		enum ResultType res = Lexer_tokenizeNextToken(lexer);
+		if(is_scan_error(res)) return NULL;
+	}
+
+	return tokens->data[index];
 }
 
 LexerResult Lexer_tokenize(Lexer *lexer, char *source) {
@@ -462,9 +471,9 @@ LexerResult Lexer_tokenize(Lexer *lexer, char *source) {
 	return LexerSuccess();
 }
 
-LexerResult __Lexer_tokenizeUntilStringInterpolationTerminator(Lexer *lexer) {
-	if(!lexer) return LexerNoMatch();
-	if(!lexer->currentChar) return LexerNoMatch();
+enum ResultType __Lexer_tokenizeUntilStringInterpolationTerminator(Lexer *lexer) {
+	if(!lexer) return RESULT_NO_MATCH;
+	if(!lexer->currentChar) return RESULT_NO_MATCH;
 
 	// Keep track of the depth in case of nested parentheses
 	// 1 - the initial string interpolation parenthesis to match with the closing one
@@ -477,17 +486,17 @@ LexerResult __Lexer_tokenizeUntilStringInterpolationTerminator(Lexer *lexer) {
 	}
 
 	// While there are tokens to process
-	LexerResult result = LexerSuccess();
+	enum ResultType res = RESULT_SUCCESS;
 
 	do {
-		result = Lexer_tokenizeNextToken(lexer);
-		if(!result.success) return result;
+		res = Lexer_tokenizeNextToken(lexer);
+		if(is_scan_error(res)) return res;
 
 		// Get the token at the top of the token stream
 		Token *token = Array_get(lexer->tokens, -1);
 
 		// If the token is an EOF, the interpolation is not terminated
-		if(token->type == TOKEN_EOF) return LexerError(
+		if(token->type == TOKEN_EOF) return LexerFail(
 				String_fromFormat("cannot find ')' to match opening '(' in string interpolation"),
 				ERROR_MARKER(0, 1)
 		);
@@ -506,7 +515,7 @@ LexerResult __Lexer_tokenizeUntilStringInterpolationTerminator(Lexer *lexer) {
 	// Consume the closing parenthesis
 	Lexer_advance(lexer);
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
 bool __Lexer_resolveEscapedChar(char ch, char *out) {
@@ -525,9 +534,9 @@ bool __Lexer_resolveEscapedChar(char ch, char *out) {
 	return true;
 }
 
-LexerResult __Lexer_parseUnicodeEscapeSequence(Lexer *lexer, char *out) {
+enum ResultType __Lexer_parseUnicodeEscapeSequence(Lexer *lexer, char *out) {
 	// Consume the opening brace
-	if(!Lexer_match(lexer, "{")) return LexerError(
+	if(!Lexer_match(lexer, "{")) return LexerFail(
 			String_fromFormat("expected hexadecimal code in braces after unicode escape"),
 			ERROR_MARKER(0, 1)
 	);
@@ -538,14 +547,14 @@ LexerResult __Lexer_parseUnicodeEscapeSequence(Lexer *lexer, char *out) {
 	long code = strtol(lexer->currentChar, &end, 16);
 
 	// Check if the code is valid
-	if(!end || code < 0 || code > 0x10FFFF) return LexerError(
+	if(!end || code < 0 || code > 0x10FFFF) return LexerFail(
 			String_fromFormat("invalid unicode scalar '%d'", code),
 			ERROR_MARKER(0, 1)
 	);
 
 	// Check for length of the code
 	size_t length = end - lexer->currentChar;
-	if(length < 1 || length > 8) return LexerError(
+	if(length < 1 || length > 8) return LexerFail(
 			String_fromFormat("\\u{...} escape sequence expects between 1 and 8 hex digits"),
 			ERROR_MARKER(0, 1)
 	);
@@ -554,7 +563,7 @@ LexerResult __Lexer_parseUnicodeEscapeSequence(Lexer *lexer, char *out) {
 	lexer->currentChar = end;
 
 	// Check for the closing brace
-	if(!Lexer_match(lexer, "}")) return LexerError(
+	if(!Lexer_match(lexer, "}")) return LexerFail(
 			String_fromFormat("expected closing brace '}' after unicode escape"),
 			ERROR_MARKER(0, 1)
 	);
@@ -563,10 +572,10 @@ LexerResult __Lexer_parseUnicodeEscapeSequence(Lexer *lexer, char *out) {
 	// NOTICE: This will only work for values in range 0-255
 	*out = code;
 
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
-LexerResult __Lexer_tokenizeString(Lexer *lexer) {
+enum ResultType __Lexer_tokenizeString(Lexer *lexer) {
 	char *start = lexer->currentChar;
 	char ch = *lexer->currentChar;
 
@@ -586,7 +595,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 	while(isMultiline ? !Lexer_match(lexer, ML_QUOTE) : ch != '"') {
 		// Handle unterminated string literals
 		if(ch == '\0' || (ch == '\n' && !isMultiline)) {
-			return LexerError(
+			return LexerFail(
 				String_fromFormat("unterminated string literal"),
 				ERROR_MARKER(0, 1)
 			);
@@ -594,7 +603,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 
 		// Handle unprintable characters
 		if(!isMultiline && (ch < 0x20 || ch == 0x7F)) {
-			return LexerError(
+			return LexerFail(
 				String_fromFormat("unprintable ASCII character '%s' in string literal", format_char(ch)),
 				ERROR_MARKER(0, 1)
 			);
@@ -612,9 +621,9 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 				Lexer_advance(lexer);
 
 				char escaped = '\0';
-				LexerResult res = __Lexer_parseUnicodeEscapeSequence(lexer, &escaped);
+				enum ResultType res = __Lexer_parseUnicodeEscapeSequence(lexer, &escaped);
 
-				if(!res.success) return res;
+				if(is_scan_error(res)) return res;
 
 				String_appendChar(string, escaped);
 				lexer->currentChar--; // Go back one character
@@ -654,8 +663,8 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 					// Consume the opening paren
 					Lexer_advance(lexer);
 
-					LexerResult res = __Lexer_tokenizeUntilStringInterpolationTerminator(lexer);
-					if(!res.success) return res;
+					enum ResultType res = __Lexer_tokenizeUntilStringInterpolationTerminator(lexer);
+					if(is_scan_error(res)) return res;
 
 					lexer->currentChar--; // Go back one character
 				}
@@ -685,7 +694,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 				bool res = __Lexer_resolveEscapedChar(toEscape, &escaped);
 
 				if(!res) {
-					return LexerError(
+					return LexerFail(
 						String_fromFormat("invalid escape sequence '\\%s' in literal", format_char(toEscape)),
 						ERROR_MARKER(0, 1)
 					);
@@ -716,7 +725,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 
 		// Check for empty first line
 		if(firstLine->length != 0 || lines->size == 0) {
-			return LexerError(
+			return LexerFail(
 				String_fromFormat("multi-line string literal content must begin on a new line"),
 				ERROR_MARKER(0, 1)
 			);
@@ -731,7 +740,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 			char ch = String_charAt(lastLine, i);
 
 			if(!is_space_like(ch)) {
-				return LexerError(
+				return LexerFail(
 					String_fromFormat("multi-line string literal closing delimiter must begin on a new line"),
 					ERROR_MARKER(0, 1)
 				);
@@ -745,7 +754,7 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 
 			// Check for valid indentation
 			if(line->length != 0 && !String_startsWith(line, lastLine->value)) {
-				return LexerError(
+				return LexerFail(
 					String_fromFormat("insufficient indentation of line in multi-line string literal"),
 					ERROR_MARKER(0, 1)
 				);
@@ -781,12 +790,12 @@ LexerResult __Lexer_tokenizeString(Lexer *lexer) {
 
 	// Add the token to the array
 	Array_push(lexer->tokens, token);
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 
 	#undef ML_QUOTE
 }
 
-LexerResult __Lexer_tokenizeIdentifier(Lexer *lexer) {
+enum ResultType __Lexer_tokenizeIdentifier(Lexer *lexer) {
 	char *start = lexer->currentChar;
 	char ch = *lexer->currentChar;
 
@@ -842,10 +851,10 @@ LexerResult __Lexer_tokenizeIdentifier(Lexer *lexer) {
 
 	// Add the token to the array
 	Array_push(lexer->tokens, token);
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
-LexerResult __Lexer_tokenizeNumberLiteral(Lexer *lexer) {
+enum ResultType __Lexer_tokenizeNumberLiteral(Lexer *lexer) {
 	// if(Lexer_compare(lexer, "0b")) return __Lexer_tokenizeBinaryLiteral(lexer);
 	// if(Lexer_compare(lexer, "0o")) return __Lexer_tokenizeOctalLiteral(lexer);
 	// if(Lexer_compare(lexer, "0x")) return __Lexer_tokenizeHexadecimalLiteral(lexer);
@@ -853,7 +862,7 @@ LexerResult __Lexer_tokenizeNumberLiteral(Lexer *lexer) {
 	return __Lexer_tokenizeDecimalLiteral(lexer);
 }
 
-LexerResult __Lexer_tokenizeDecimalLiteral(Lexer *lexer) {
+enum ResultType __Lexer_tokenizeDecimalLiteral(Lexer *lexer) {
 	char *start = lexer->currentChar;
 	char ch = *lexer->currentChar;
 
@@ -880,13 +889,13 @@ LexerResult __Lexer_tokenizeDecimalLiteral(Lexer *lexer) {
 			if(Lexer_compare(lexer, "...") || Lexer_compare(lexer, "..<")) break;
 
 			if(hasDot) {
-				return LexerError(
+				return LexerFail(
 					String_fromFormat("number literal can only contain one floating point dot '.'"),
 					ERROR_MARKER(0, 1)
 				);
 			}
 
-			if(!is_decimal_digit(Lexer_peekChar(lexer, 1))) return LexerError(
+			if(!is_decimal_digit(Lexer_peekChar(lexer, 1))) return LexerFail(
 					String_fromFormat("invalid character in floating point literal after '.'"),
 					ERROR_MARKER(0, 1)
 			);
@@ -905,7 +914,7 @@ LexerResult __Lexer_tokenizeDecimalLiteral(Lexer *lexer) {
 			if(ch == '+' || ch == '-') ch = Lexer_advance(lexer);       // Consume the sign character if present
 
 			// Missing exponent
-			if(!is_decimal_digit(ch)) return LexerErrorCustom(
+			if(!is_decimal_digit(ch)) return LexerFailCustom(
 					RESULT_ERROR_SYNTACTIC_ANALYSIS,
 					String_fromFormat("expected a digit in floating point exponent"),
 					ERROR_MARKER(0, 1)
@@ -934,11 +943,11 @@ LexerResult __Lexer_tokenizeDecimalLiteral(Lexer *lexer) {
 
 	// Add the token to the array
 	Array_push(lexer->tokens, token);
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
 
-LexerResult __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer) {
+enum ResultType __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer) {
 	char *start = lexer->currentChar;
 
 	enum TokenType type = TOKEN_INVALID;
@@ -974,7 +983,7 @@ LexerResult __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer) {
 	else match_as("=", TOKEN_PUNCTUATOR, TOKEN_EQUAL);
 	else match_as("?", TOKEN_PUNCTUATOR, TOKEN_QUESTION);
 	else match_as("!", TOKEN_PUNCTUATOR, TOKEN_EXCLAMATION);
-	else return LexerNoMatch();
+	else return RESULT_NO_MATCH;
 
 	#undef match_as
 
@@ -989,7 +998,7 @@ LexerResult __Lexer_tokenizePunctuatorsAndOperators(Lexer *lexer) {
 
 	// Add the token to the array
 	Array_push(lexer->tokens, token);
-	return LexerSuccess();
+	return RESULT_SUCCESS;
 }
 
 
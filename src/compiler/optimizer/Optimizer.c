@@ -0,0 +1,1805 @@
+/**
+ * @file src/compiler/optimizer/Optimizer.c
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Optimization passes over the analysed AST.
+ * @copyright Copyright (c) 2023
+ */
+
+#include "compiler/optimizer/Optimizer.h"
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+#include "assertf.h"
+#include "allocator/MemoryAllocator.h"
+#include "internal/Array.h"
+#include "internal/BitSet.h"
+#include "internal/CallStack.h"
+#include "internal/String.h"
+
+
+/* Register private functions */
+
+void __Optimizer_optimizeBlock(Optimizer *optimizer, BlockASTNode *block);
+void __Optimizer_optimizeStatement(Optimizer *optimizer, StatementASTNode *statement);
+void __Optimizer_optimizeIfStatement(Optimizer *optimizer, IfStatementASTNode *ifStatement);
+ASTNode* __Optimizer_optimizeTest(Optimizer *optimizer, ASTNode *test);
+ExpressionASTNode* __Optimizer_foldExpression(Optimizer *optimizer, ExpressionASTNode *expression);
+ExpressionASTNode* __Optimizer_foldIdentifier(Optimizer *optimizer, IdentifierASTNode *identifier);
+ExpressionASTNode* __Optimizer_foldUnaryExpression(Optimizer *optimizer, UnaryExpressionASTNode *unary);
+ExpressionASTNode* __Optimizer_foldBinaryExpression(Optimizer *optimizer, BinaryExpressionASTNode *binary);
+bool __Optimizer_evaluateArithmetic(OperatorType operator, enum BuiltInType type, union TokenValue left, union TokenValue right, union TokenValue *outValue);
+bool __Optimizer_compareLiterals(LiteralExpressionASTNode *left, LiteralExpressionASTNode *right, int *outOrder);
+LiteralExpressionASTNode* __Optimizer_createLiteral(enum BuiltInType type, union TokenValue value);
+void __Optimizer_eliminateDeadStatements(BlockASTNode *block);
+ASTNode* __Optimizer_resolveBranch(ASTNode *node);
+bool __Optimizer_isTerminator(ASTNode *statement);
+void __Optimizer_eliminateUnusedDeclarations(Optimizer *optimizer);
+void __Optimizer_markReachable(Optimizer *optimizer, Array /*<ASTNode>*/ *worklist, Array /*<FunctionDeclaration>*/ *outFunctions, Array /*<VariableDeclarationASTNode>*/ *outDeclarations);
+void __Optimizer_markVariableUsed(Optimizer *optimizer, size_t id);
+void __Optimizer_removeUnusedVariables(Array /*<VariableDeclaration>*/ *variables);
+bool __Optimizer_hasSideEffects(Optimizer *optimizer, ExpressionASTNode *expression);
+FunctionDeclaration* __Optimizer_getInlinableFunction(Optimizer *optimizer, FunctionCallASTNode *call);
+ExpressionASTNode* __Optimizer_inlineCall(Optimizer *optimizer, FunctionCallASTNode *call);
+Array /*<StatementASTNode> | null*/* __Optimizer_inlineStatement(Optimizer *optimizer, StatementASTNode *statement);
+VariableDeclaratorASTNode* __Optimizer_declareInlinedVariable(Optimizer *optimizer, VariableDeclaration *original, bool isConstant, ExpressionASTNode *initializer, Array /*<InlinedVariable>*/ *variables);
+StatementASTNode* __Optimizer_cloneStatement(Optimizer *optimizer, StatementASTNode *statement, Array /*<InlinedVariable>*/ *variables);
+ExpressionASTNode* __Optimizer_cloneExpression(ExpressionASTNode *expression, Array /*<InlinedVariable> | null*/ *variables);
+void __Optimizer_freeInlinedVariables(Array /*<InlinedVariable>*/ *variables);
+size_t __Optimizer_measure(ASTNode *node, size_t limit);
+size_t __Optimizer_countUses(ExpressionASTNode *expression, size_t id);
+bool __Optimizer_mayModifyVariables(Optimizer *optimizer, ExpressionASTNode *expression);
+bool __Optimizer_readsMutableGlobals(Optimizer *optimizer, ExpressionASTNode *expression);
+void __Optimizer_pushOperands(Array /*<ExpressionASTNode>*/ *worklist, ExpressionASTNode *expression);
+Array /*<StatementASTNode> | null*/* __Optimizer_hoistInvariants(Optimizer *optimizer, StatementASTNode *statement);
+bool __Optimizer_collectLoop(StatementASTNode *loop, LoopScope *scope, Array /*<ExpressionASTNode*>*/ *outSlots);
+void __Optimizer_collectTest(ASTNode **test, LoopScope *scope, Array /*<ExpressionASTNode*>*/ *outSlots);
+void __Optimizer_reduceInductions(Optimizer *optimizer, ForStatementASTNode *forStatement, Array /*<ExpressionASTNode*>*/ *slots, LoopScope *scope);
+bool __Optimizer_matchInduction(ExpressionASTNode *expression, size_t iteratorId, size_t depth, long *outScale, long *outOffset);
+IdentifierASTNode* __Optimizer_getInduction(Optimizer *optimizer, ForStatementASTNode *forStatement, long scale, long offset, LoopScope *scope);
+void __Optimizer_hoistExpression(Optimizer *optimizer, ExpressionASTNode **slot, LoopScope *scope);
+void __Optimizer_hoistInvariant(Optimizer *optimizer, ExpressionASTNode **slot, LoopScope *scope);
+bool __Optimizer_isInvariantOperation(Optimizer *optimizer, ExpressionASTNode *expression, LoopScope *scope);
+ValueType __Optimizer_getExpressionType(Optimizer *optimizer, ExpressionASTNode *expression);
+void __Optimizer_registerVariable(Optimizer *optimizer, VariableDeclaration *declaration);
+void __Optimizer_pushOperandSlots(Array /*<ExpressionASTNode*>*/ *worklist, ExpressionASTNode *expression);
+void __Optimizer_optimizeBlock_extended(void *context);
+void __Optimizer_foldExpression_extended(void *context);
+
+
+/* Definitions of public functions */
+
+void Optimizer_constructor(Optimizer *optimizer, Analyser *analyser) {
+	assertf(optimizer != NULL);
+	assertf(analyser != NULL);
+
+	optimizer->analyser = analyser;
+	optimizer->function = NULL;
+	optimizer->inlining = Array_alloc(OPTIMIZER_INLINE_DEPTH);
+}
+
+void Optimizer_destructor(Optimizer *optimizer) {
+	assertf(optimizer != NULL);
+
+	optimizer->analyser = NULL;
+	optimizer->function = NULL;
+
+	Array_free(optimizer->inlining);
+	optimizer->inlining = NULL;
+}
+
+void Optimizer_optimize(Optimizer *optimizer) {
+	assertf(optimizer != NULL);
+	assertf(optimizer->analyser != NULL);
+	assertf(optimizer->analyser->ast != NULL);
+
+	// Global code goes first, so the global constants used in the function bodies are already folded
+	__Optimizer_optimizeBlock(optimizer, optimizer->analyser->ast->block);
+
+	Array *functions = optimizer->analyser->functions;
+
+	for(size_t i = 0; i < functions->size; i++) {
+		FunctionDeclaration *function = Array_get(functions, i);
+		if(!is_func_generable(function->node->builtin)) continue;
+
+		optimizer->function = function;
+		__Optimizer_optimizeBlock(optimizer, function->node->body);
+	}
+
+	optimizer->function = NULL;
+
+	__Optimizer_eliminateUnusedDeclarations(optimizer);
+}
+
+
+/* Definitions of private functions */
+
+void __Optimizer_optimizeBlock(Optimizer *optimizer, BlockASTNode *block) {
+	// Continue on a new stack segment, deeply nested blocks would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		OptimizerCall call = {.optimizer = optimizer, .node = (ASTNode*)block};
+		CallStack_extend(__Optimizer_optimizeBlock_extended, &call);
+		return;
+	}
+
+	Array *statements = block->statements;
+	Array /*<StatementASTNode> | null*/ *expanded = NULL; // Created once the first statement is replaced
+
+	for(size_t i = 0; i < statements->size; i++) {
+		StatementASTNode *statement = Array_get(statements, i);
+		__Optimizer_optimizeStatement(optimizer, statement);
+
+		// Inlined calls and hoisted loop invariants are placed in front of the statement
+		Array *replacement = __Optimizer_inlineStatement(optimizer, statement);
+		if(!replacement) replacement = __Optimizer_hoistInvariants(optimizer, statement);
+		if(!expanded && !replacement) continue;
+
+		if(!expanded) {
+			expanded = Array_alloc(statements->size);
+			for(size_t j = 0; j < i; j++) Array_push(expanded, Array_get(statements, j));
+		}
+
+		if(!replacement) {
+			Array_push(expanded, statement);
+			continue;
+		}
+
+		for(size_t j = 0; j < replacement->size; j++) Array_push(expanded, Array_get(replacement, j));
+		Array_free(replacement);
+	}
+
+	if(expanded) {
+		Array_free(statements);
+		block->statements = expanded;
+	}
+
+	__Optimizer_eliminateDeadStatements(block);
+}
+
+void __Optimizer_optimizeStatement(Optimizer *optimizer, StatementASTNode *statement) {
+	switch(statement->_type) {
+		case NODE_VARIABLE_DECLARATION: {
+			VariableDeclarationASTNode *declaration = (VariableDeclarationASTNode*)statement;
+			Array *declarators = declaration->declaratorList->declarators;
+
+			for(size_t i = 0; i < declarators->size; i++) {
+				VariableDeclaratorASTNode *declarator = Array_get(declarators, i);
+				if(!declarator->initializer) continue;
+
+				declarator->initializer = __Optimizer_foldExpression(optimizer, declarator->initializer);
+			}
+		} break;
+
+		case NODE_ASSIGNMENT_STATEMENT: {
+			AssignmentStatementASTNode *assignment = (AssignmentStatementASTNode*)statement;
+			assignment->expression = __Optimizer_foldExpression(optimizer, assignment->expression);
+		} break;
+
+		case NODE_EXPRESSION_STATEMENT: {
+			ExpressionStatementASTNode *expressionStatement = (ExpressionStatementASTNode*)statement;
+			expressionStatement->expression = __Optimizer_foldExpression(optimizer, expressionStatement->expression);
+		} break;
+
+		case NODE_RETURN_STATEMENT: {
+			ReturnStatementASTNode *returnStatement = (ReturnStatementASTNode*)statement;
+			if(!returnStatement->expression) break;
+
+			returnStatement->expression = __Optimizer_foldExpression(optimizer, returnStatement->expression);
+		} break;
+
+		case NODE_IF_STATEMENT: {
+			__Optimizer_optimizeIfStatement(optimizer, (IfStatementASTNode*)statement);
+		} break;
+
+		case NODE_WHILE_STATEMENT: {
+			WhileStatementASTNode *whileStatement = (WhileStatementASTNode*)statement;
+			whileStatement->test = __Optimizer_optimizeTest(optimizer, whileStatement->test);
+			__Optimizer_optimizeBlock(optimizer, whileStatement->body);
+		} break;
+
+		case NODE_FOR_STATEMENT: {
+			ForStatementASTNode *forStatement = (ForStatementASTNode*)statement;
+			forStatement->range->start = __Optimizer_foldExpression(optimizer, forStatement->range->start);
+			forStatement->range->end = __Optimizer_foldExpression(optimizer, forStatement->range->end);
+			__Optimizer_optimizeBlock(optimizer, forStatement->body);
+		} break;
+
+		case NODE_FUNCTION_DECLARATION: {
+			// Bodies of the functions are optimized after the global code
+		} break;
+
+		default: {
+			// No other statements contain expressions
+		} break;
+	}
+}
+
+void __Optimizer_optimizeIfStatement(Optimizer *optimizer, IfStatementASTNode *ifStatement) {
+	// Else-if chains are processed iteratively, they can be arbitrarily long
+	while(ifStatement != NULL) {
+		ifStatement->test = __Optimizer_optimizeTest(optimizer, ifStatement->test);
+		__Optimizer_optimizeBlock(optimizer, ifStatement->body);
+
+		if(ifStatement->alternate == NULL) break;
+
+		if(ifStatement->alternate->_type == NODE_IF_STATEMENT) {
+			ifStatement = (IfStatementASTNode*)ifStatement->alternate;
+		} else {
+			__Optimizer_optimizeBlock(optimizer, (BlockASTNode*)ifStatement->alternate);
+			ifStatement = NULL;
+		}
+	}
+}
+
+ASTNode* __Optimizer_optimizeTest(Optimizer *optimizer, ASTNode *test) {
+	// Optional binding only refers to the variable by its id
+	if(test->_type == NODE_OPTIONAL_BINDING_CONDITION) return test;
+
+	return (ASTNode*)__Optimizer_foldExpression(optimizer, (ExpressionASTNode*)test);
+}
+
+ExpressionASTNode* __Optimizer_foldExpression(Optimizer *optimizer, ExpressionASTNode *expression) {
+	// Continue on a new stack segment, deeply nested expressions would overflow the stack otherwise
+	if(CallStack_isExhausted()) {
+		OptimizerCall call = {.optimizer = optimizer, .node = (ASTNode*)expression};
+		CallStack_extend(__Optimizer_foldExpression_extended, &call);
+		return (ExpressionASTNode*)call.result;
+	}
+
+	switch(expression->_type) {
+		case NODE_IDENTIFIER: {
+			return __Optimizer_foldIdentifier(optimizer, (IdentifierASTNode*)expression);
+		} break;
+
+		case NODE_FUNCTION_CALL: {
+			FunctionCallASTNode *call = (FunctionCallASTNode*)expression;
+			Array *arguments = call->argumentList->arguments;
+
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
+				argument->expression = __Optimizer_foldExpression(optimizer, argument->expression);
+			}
+
+			ExpressionASTNode *inlined = __Optimizer_inlineCall(optimizer, call);
+			if(inlined) return inlined;
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			return __Optimizer_foldUnaryExpression(optimizer, (UnaryExpressionASTNode*)expression);
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			return __Optimizer_foldBinaryExpression(optimizer, (BinaryExpressionASTNode*)expression);
+		} break;
+
+		case NODE_INTERPOLATION_EXPRESSION: {
+			InterpolationExpressionASTNode *interpolation = (InterpolationExpressionASTNode*)expression;
+			ExpressionASTNode *concatenated = __Optimizer_foldExpression(optimizer, (ExpressionASTNode*)interpolation->concatenated);
+
+			// Fully folded interpolation is replaced by the resulting string literal
+			if(concatenated->_type != NODE_BINARY_EXPRESSION) return concatenated;
+
+			interpolation->concatenated = (BinaryExpressionASTNode*)concatenated;
+		} break;
+
+		default: {
+			// Literals cannot be folded any further
+		} break;
+	}
+
+	return expression;
+}
+
+ExpressionASTNode* __Optimizer_foldIdentifier(Optimizer *optimizer, IdentifierASTNode *identifier) {
+	VariableDeclaration *declaration = Analyser_getVariableById(optimizer->analyser, identifier->id);
+
+	// Only the constants declared by the user have an initializer
+	if(!declaration || !declaration->isConstant || !declaration->node) return (ExpressionASTNode*)identifier;
+
+	ExpressionASTNode *initializer = declaration->node->initializer;
+	if(!initializer || initializer->_type != NODE_LITERAL_EXPRESSION) return (ExpressionASTNode*)identifier;
+
+	// Each use gets its own copy, no two literals share a string
+	LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)initializer;
+	union TokenValue value = literal->value;
+	if(literal->type.type == TYPE_STRING) value.string = String_clone(value.string);
+
+	return (ExpressionASTNode*)__Optimizer_createLiteral(literal->type.type, value);
+}
+
+ExpressionASTNode* __Optimizer_foldUnaryExpression(Optimizer *optimizer, UnaryExpressionASTNode *unary) {
+	unary->argument = __Optimizer_foldExpression(optimizer, unary->argument);
+	if(unary->argument->_type != NODE_LITERAL_EXPRESSION) return (ExpressionASTNode*)unary;
+
+	LiteralExpressionASTNode *argument = (LiteralExpressionASTNode*)unary->argument;
+
+	switch(unary->operator) {
+		case OPERATOR_NOT: {
+			if(argument->type.type != TYPE_BOOL) break;
+
+			return (ExpressionASTNode*)__Optimizer_createLiteral(TYPE_BOOL, (union TokenValue){.boolean = !argument->value.boolean});
+		} break;
+
+		case OPERATOR_UNWRAP: {
+			// Unwrapping nil has to fail at runtime
+			if(argument->type.type == TYPE_NIL) break;
+
+			return (ExpressionASTNode*)argument;
+		} break;
+
+		default: {
+			// No other unary operators exist
+		} break;
+	}
+
+	return (ExpressionASTNode*)unary;
+}
+
+ExpressionASTNode* __Optimizer_foldBinaryExpression(Optimizer *optimizer, BinaryExpressionASTNode *binary) {
+	binary->left = __Optimizer_foldExpression(optimizer, binary->left);
+	binary->right = __Optimizer_foldExpression(optimizer, binary->right);
+
+	LiteralExpressionASTNode *left = binary->left->_type == NODE_LITERAL_EXPRESSION ? (LiteralExpressionASTNode*)binary->left : NULL;
+	LiteralExpressionASTNode *right = binary->right->_type == NODE_LITERAL_EXPRESSION ? (LiteralExpressionASTNode*)binary->right : NULL;
+
+	if(binary->operator == OPERATOR_NULL_COALESCING) {
+		if(!left) return (ExpressionASTNode*)binary;
+		if(left->type.type == TYPE_NIL) return binary->right;
+
+		// Right side is always evaluated, it can only be dropped if it has no side effects
+		if(right || binary->right->_type == NODE_IDENTIFIER) return binary->left;
+
+		return (ExpressionASTNode*)binary;
+	}
+
+	if(!left || !right) return (ExpressionASTNode*)binary;
+
+	enum BuiltInType type = binary->type.type;
+	union TokenValue value;
+	int order;
+
+	switch(binary->operator) {
+		case OPERATOR_PLUS:
+		case OPERATOR_MINUS:
+		case OPERATOR_MUL:
+		case OPERATOR_DIV: {
+			if(left->type.type != type || right->type.type != type) return (ExpressionASTNode*)binary;
+			if(!__Optimizer_evaluateArithmetic(binary->operator, type, left->value, right->value, &value)) return (ExpressionASTNode*)binary;
+		} break;
+
+		case OPERATOR_EQUAL:
+		case OPERATOR_NOT_EQUAL: {
+			bool isEqual;
+
+			if(left->type.type == TYPE_NIL || right->type.type == TYPE_NIL) {
+				isEqual = left->type.type == right->type.type;
+			} else {
+				if(!__Optimizer_compareLiterals(left, right, &order)) return (ExpressionASTNode*)binary;
+				isEqual = order == 0;
+			}
+
+			value.boolean = isEqual == (binary->operator == OPERATOR_EQUAL);
+		} break;
+
+		case OPERATOR_LESS:
+		case OPERATOR_GREATER:
+		case OPERATOR_LESS_EQUAL:
+		case OPERATOR_GREATER_EQUAL: {
+			if(!__Optimizer_compareLiterals(left, right, &order)) return (ExpressionASTNode*)binary;
+
+			if(binary->operator == OPERATOR_LESS) value.boolean = order < 0;
+			else if(binary->operator == OPERATOR_GREATER) value.boolean = order > 0;
+			else if(binary->operator == OPERATOR_LESS_EQUAL) value.boolean = order <= 0;
+			else value.boolean = order >= 0;
+		} break;
+
+		case OPERATOR_AND:
+		case OPERATOR_OR: {
+			if(left->type.type != TYPE_BOOL || right->type.type != TYPE_BOOL) return (ExpressionASTNode*)binary;
+
+			if(binary->operator == OPERATOR_AND) value.boolean = left->value.boolean && right->value.boolean;
+			else value.boolean = left->value.boolean || right->value.boolean;
+		} break;
+
+		default: {
+			return (ExpressionASTNode*)binary;
+		} break;
+	}
+
+	return (ExpressionASTNode*)__Optimizer_createLiteral(type, value);
+}
+
+bool __Optimizer_evaluateArithmetic(OperatorType operator, enum BuiltInType type, union TokenValue left, union TokenValue right, union TokenValue *outValue) {
+	switch(type) {
+		case TYPE_INT: {
+			// Integers wrap around on overflow, the same way the interpreter does
+			unsigned long a = (unsigned long)left.integer;
+			unsigned long b = (unsigned long)right.integer;
+
+			if(operator == OPERATOR_PLUS) outValue->integer = (long)(a + b);
+			else if(operator == OPERATOR_MINUS) outValue->integer = (long)(a - b);
+			else if(operator == OPERATOR_MUL) outValue->integer = (long)(a * b);
+			else {
+				// Division by zero has to fail at runtime, the only overflowing division is left unfolded as well
+				if(right.integer == 0) return false;
+				if(left.integer == LONG_MIN && right.integer == -1) return false;
+
+				// IDIV rounds towards negative infinity
+				long quotient = left.integer / right.integer;
+				if(left.integer % right.integer != 0 && (left.integer < 0) != (right.integer < 0)) quotient--;
+
+				outValue->integer = quotient;
+			}
+		} break;
+
+		case TYPE_DOUBLE: {
+			if(operator == OPERATOR_PLUS) outValue->floating = left.floating + right.floating;
+			else if(operator == OPERATOR_MINUS) outValue->floating = left.floating - right.floating;
+			else if(operator == OPERATOR_MUL) outValue->floating = left.floating * right.floating;
+			else {
+				if(right.floating == 0.0) return false;
+
+				outValue->floating = left.floating / right.floating;
+			}
+
+			// Infinity cannot be written as a literal of the target code
+			if(!isfinite(outValue->floating)) return false;
+		} break;
+
+		case TYPE_STRING: {
+			if(operator != OPERATOR_PLUS) return false;
+
+			String *string = String_clone(left.string);
+			String_append(string, right.string->value);
+
+			outValue->string = string;
+		} break;
+
+		default: {
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+bool __Optimizer_compareLiterals(LiteralExpressionASTNode *left, LiteralExpressionASTNode *right, int *outOrder) {
+	if(left->type.type != right->type.type) return false;
+
+	switch(left->type.type) {
+		case TYPE_INT: {
+			*outOrder = (left->value.integer > right->value.integer) - (left->value.integer < right->value.integer);
+		} break;
+
+		case TYPE_DOUBLE: {
+			*outOrder = (left->value.floating > right->value.floating) - (left->value.floating < right->value.floating);
+		} break;
+
+		case TYPE_BOOL: {
+			*outOrder = (int)!!left->value.boolean - (int)!!right->value.boolean;
+		} break;
+
+		case TYPE_STRING: {
+			*outOrder = strcmp(left->value.string->value, right->value.string->value);
+		} break;
+
+		default: {
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+LiteralExpressionASTNode* __Optimizer_createLiteral(enum BuiltInType type, union TokenValue value) {
+	return new_LiteralExpressionASTNode((ValueType){.type = type, .isNullable = false}, value);
+}
+
+void __Optimizer_eliminateDeadStatements(BlockASTNode *block) {
+	Array *statements = block->statements;
+	Array /*<StatementASTNode> | null*/ *live = NULL; // Created once the first statement is removed or replaced
+
+	for(size_t i = 0; i < statements->size; i++) {
+		StatementASTNode *statement = Array_get(statements, i);
+		ASTNode *node = __Optimizer_resolveBranch(statement);
+
+		// Loops with a false test never run their body
+		if(
+			node && node->_type == NODE_WHILE_STATEMENT &&
+			((WhileStatementASTNode*)node)->test->_type == NODE_LITERAL_EXPRESSION &&
+			!((LiteralExpressionASTNode*)((WhileStatementASTNode*)node)->test)->value.boolean
+		) node = NULL;
+
+		// Remove the constant tests from the rest of the else-if chain
+		if(node && node->_type == NODE_IF_STATEMENT) {
+			IfStatementASTNode *link = (IfStatementASTNode*)node;
+
+			while(link->alternate) {
+				link->alternate = __Optimizer_resolveBranch(link->alternate);
+				if(!link->alternate || link->alternate->_type != NODE_IF_STATEMENT) break;
+
+				link = (IfStatementASTNode*)link->alternate;
+			}
+		}
+
+		if(!live && node == statement && !__Optimizer_isTerminator(node)) continue;
+
+		if(!live) {
+			live = Array_alloc(statements->size);
+			for(size_t j = 0; j < i; j++) Array_push(live, Array_get(statements, j));
+		}
+
+		if(!node) continue;
+
+		// Statements of the taken branch are moved to the enclosing block (variables are declared per function anyway)
+		Array *branch = node->_type == NODE_BLOCK ? ((BlockASTNode*)node)->statements : NULL;
+		size_t count = branch ? branch->size : 1;
+		bool isTerminated = false;
+
+		for(size_t j = 0; j < count && !isTerminated; j++) {
+			ASTNode *kept = branch ? Array_get(branch, j) : node;
+			Array_push(live, kept);
+
+			isTerminated = __Optimizer_isTerminator(kept);
+		}
+
+		// Nothing after the return, break or continue statement can be reached
+		if(isTerminated) break;
+	}
+
+	if(!live) return;
+
+	Array_free(statements);
+	block->statements = live;
+}
+
+ASTNode* __Optimizer_resolveBranch(ASTNode *node) {
+	// Follow the if statements with a constant test to the branch that is always taken
+	while(node && node->_type == NODE_IF_STATEMENT) {
+		IfStatementASTNode *ifStatement = (IfStatementASTNode*)node;
+		if(ifStatement->test->_type != NODE_LITERAL_EXPRESSION) break;
+
+		LiteralExpressionASTNode *test = (LiteralExpressionASTNode*)ifStatement->test;
+		node = test->value.boolean ? (ASTNode*)ifStatement->body : ifStatement->alternate;
+	}
+
+	return node;
+}
+
+bool __Optimizer_isTerminator(ASTNode *statement) {
+	return statement->_type == NODE_RETURN_STATEMENT ||
+	       statement->_type == NODE_BREAK_STATEMENT ||
+	       statement->_type == NODE_CONTINUE_STATEMENT;
+}
+
+void __Optimizer_eliminateUnusedDeclarations(Optimizer *optimizer) {
+	Analyser *analyser = optimizer->analyser;
+
+	// Usage is collected again, the analyser also counts the references from the removed code
+	for(size_t i = 0; i < analyser->declarations->size; i++) {
+		Declaration *declaration = Array_get(analyser->declarations, i);
+		if(!declaration) continue;
+
+		if(declaration->_type == DECLARATION_FUNCTION) ((FunctionDeclaration*)declaration)->isUsed = false;
+		else ((VariableDeclaration*)declaration)->isUsed = false;
+	}
+
+	Array *worklist = Array_alloc(0);
+	Array *functions = Array_alloc(0);
+	Array *declarations = Array_alloc(0);
+
+	Array_push(worklist, analyser->ast->block);
+	__Optimizer_markReachable(optimizer, worklist, functions, declarations);
+
+	// Each body is searched on its own, so the calls are attributed to the function making them
+	while(functions->size > 0) {
+		FunctionDeclaration *function = Array_pop(functions);
+		function->isLeaf = true;
+
+		optimizer->function = function;
+		Array_push(worklist, function->node->body);
+		__Optimizer_markReachable(optimizer, worklist, functions, declarations);
+	}
+
+	optimizer->function = NULL;
+
+	// Declarators of the unused variables are removed, unless the initializer has to be evaluated
+	for(size_t i = 0; i < declarations->size; i++) {
+		VariableDeclarationASTNode *declaration = Array_get(declarations, i);
+		Array *declarators = declaration->declaratorList->declarators;
+		size_t count = 0;
+
+		for(size_t j = 0; j < declarators->size; j++) {
+			VariableDeclaratorASTNode *declarator = Array_get(declarators, j);
+			VariableDeclaration *variable = Analyser_getVariableById(analyser, declarator->pattern->id->id);
+
+			if(!variable->isUsed && declarator->initializer && __Optimizer_hasSideEffects(optimizer, declarator->initializer)) {
+				variable->isUsed = true;
+			}
+
+			if(variable->isUsed) Array_set(declarators, count++, declarator);
+		}
+
+		declarators->size = count;
+	}
+
+	__Optimizer_removeUnusedVariables(analyser->variables);
+
+	for(size_t i = 0; i < analyser->functions->size; i++) {
+		FunctionDeclaration *function = Array_get(analyser->functions, i);
+		if(function->isUsed) __Optimizer_removeUnusedVariables(function->variables);
+	}
+
+	Array_free(worklist);
+	Array_free(functions);
+	Array_free(declarations);
+}
+
+void __Optimizer_markReachable(Optimizer *optimizer, Array /*<ASTNode>*/ *worklist, Array /*<FunctionDeclaration>*/ *outFunctions, Array /*<VariableDeclarationASTNode>*/ *outDeclarations) {
+	// Explicit worklist is used, the reachable code can be nested arbitrarily deep
+	while(worklist->size > 0) {
+		ASTNode *node = Array_pop(worklist);
+
+		switch(node->_type) {
+			case NODE_BLOCK: {
+				Array *statements = ((BlockASTNode*)node)->statements;
+
+				for(size_t i = 0; i < statements->size; i++) {
+					ASTNode *statement = Array_get(statements, i);
+
+					// Functions are reachable only through the calls
+					if(statement->_type == NODE_FUNCTION_DECLARATION) continue;
+
+					Array_push(worklist, statement);
+				}
+			} break;
+
+			case NODE_VARIABLE_DECLARATION: {
+				VariableDeclarationASTNode *declaration = (VariableDeclarationASTNode*)node;
+				Array *declarators = declaration->declaratorList->declarators;
+
+				for(size_t i = 0; i < declarators->size; i++) {
+					VariableDeclaratorASTNode *declarator = Array_get(declarators, i);
+					if(declarator->initializer) Array_push(worklist, declarator->initializer);
+				}
+
+				Array_push(outDeclarations, declaration);
+			} break;
+
+			case NODE_ASSIGNMENT_STATEMENT: {
+				AssignmentStatementASTNode *assignment = (AssignmentStatementASTNode*)node;
+				__Optimizer_markVariableUsed(optimizer, assignment->id->id);
+				Array_push(worklist, assignment->expression);
+			} break;
+
+			case NODE_EXPRESSION_STATEMENT: {
+				Array_push(worklist, ((ExpressionStatementASTNode*)node)->expression);
+			} break;
+
+			case NODE_RETURN_STATEMENT: {
+				ReturnStatementASTNode *returnStatement = (ReturnStatementASTNode*)node;
+				if(!returnStatement->expression) break;
+
+				// Tail call is a jump within the function itself, only its arguments are searched
+				if(!returnStatement->isTailCall) {
+					Array_push(worklist, returnStatement->expression);
+					break;
+				}
+
+				Array *arguments = ((FunctionCallASTNode*)returnStatement->expression)->argumentList->arguments;
+
+				for(size_t i = 0; i < arguments->size; i++) {
+					ArgumentASTNode *argument = Array_get(arguments, i);
+					Array_push(worklist, argument->expression);
+				}
+			} break;
+
+			case NODE_IF_STATEMENT: {
+				IfStatementASTNode *ifStatement = (IfStatementASTNode*)node;
+				Array_push(worklist, ifStatement->test);
+				Array_push(worklist, ifStatement->body);
+				if(ifStatement->alternate) Array_push(worklist, ifStatement->alternate);
+			} break;
+
+			case NODE_WHILE_STATEMENT: {
+				WhileStatementASTNode *whileStatement = (WhileStatementASTNode*)node;
+				Array_push(worklist, whileStatement->test);
+				Array_push(worklist, whileStatement->body);
+			} break;
+
+			case NODE_FOR_STATEMENT: {
+				ForStatementASTNode *forStatement = (ForStatementASTNode*)node;
+				Array_push(worklist, forStatement->range->start);
+				Array_push(worklist, forStatement->range->end);
+				Array_push(worklist, forStatement->body);
+			} break;
+
+			case NODE_OPTIONAL_BINDING_CONDITION: {
+				__Optimizer_markVariableUsed(optimizer, ((OptionalBindingConditionASTNode*)node)->fromId);
+			} break;
+
+			case NODE_IDENTIFIER: {
+				__Optimizer_markVariableUsed(optimizer, ((IdentifierASTNode*)node)->id);
+			} break;
+
+			case NODE_FUNCTION_CALL: {
+				FunctionCallASTNode *call = (FunctionCallASTNode*)node;
+				FunctionDeclaration *function = Analyser_getFunctionById(optimizer->analyser, call->id->id);
+				bool isGenerable = is_func_generable(function->node->builtin);
+
+				// Only the calls of the built-in functions keep the caller a leaf
+				if(optimizer->function && isGenerable) optimizer->function->isLeaf = false;
+
+				if(!function->isUsed) {
+					function->isUsed = true;
+
+					// Bodies of the built-in functions are generated by the code generator itself
+					if(isGenerable) Array_push(outFunctions, function);
+				}
+
+				Array *arguments = call->argumentList->arguments;
+
+				for(size_t i = 0; i < arguments->size; i++) {
+					ArgumentASTNode *argument = Array_get(arguments, i);
+					Array_push(worklist, argument->expression);
+				}
+			} break;
+
+			case NODE_UNARY_EXPRESSION: {
+				Array_push(worklist, ((UnaryExpressionASTNode*)node)->argument);
+			} break;
+
+			case NODE_BINARY_EXPRESSION: {
+				BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)node;
+				Array_push(worklist, binary->left);
+				Array_push(worklist, binary->right);
+			} break;
+
+			case NODE_INTERPOLATION_EXPRESSION: {
+				Array_push(worklist, ((InterpolationExpressionASTNode*)node)->concatenated);
+			} break;
+
+			default: {
+				// No other nodes reference declarations
+			} break;
+		}
+	}
+}
+
+void __Optimizer_markVariableUsed(Optimizer *optimizer, size_t id) {
+	VariableDeclaration *variable = Analyser_getVariableById(optimizer->analyser, id);
+	if(variable) variable->isUsed = true;
+}
+
+void __Optimizer_removeUnusedVariables(Array /*<VariableDeclaration>*/ *variables) {
+	size_t count = 0;
+
+	for(size_t i = 0; i < variables->size; i++) {
+		VariableDeclaration *variable = Array_get(variables, i);
+
+		// Only the declarators can be removed, the other variables are assigned by the code generator directly
+		if(variable->isUsed || !variable->node) Array_set(variables, count++, variable);
+	}
+
+	variables->size = count;
+}
+
+bool __Optimizer_hasSideEffects(Optimizer *optimizer, ExpressionASTNode *expression) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	bool hasSideEffects = false;
+
+	while(worklist->size > 0 && !hasSideEffects) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		switch(node->_type) {
+			case NODE_FUNCTION_CALL: {
+				FunctionCallASTNode *call = (FunctionCallASTNode*)node;
+				enum BuiltInFunction builtin = Analyser_getBuiltInFunctionById(optimizer->analyser, call->id->id);
+
+				// Only the built-in functions that cannot fail (and the stringification of the interpolated values) are pure
+				if(!is_func_pure(builtin)) {
+					hasSideEffects = true;
+					break;
+				}
+
+				Array *arguments = call->argumentList->arguments;
+
+				for(size_t i = 0; i < arguments->size; i++) {
+					ArgumentASTNode *argument = Array_get(arguments, i);
+					Array_push(worklist, argument->expression);
+				}
+			} break;
+
+			case NODE_INTERPOLATION_EXPRESSION: {
+				Array_push(worklist, ((InterpolationExpressionASTNode*)node)->concatenated);
+			} break;
+
+			case NODE_UNARY_EXPRESSION: {
+				UnaryExpressionASTNode *unary = (UnaryExpressionASTNode*)node;
+
+				// Unwrapping nil fails at runtime
+				if(unary->operator == OPERATOR_UNWRAP) hasSideEffects = true;
+				else Array_push(worklist, unary->argument);
+			} break;
+
+			case NODE_BINARY_EXPRESSION: {
+				BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)node;
+
+				// Division by zero fails at runtime
+				if(binary->operator == OPERATOR_DIV) hasSideEffects = true;
+
+				Array_push(worklist, binary->left);
+				Array_push(worklist, binary->right);
+			} break;
+
+			default: {
+				// Literals and identifiers are only read
+			} break;
+		}
+	}
+
+	Array_free(worklist);
+
+	return hasSideEffects;
+}
+
+FunctionDeclaration* __Optimizer_getInlinableFunction(Optimizer *optimizer, FunctionCallASTNode *call) {
+	FunctionDeclaration *function = Analyser_getFunctionById(optimizer->analyser, call->id->id);
+	if(!function || !is_func_generable(function->node->builtin)) return NULL;
+
+	// Recursive functions are never inlined, copies of the mutually recursive ones stop at the function already being inlined
+	if(function == optimizer->function) return NULL;
+	if(optimizer->inlining->size >= OPTIMIZER_INLINE_DEPTH) return NULL;
+
+	for(size_t i = 0; i < optimizer->inlining->size; i++) {
+		if(Array_get(optimizer->inlining, i) == function) return NULL;
+	}
+
+	Array *dependencies = function->dependencies;
+
+	for(size_t i = 0; dependencies && i < dependencies->size; i++) {
+		if(Array_get(dependencies, i) == (Declaration*)function) return NULL;
+	}
+
+	// Each parameter needs its argument
+	if(call->argumentList->arguments->size != function->node->parameterList->parameters->size) return NULL;
+
+	return function;
+}
+
+ExpressionASTNode* __Optimizer_inlineCall(Optimizer *optimizer, FunctionCallASTNode *call) {
+	FunctionDeclaration *function = __Optimizer_getInlinableFunction(optimizer, call);
+	if(!function) return NULL;
+
+	// Only the body made of a single return statement can be substituted into the expression
+	Array *statements = function->node->body->statements;
+	if(statements->size != 1) return NULL;
+
+	ReturnStatementASTNode *returnStatement = Array_get(statements, 0);
+	if(returnStatement->_type != NODE_RETURN_STATEMENT || !returnStatement->expression) return NULL;
+
+	ExpressionASTNode *body = returnStatement->expression;
+	size_t size = __Optimizer_measure((ASTNode*)body, OPTIMIZER_INLINE_BUDGET);
+	if(size > OPTIMIZER_INLINE_BUDGET) return NULL;
+
+	Array *parameters = function->node->parameterList->parameters;
+	Array *arguments = call->argumentList->arguments;
+	bool mayModifyVariables = __Optimizer_mayModifyVariables(optimizer, body);
+
+	for(size_t i = 0; i < arguments->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		// Arguments are evaluated at the places of their uses (if any), so they must not have any side effects
+		if(__Optimizer_hasSideEffects(optimizer, argument->expression)) return NULL;
+
+		size_t uses = __Optimizer_countUses(body, parameter->internalId->id);
+		if(uses == 0) continue;
+
+		// Calls in the body could change the global variable before the argument is evaluated
+		if(mayModifyVariables && __Optimizer_readsMutableGlobals(optimizer, argument->expression)) return NULL;
+
+		size += uses * (__Optimizer_measure((ASTNode*)argument->expression, OPTIMIZER_INLINE_BUDGET) - 1);
+		if(size > OPTIMIZER_INLINE_BUDGET) return NULL;
+	}
+
+	Array *variables = Array_alloc(arguments->size);
+
+	for(size_t i = 0; i < arguments->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		ArgumentASTNode *argument = Array_get(arguments, i);
+
+		InlinedVariable *variable = mem_alloc(sizeof(InlinedVariable));
+		variable->id = parameter->internalId->id;
+		variable->replacement = argument->expression;
+		Array_push(variables, variable);
+	}
+
+	ExpressionASTNode *expression = __Optimizer_cloneExpression(body, variables);
+	__Optimizer_freeInlinedVariables(variables);
+
+	// The copy is optimized in the context of the call site
+	Array_push(optimizer->inlining, function);
+	expression = __Optimizer_foldExpression(optimizer, expression);
+	Array_pop(optimizer->inlining);
+
+	return expression;
+}
+
+Array /*<StatementASTNode> | null*/* __Optimizer_inlineStatement(Optimizer *optimizer, StatementASTNode *statement) {
+	ExpressionASTNode **slot = NULL;
+
+	switch(statement->_type) {
+		case NODE_EXPRESSION_STATEMENT: {
+			slot = &((ExpressionStatementASTNode*)statement)->expression;
+		} break;
+
+		case NODE_ASSIGNMENT_STATEMENT: {
+			slot = &((AssignmentStatementASTNode*)statement)->expression;
+		} break;
+
+		case NODE_RETURN_STATEMENT: {
+			slot = &((ReturnStatementASTNode*)statement)->expression;
+		} break;
+
+		case NODE_VARIABLE_DECLARATION: {
+			Array *declarators = ((VariableDeclarationASTNode*)statement)->declaratorList->declarators;
+			if(declarators->size != 1) break;
+
+			slot = &((VariableDeclaratorASTNode*)Array_get(declarators, 0))->initializer;
+		} break;
+
+		default: {
+			// Tests of the conditions and loops cannot be preceded by other statements
+		} break;
+	}
+
+	// Only the call making up the whole statement is inlined, its arguments are evaluated right before the body then
+	if(!slot || !*slot || (*slot)->_type != NODE_FUNCTION_CALL) return NULL;
+
+	FunctionCallASTNode *call = (FunctionCallASTNode*)*slot;
+	FunctionDeclaration *function = __Optimizer_getInlinableFunction(optimizer, call);
+	if(!function) return NULL;
+
+	// Body has to be straight-line code, the return statement can only be the last one
+	Array *body = function->node->body->statements;
+	ReturnStatementASTNode *returnStatement = NULL;
+
+	for(size_t i = 0; i < body->size; i++) {
+		StatementASTNode *bodyStatement = Array_get(body, i);
+
+		switch(bodyStatement->_type) {
+			case NODE_RETURN_STATEMENT: {
+				if(i != body->size - 1) return NULL;
+
+				returnStatement = (ReturnStatementASTNode*)bodyStatement;
+			} break;
+
+			case NODE_VARIABLE_DECLARATION: {
+				Array *declarators = ((VariableDeclarationASTNode*)bodyStatement)->declaratorList->declarators;
+
+				// Variable without the initializer would keep its value from the previous pass of the enclosing loop
+				for(size_t j = 0; j < declarators->size; j++) {
+					VariableDeclaratorASTNode *declarator = Array_get(declarators, j);
+					if(!declarator->initializer) return NULL;
+				}
+			} break;
+
+			case NODE_ASSIGNMENT_STATEMENT:
+			case NODE_EXPRESSION_STATEMENT: {
+				// Evaluated in place
+			} break;
+
+			default: {
+				return NULL;
+			} break;
+		}
+	}
+
+	ExpressionASTNode *result = returnStatement ? returnStatement->expression : NULL;
+
+	// Only the value of the expression statement is not needed
+	if(!result && statement->_type != NODE_EXPRESSION_STATEMENT) return NULL;
+
+	if(__Optimizer_measure((ASTNode*)function->node->body, OPTIMIZER_INLINE_BUDGET) > OPTIMIZER_INLINE_BUDGET) return NULL;
+
+	Analyser *analyser = optimizer->analyser;
+	Array *parameters = function->node->parameterList->parameters;
+	Array *arguments = call->argumentList->arguments;
+	Array *variables = Array_alloc(parameters->size);
+	Array *statements = Array_alloc(parameters->size + body->size);
+
+	// Arguments are stored to the copies of the parameters in order, the same way the call evaluates them
+	for(size_t i = 0; i < arguments->size; i++) {
+		ParameterASTNode *parameter = Array_get(parameters, i);
+		ArgumentASTNode *argument = Array_get(arguments, i);
+		VariableDeclaration *original = Analyser_getVariableById(analyser, parameter->internalId->id);
+
+		VariableDeclaratorASTNode *declarator = __Optimizer_declareInlinedVariable(optimizer, original, true, argument->expression, variables);
+		VariableDeclarationListASTNode *declaratorList = new_VariableDeclarationListASTNode(Array_fromArgs(1, declarator));
+		Array_push(statements, new_VariableDeclarationASTNode(declaratorList, true));
+	}
+
+	for(size_t i = 0; i < body->size; i++) {
+		StatementASTNode *bodyStatement = Array_get(body, i);
+		if(bodyStatement->_type == NODE_RETURN_STATEMENT) break;
+
+		Array_push(statements, __Optimizer_cloneStatement(optimizer, bodyStatement, variables));
+	}
+
+	if(result) result = __Optimizer_cloneExpression(result, variables);
+	__Optimizer_freeInlinedVariables(variables);
+
+	// Returned value takes the place of the call, the value of the expression statement is only kept for its side effects
+	*slot = result;
+
+	if(statement->_type != NODE_EXPRESSION_STATEMENT || (result && __Optimizer_hasSideEffects(optimizer, result))) {
+		Array_push(statements, statement);
+	}
+
+	// The copy is optimized in the context of the call site, including the calls made by the inlined body
+	BlockASTNode *block = new_BlockASTNode(statements);
+
+	Array_push(optimizer->inlining, function);
+	__Optimizer_optimizeBlock(optimizer, block);
+	Array_pop(optimizer->inlining);
+
+	return block->statements;
+}
+
+VariableDeclaratorASTNode* __Optimizer_declareInlinedVariable(Optimizer *optimizer, VariableDeclaration *original, bool isConstant, ExpressionASTNode *initializer, Array /*<InlinedVariable>*/ *variables) {
+	Analyser *analyser = optimizer->analyser;
+
+	IdentifierASTNode *id = new_IdentifierASTNode(original->name);
+	VariableDeclaratorASTNode *declarator = new_VariableDeclaratorASTNode(new_PatternASTNode(id, NULL), initializer);
+	VariableDeclaration *declaration = new_VariableDeclaration(analyser, declarator, isConstant, original->type, original->name, true, true);
+
+	// Pattern of the copy has no type annotation
+	declaration->type = original->type;
+
+	// Copy belongs to the function the body is inlined into
+	__Optimizer_registerVariable(optimizer, declaration);
+
+	InlinedVariable *variable = mem_alloc(sizeof(InlinedVariable));
+	variable->id = original->id;
+	variable->replacement = (ExpressionASTNode*)id;
+	Array_push(variables, variable);
+
+	return declarator;
+}
+
+StatementASTNode* __Optimizer_cloneStatement(Optimizer *optimizer, StatementASTNode *statement, Array /*<InlinedVariable>*/ *variables) {
+	switch(statement->_type) {
+		case NODE_VARIABLE_DECLARATION: {
+			VariableDeclarationASTNode *declaration = (VariableDeclarationASTNode*)statement;
+			Array *declarators = declaration->declaratorList->declarators;
+			Array *clones = Array_alloc(declarators->size);
+
+			for(size_t i = 0; i < declarators->size; i++) {
+				VariableDeclaratorASTNode *declarator = Array_get(declarators, i);
+				VariableDeclaration *original = Analyser_getVariableById(optimizer->analyser, declarator->pattern->id->id);
+
+				// Initializer cannot refer to the variable being declared
+				ExpressionASTNode *initializer = __Optimizer_cloneExpression(declarator->initializer, variables);
+				Array_push(clones, __Optimizer_declareInlinedVariable(optimizer, original, original->isConstant, initializer, variables));
+			}
+
+			return (StatementASTNode*)new_VariableDeclarationASTNode(new_VariableDeclarationListASTNode(clones), declaration->isConstant);
+		} break;
+
+		case NODE_ASSIGNMENT_STATEMENT: {
+			AssignmentStatementASTNode *assignment = (AssignmentStatementASTNode*)statement;
+			IdentifierASTNode *id = (IdentifierASTNode*)__Optimizer_cloneExpression((ExpressionASTNode*)assignment->id, variables);
+
+			return (StatementASTNode*)new_AssignmentStatementASTNode(id, __Optimizer_cloneExpression(assignment->expression, variables));
+		} break;
+
+		case NODE_EXPRESSION_STATEMENT: {
+			ExpressionStatementASTNode *expressionStatement = (ExpressionStatementASTNode*)statement;
+
+			return (StatementASTNode*)new_ExpressionStatementASTNode(__Optimizer_cloneExpression(expressionStatement->expression, variables));
+		} break;
+
+		default: {
+			fassertf("[Optimizer] Unexpected statement in the inlined body.");
+		} break;
+	}
+
+	return NULL;
+}
+
+ExpressionASTNode* __Optimizer_cloneExpression(ExpressionASTNode *expression, Array /*<InlinedVariable> | null*/ *variables) {
+	// Inlined bodies are limited in size, the recursion does not go deep
+	switch(expression->_type) {
+		case NODE_LITERAL_EXPRESSION: {
+			LiteralExpressionASTNode *clone = mem_alloc(sizeof(LiteralExpressionASTNode));
+			*clone = *(LiteralExpressionASTNode*)expression;
+
+			// No two literals share a string
+			if(clone->type.type == TYPE_STRING) {
+				clone->value.string = String_clone(clone->value.string);
+				clone->originalValue.string = clone->value.string;
+			}
+
+			return (ExpressionASTNode*)clone;
+		} break;
+
+		case NODE_IDENTIFIER: {
+			IdentifierASTNode *identifier = (IdentifierASTNode*)expression;
+
+			for(size_t i = 0; variables && i < variables->size; i++) {
+				InlinedVariable *variable = Array_get(variables, i);
+				if(variable->id == identifier->id) return __Optimizer_cloneExpression(variable->replacement, NULL);
+			}
+
+			IdentifierASTNode *clone = mem_alloc(sizeof(IdentifierASTNode));
+			*clone = *identifier;
+
+			return (ExpressionASTNode*)clone;
+		} break;
+
+		case NODE_FUNCTION_CALL: {
+			FunctionCallASTNode *call = (FunctionCallASTNode*)expression;
+			Array *arguments = call->argumentList->arguments;
+			Array *clones = Array_alloc(arguments->size);
+
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
+				Array_push(clones, new_ArgumentASTNode(__Optimizer_cloneExpression(argument->expression, variables), argument->label));
+			}
+
+			IdentifierASTNode *id = (IdentifierASTNode*)__Optimizer_cloneExpression((ExpressionASTNode*)call->id, NULL);
+
+			return (ExpressionASTNode*)new_FunctionCallASTNode(id, new_ArgumentListASTNode(clones));
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			UnaryExpressionASTNode *clone = mem_alloc(sizeof(UnaryExpressionASTNode));
+			*clone = *(UnaryExpressionASTNode*)expression;
+			clone->argument = __Optimizer_cloneExpression(clone->argument, variables);
+
+			return (ExpressionASTNode*)clone;
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			BinaryExpressionASTNode *clone = mem_alloc(sizeof(BinaryExpressionASTNode));
+			*clone = *(BinaryExpressionASTNode*)expression;
+			clone->left = __Optimizer_cloneExpression(clone->left, variables);
+			clone->right = __Optimizer_cloneExpression(clone->right, variables);
+
+			return (ExpressionASTNode*)clone;
+		} break;
+
+		case NODE_INTERPOLATION_EXPRESSION: {
+			// Only the concatenation is generated, the parts are shared with the original
+			InterpolationExpressionASTNode *clone = mem_alloc(sizeof(InterpolationExpressionASTNode));
+			*clone = *(InterpolationExpressionASTNode*)expression;
+			clone->concatenated = (BinaryExpressionASTNode*)__Optimizer_cloneExpression((ExpressionASTNode*)clone->concatenated, variables);
+
+			return (ExpressionASTNode*)clone;
+		} break;
+
+		default: {
+			fassertf("[Optimizer] Unexpected expression in the inlined body.");
+		} break;
+	}
+
+	return NULL;
+}
+
+void __Optimizer_freeInlinedVariables(Array /*<InlinedVariable>*/ *variables) {
+	for(size_t i = 0; i < variables->size; i++) {
+		mem_free(Array_get(variables, i));
+	}
+
+	Array_free(variables);
+}
+
+size_t __Optimizer_measure(ASTNode *node, size_t limit) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, node);
+
+	size_t size = 0;
+
+	// Counting stops once the limit is exceeded, arguments can be arbitrarily large
+	while(worklist->size > 0 && size <= limit) {
+		ASTNode *current = Array_pop(worklist);
+		size++;
+
+		switch(current->_type) {
+			case NODE_BLOCK: {
+				Array *statements = ((BlockASTNode*)current)->statements;
+				for(size_t i = 0; i < statements->size; i++) Array_push(worklist, Array_get(statements, i));
+			} break;
+
+			case NODE_VARIABLE_DECLARATION: {
+				Array *declarators = ((VariableDeclarationASTNode*)current)->declaratorList->declarators;
+
+				for(size_t i = 0; i < declarators->size; i++) {
+					VariableDeclaratorASTNode *declarator = Array_get(declarators, i);
+					if(declarator->initializer) Array_push(worklist, declarator->initializer);
+				}
+			} break;
+
+			case NODE_ASSIGNMENT_STATEMENT: {
+				Array_push(worklist, ((AssignmentStatementASTNode*)current)->expression);
+			} break;
+
+			case NODE_EXPRESSION_STATEMENT: {
+				Array_push(worklist, ((ExpressionStatementASTNode*)current)->expression);
+			} break;
+
+			case NODE_RETURN_STATEMENT: {
+				ReturnStatementASTNode *returnStatement = (ReturnStatementASTNode*)current;
+				if(returnStatement->expression) Array_push(worklist, returnStatement->expression);
+			} break;
+
+			default: {
+				__Optimizer_pushOperands(worklist, (ExpressionASTNode*)current);
+			} break;
+		}
+	}
+
+	Array_free(worklist);
+
+	return size;
+}
+
+size_t __Optimizer_countUses(ExpressionASTNode *expression, size_t id) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	size_t uses = 0;
+
+	while(worklist->size > 0) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		if(node->_type == NODE_IDENTIFIER && ((IdentifierASTNode*)node)->id == id) uses++;
+		else __Optimizer_pushOperands(worklist, node);
+	}
+
+	Array_free(worklist);
+
+	return uses;
+}
+
+bool __Optimizer_mayModifyVariables(Optimizer *optimizer, ExpressionASTNode *expression) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	bool mayModifyVariables = false;
+
+	while(worklist->size > 0 && !mayModifyVariables) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		// Only the functions declared by the user assign the global variables
+		if(node->_type == NODE_FUNCTION_CALL) {
+			FunctionCallASTNode *call = (FunctionCallASTNode*)node;
+			mayModifyVariables = is_func_user_defined(Analyser_getBuiltInFunctionById(optimizer->analyser, call->id->id));
+		}
+
+		__Optimizer_pushOperands(worklist, node);
+	}
+
+	Array_free(worklist);
+
+	return mayModifyVariables;
+}
+
+bool __Optimizer_readsMutableGlobals(Optimizer *optimizer, ExpressionASTNode *expression) {
+	Array *worklist = Array_alloc(0);
+	Array_push(worklist, expression);
+
+	bool readsMutableGlobals = false;
+
+	while(worklist->size > 0 && !readsMutableGlobals) {
+		ExpressionASTNode *node = Array_pop(worklist);
+
+		if(node->_type == NODE_IDENTIFIER) {
+			size_t id = ((IdentifierASTNode*)node)->id;
+			VariableDeclaration *variable = Analyser_getVariableById(optimizer->analyser, id);
+
+			readsMutableGlobals = variable && !variable->isConstant && Analyser_isDeclarationGlobal(optimizer->analyser, id);
+		}
+
+		__Optimizer_pushOperands(worklist, node);
+	}
+
+	Array_free(worklist);
+
+	return readsMutableGlobals;
+}
+
+void __Optimizer_pushOperands(Array /*<ExpressionASTNode>*/ *worklist, ExpressionASTNode *expression) {
+	switch(expression->_type) {
+		case NODE_FUNCTION_CALL: {
+			Array *arguments = ((FunctionCallASTNode*)expression)->argumentList->arguments;
+
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
+				Array_push(worklist, argument->expression);
+			}
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			Array_push(worklist, ((UnaryExpressionASTNode*)expression)->argument);
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)expression;
+			Array_push(worklist, binary->left);
+			Array_push(worklist, binary->right);
+		} break;
+
+		case NODE_INTERPOLATION_EXPRESSION: {
+			Array_push(worklist, ((InterpolationExpressionASTNode*)expression)->concatenated);
+		} break;
+
+		default: {
+			// Literals and identifiers have no operands
+		} break;
+	}
+}
+
+Array /*<StatementASTNode> | null*/* __Optimizer_hoistInvariants(Optimizer *optimizer, StatementASTNode *statement) {
+	if(statement->_type != NODE_WHILE_STATEMENT && statement->_type != NODE_FOR_STATEMENT) return NULL;
+
+	LoopScope scope = {.modified = BitSet_alloc(), .hasCalls = false, .hoisted = Array_alloc(0)};
+	Array *slots = Array_alloc(0);
+
+	// Nested loops were already optimized, the outer ones only move their invariants further out
+	if(!__Optimizer_collectLoop(statement, &scope, slots)) {
+		BitSet_free(scope.modified);
+		Array_free(scope.hoisted);
+		Array_free(slots);
+		return NULL;
+	}
+
+	for(size_t i = 0; i < slots->size && !scope.hasCalls; i++) {
+		ExpressionASTNode **slot = Array_get(slots, i);
+		scope.hasCalls = __Optimizer_mayModifyVariables(optimizer, *slot);
+	}
+
+	// Derived induction variables are modified by the loop, they are replaced before looking for the invariants
+	if(statement->_type == NODE_FOR_STATEMENT) {
+		__Optimizer_reduceInductions(optimizer, (ForStatementASTNode*)statement, slots, &scope);
+	}
+
+	for(size_t i = 0; i < slots->size; i++) {
+		__Optimizer_hoistExpression(optimizer, Array_get(slots, i), &scope);
+	}
+
+	BitSet_free(scope.modified);
+	Array_free(slots);
+
+	if(scope.hoisted->size == 0) {
+		Array_free(scope.hoisted);
+		return NULL;
+	}
+
+	Array_push(scope.hoisted, statement);
+
+	return scope.hoisted;
+}
+
+bool __Optimizer_collectLoop(StatementASTNode *loop, LoopScope *scope, Array /*<ExpressionASTNode*>*/ *outSlots) {
+	Array *worklist = Array_alloc(0);
+	size_t loops = 0;
+
+	// Range of the loop itself is evaluated only once
+	if(loop->_type == NODE_WHILE_STATEMENT) {
+		WhileStatementASTNode *whileStatement = (WhileStatementASTNode*)loop;
+		__Optimizer_collectTest(&whileStatement->test, scope, outSlots);
+		Array_push(worklist, whileStatement->body);
+	} else {
+		ForStatementASTNode *forStatement = (ForStatementASTNode*)loop;
+		BitSet_set(scope->modified, forStatement->iterator->id, true);
+		Array_push(worklist, forStatement->body);
+	}
+
+	while(worklist->size > 0 && loops <= OPTIMIZER_HOIST_LOOPS) {
+		ASTNode *node = Array_pop(worklist);
+
+		switch(node->_type) {
+			case NODE_BLOCK: {
+				Array *statements = ((BlockASTNode*)node)->statements;
+
+				for(size_t i = 0; i < statements->size; i++) {
+					ASTNode *statement = Array_get(statements, i);
+					if(statement->_type != NODE_FUNCTION_DECLARATION) Array_push(worklist, statement);
+				}
+			} break;
+
+			case NODE_VARIABLE_DECLARATION: {
+				Array *declarators = ((VariableDeclarationASTNode*)node)->declaratorList->declarators;
+
+				for(size_t i = 0; i < declarators->size; i++) {
+					VariableDeclaratorASTNode *declarator = Array_get(declarators, i);
+					BitSet_set(scope->modified, declarator->pattern->id->id, true);
+					if(declarator->initializer) Array_push(outSlots, &declarator->initializer);
+				}
+			} break;
+
+			case NODE_ASSIGNMENT_STATEMENT: {
+				AssignmentStatementASTNode *assignment = (AssignmentStatementASTNode*)node;
+				BitSet_set(scope->modified, assignment->id->id, true);
+				Array_push(outSlots, &assignment->expression);
+			} break;
+
+			case NODE_EXPRESSION_STATEMENT: {
+				Array_push(outSlots, &((ExpressionStatementASTNode*)node)->expression);
+			} break;
+
+			case NODE_RETURN_STATEMENT: {
+				ReturnStatementASTNode *returnStatement = (ReturnStatementASTNode*)node;
+				if(returnStatement->expression) Array_push(outSlots, &returnStatement->expression);
+			} break;
+
+			case NODE_IF_STATEMENT: {
+				IfStatementASTNode *ifStatement = (IfStatementASTNode*)node;
+				__Optimizer_collectTest(&ifStatement->test, scope, outSlots);
+				Array_push(worklist, ifStatement->body);
+				if(ifStatement->alternate) Array_push(worklist, ifStatement->alternate);
+			} break;
+
+			case NODE_WHILE_STATEMENT: {
+				WhileStatementASTNode *whileStatement = (WhileStatementASTNode*)node;
+				__Optimizer_collectTest(&whileStatement->test, scope, outSlots);
+				Array_push(worklist, whileStatement->body);
+				loops++;
+			} break;
+
+			case NODE_FOR_STATEMENT: {
+				ForStatementASTNode *forStatement = (ForStatementASTNode*)node;
+				loops++;
+				BitSet_set(scope->modified, forStatement->iterator->id, true);
+				BitSet_set(scope->modified, forStatement->range->endId, true);
+
+				for(size_t i = 0; i < forStatement->inductions->size; i++) {
+					InductionVariable *induction = Array_get(forStatement->inductions, i);
+					BitSet_set(scope->modified, induction->id, true);
+				}
+
+				Array_push(outSlots, &forStatement->range->start);
+				Array_push(outSlots, &forStatement->range->end);
+				Array_push(worklist, forStatement->body);
+			} break;
+
+			default: {
+				// Break and continue statements have no expressions
+			} break;
+		}
+	}
+
+	Array_free(worklist);
+
+	return loops <= OPTIMIZER_HOIST_LOOPS;
+}
+
+void __Optimizer_collectTest(ASTNode **test, LoopScope *scope, Array /*<ExpressionASTNode*>*/ *outSlots) {
+	if((*test)->_type == NODE_OPTIONAL_BINDING_CONDITION) {
+		BitSet_set(scope->modified, ((OptionalBindingConditionASTNode*)*test)->id->id, true);
+	} else {
+		Array_push(outSlots, (ExpressionASTNode**)test);
+	}
+}
+
+void __Optimizer_reduceInductions(Optimizer *optimizer, ForStatementASTNode *forStatement, Array /*<ExpressionASTNode*>*/ *slots, LoopScope *scope) {
+	size_t iteratorId = forStatement->iterator->id;
+	Array *worklist = Array_alloc(slots->size);
+
+	for(size_t i = 0; i < slots->size; i++) {
+		Array_push(worklist, Array_get(slots, i));
+	}
+
+	// The largest matching expressions are replaced, the iterator alone is already incremented by the loop
+	while(worklist->size > 0) {
+		ExpressionASTNode **slot = Array_pop(worklist);
+		long scale = 0;
+		long offset = 0;
+
+		if((*slot)->_type == NODE_IDENTIFIER || !__Optimizer_matchInduction(*slot, iteratorId, OPTIMIZER_INDUCTION_DEPTH, &scale, &offset)) {
+			__Optimizer_pushOperandSlots(worklist, *slot);
+			continue;
+		}
+
+		*slot = (ExpressionASTNode*)__Optimizer_getInduction(optimizer, forStatement, scale, offset, scope);
+	}
+
+	Array_free(worklist);
+}
+
+bool __Optimizer_matchInduction(ExpressionASTNode *expression, size_t iteratorId, size_t depth, long *outScale, long *outOffset) {
+	if(expression->_type == NODE_IDENTIFIER) {
+		if(((IdentifierASTNode*)expression)->id != iteratorId) return false;
+
+		*outScale = 1;
+		*outOffset = 0;
+		return true;
+	}
+
+	if(expression->_type != NODE_BINARY_EXPRESSION || depth == 0) return false;
+
+	// One of the operands has to be an integer literal (folded constants included)
+	BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)expression;
+	bool isLiteralLeft = binary->left->_type == NODE_LITERAL_EXPRESSION;
+	LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)(isLiteralLeft ? binary->left : binary->right);
+	ExpressionASTNode *operand = isLiteralLeft ? binary->right : binary->left;
+
+	if(literal->_type != NODE_LITERAL_EXPRESSION || literal->type.type != TYPE_INT) return false;
+	if(!__Optimizer_matchInduction(operand, iteratorId, depth - 1, outScale, outOffset)) return false;
+
+	// Integers wrap around on overflow, the same way the interpreter does
+	unsigned long scale = (unsigned long)*outScale;
+	unsigned long offset = (unsigned long)*outOffset;
+	unsigned long value = (unsigned long)literal->value.integer;
+
+	switch(binary->operator) {
+		case OPERATOR_PLUS: {
+			offset += value;
+		} break;
+
+		case OPERATOR_MINUS: {
+			if(isLiteralLeft) {
+				scale = -scale;
+				offset = value - offset;
+			} else {
+				offset -= value;
+			}
+		} break;
+
+		case OPERATOR_MUL: {
+			scale *= value;
+			offset *= value;
+		} break;
+
+		default: {
+			return false;
+		} break;
+	}
+
+	*outScale = (long)scale;
+	*outOffset = (long)offset;
+
+	return true;
+}
+
+IdentifierASTNode* __Optimizer_getInduction(Optimizer *optimizer, ForStatementASTNode *forStatement, long scale, long offset, LoopScope *scope) {
+	Analyser *analyser = optimizer->analyser;
+	Array *inductions = forStatement->inductions;
+	InductionVariable *induction = NULL;
+
+	for(size_t i = 0; i < inductions->size && !induction; i++) {
+		InductionVariable *current = Array_get(inductions, i);
+		if(current->scale == scale && current->offset == offset) induction = current;
+	}
+
+	if(!induction) {
+		// Assigned by the code generator directly, the same way the iterator is
+		VariableDeclaration *declaration = new_VariableDeclaration(
+			analyser,
+			NULL,
+			false,
+			(ValueType){.type = TYPE_INT, .isNullable = false},
+			String_alloc("__induction__"),
+			false,
+			true
+		);
+		__Optimizer_registerVariable(optimizer, declaration);
+		BitSet_set(scope->modified, declaration->id, true);
+
+		induction = mem_alloc(sizeof(InductionVariable));
+		induction->id = declaration->id;
+		induction->scale = scale;
+		induction->offset = offset;
+		Array_push(inductions, induction);
+	}
+
+	VariableDeclaration *declaration = Analyser_getVariableById(analyser, induction->id);
+	IdentifierASTNode *id = new_IdentifierASTNode(declaration->name);
+	id->id = declaration->id;
+
+	return id;
+}
+
+void __Optimizer_hoistExpression(Optimizer *optimizer, ExpressionASTNode **slot, LoopScope *scope) {
+	Array *worklist = Array_alloc(0);
+	Array *order = Array_alloc(0);
+	Array_push(worklist, slot);
+
+	// Operands end up closer to the top than the operations using them
+	while(worklist->size > 0) {
+		ExpressionASTNode **current = Array_pop(worklist);
+		Array_push(order, current);
+		__Optimizer_pushOperandSlots(worklist, *current);
+	}
+
+	Array *results = Array_alloc(0); // Slot of each evaluated operand if it is invariant, null otherwise
+	Array *operands = Array_alloc(0);
+
+	while(order->size > 0) {
+		ExpressionASTNode **current = Array_pop(order);
+		bool isInvariant = __Optimizer_isInvariantOperation(optimizer, *current, scope);
+
+		operands->size = 0;
+		__Optimizer_pushOperandSlots(operands, *current);
+
+		// Results of the operands are the last ones on the stack
+		size_t base = results->size - operands->size;
+
+		for(size_t i = base; i < results->size; i++) {
+			if(!Array_get(results, i)) isInvariant = false;
+		}
+
+		// Only the largest invariant expressions are hoisted
+		for(size_t i = base; i < results->size && !isInvariant; i++) {
+			ExpressionASTNode **operand = Array_get(results, i);
+			if(operand) __Optimizer_hoistInvariant(optimizer, operand, scope);
+		}
+
+		results->size = base;
+		Array_push(results, isInvariant ? current : NULL);
+	}
+
+	ExpressionASTNode **result = Array_pop(results);
+	if(result) __Optimizer_hoistInvariant(optimizer, result, scope);
+
+	Array_free(worklist);
+	Array_free(order);
+	Array_free(results);
+	Array_free(operands);
+}
+
+void __Optimizer_hoistInvariant(Optimizer *optimizer, ExpressionASTNode **slot, LoopScope *scope) {
+	ExpressionASTNode *expression = *slot;
+
+	// Loading a temporary costs the same as loading a literal or a variable
+	if(expression->_type == NODE_LITERAL_EXPRESSION || expression->_type == NODE_IDENTIFIER) return;
+
+	String *name = String_alloc("__invariant__");
+	IdentifierASTNode *id = new_IdentifierASTNode(name);
+	VariableDeclaratorASTNode *declarator = new_VariableDeclaratorASTNode(new_PatternASTNode(id, NULL), expression);
+	VariableDeclaration *declaration = new_VariableDeclaration(optimizer->analyser, declarator, true, (ValueType){0}, name, true, true);
+
+	// Pattern of the temporary has no type annotation
+	declaration->type = __Optimizer_getExpressionType(optimizer, expression);
+	__Optimizer_registerVariable(optimizer, declaration);
+
+	VariableDeclarationListASTNode *declaratorList = new_VariableDeclarationListASTNode(Array_fromArgs(1, declarator));
+	Array_push(scope->hoisted, new_VariableDeclarationASTNode(declaratorList, true));
+
+	*slot = __Optimizer_cloneExpression((ExpressionASTNode*)id, NULL);
+}
+
+bool __Optimizer_isInvariantOperation(Optimizer *optimizer, ExpressionASTNode *expression, LoopScope *scope) {
+	switch(expression->_type) {
+		case NODE_IDENTIFIER: {
+			size_t id = ((IdentifierASTNode*)expression)->id;
+			if(BitSet_has(scope->modified, id)) return false;
+
+			// Called functions could assign the global variable
+			return !scope->hasCalls || !__Optimizer_readsMutableGlobals(optimizer, expression);
+		} break;
+
+		case NODE_FUNCTION_CALL: {
+			FunctionCallASTNode *call = (FunctionCallASTNode*)expression;
+			return is_func_pure(Analyser_getBuiltInFunctionById(optimizer->analyser, call->id->id));
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			// Unwrapping nil fails at runtime, the loop might not be entered at all
+			return ((UnaryExpressionASTNode*)expression)->operator != OPERATOR_UNWRAP;
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)expression;
+			if(binary->operator != OPERATOR_DIV) return true;
+
+			// Only the division by a literal that can never fail is hoisted
+			if(binary->right->_type != NODE_LITERAL_EXPRESSION) return false;
+
+			LiteralExpressionASTNode *divisor = (LiteralExpressionASTNode*)binary->right;
+			if(divisor->type.type == TYPE_INT) return divisor->value.integer != 0 && divisor->value.integer != -1;
+			if(divisor->type.type == TYPE_DOUBLE) return divisor->value.floating != 0.0;
+
+			return false;
+		} break;
+
+		default: {
+			// Literals and interpolations depend only on their operands
+			return true;
+		} break;
+	}
+}
+
+ValueType __Optimizer_getExpressionType(Optimizer *optimizer, ExpressionASTNode *expression) {
+	switch(expression->_type) {
+		case NODE_LITERAL_EXPRESSION: {
+			return ((LiteralExpressionASTNode*)expression)->type;
+		} break;
+
+		case NODE_IDENTIFIER: {
+			return Analyser_getVariableById(optimizer->analyser, ((IdentifierASTNode*)expression)->id)->type;
+		} break;
+
+		case NODE_FUNCTION_CALL: {
+			return Analyser_getFunctionById(optimizer->analyser, ((FunctionCallASTNode*)expression)->id->id)->returnType;
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			return ((UnaryExpressionASTNode*)expression)->type;
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			return ((BinaryExpressionASTNode*)expression)->type;
+		} break;
+
+		case NODE_INTERPOLATION_EXPRESSION: {
+			return ((InterpolationExpressionASTNode*)expression)->concatenated->type;
+		} break;
+
+		default: {
+			fassertf("[Optimizer] Unexpected expression type.");
+		} break;
+	}
+
+	return (ValueType){.type = TYPE_INVALID, .isNullable = false};
+}
+
+void __Optimizer_registerVariable(Optimizer *optimizer, VariableDeclaration *declaration) {
+	Analyser *analyser = optimizer->analyser;
+
+	// Variables are defined per frame
+	if(optimizer->function) {
+		Array_push(optimizer->function->variables, declaration);
+	} else {
+		Array_push(analyser->variables, declaration);
+		BitSet_set(analyser->globals, declaration->id, true);
+	}
+}
+
+void __Optimizer_pushOperandSlots(Array /*<ExpressionASTNode*>*/ *worklist, ExpressionASTNode *expression) {
+	switch(expression->_type) {
+		case NODE_FUNCTION_CALL: {
+			Array *arguments = ((FunctionCallASTNode*)expression)->argumentList->arguments;
+
+			for(size_t i = 0; i < arguments->size; i++) {
+				ArgumentASTNode *argument = Array_get(arguments, i);
+				Array_push(worklist, &argument->expression);
+			}
+		} break;
+
+		case NODE_UNARY_EXPRESSION: {
+			Array_push(worklist, &((UnaryExpressionASTNode*)expression)->argument);
+		} break;
+
+		case NODE_BINARY_EXPRESSION: {
+			BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)expression;
+			Array_push(worklist, &binary->left);
+			Array_push(worklist, &binary->right);
+		} break;
+
+		case NODE_INTERPOLATION_EXPRESSION: {
+			Array_push(worklist, &((InterpolationExpressionASTNode*)expression)->concatenated);
+		} break;
+
+		default: {
+			// Literals and identifiers have no operands
+		} break;
+	}
+}
+
+void __Optimizer_optimizeBlock_extended(void *context) {
+	OptimizerCall *call = context;
+	__Optimizer_optimizeBlock(call->optimizer, (BlockASTNode*)call->node);
+}
+
+void __Optimizer_foldExpression_extended(void *context) {
+	OptimizerCall *call = context;
+	call->result = (ASTNode*)__Optimizer_foldExpression(call->optimizer, (ExpressionASTNode*)call->node);
+}
+
+/** End of file src/compiler/optimizer/Optimizer.c **/
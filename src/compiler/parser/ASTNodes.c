@@ -95,6 +95,7 @@ ReturnStatementASTNode* new_ReturnStatementASTNode(
 	prepare_node_of(ReturnStatementASTNode, NODE_RETURN_STATEMENT)
 	node->expression = expression;
 	node->id = 0;
+	node->isTailCall = false;
 	return node;
 }
 
@@ -174,6 +175,7 @@ FunctionCallASTNode* new_FunctionCallASTNode(
 	prepare_node_of(FunctionCallASTNode, NODE_FUNCTION_CALL)
 	node->id = id;
 	node->argumentList = argumentList;
+	node->resolutions = NULL;
 	return node;
 }
 
@@ -226,6 +228,7 @@ ForStatementASTNode* new_ForStatementASTNode(IdentifierASTNode *iterator, RangeA
 	node->range = range;
 	node->body = body;
 	node->id = 0;
+	node->inductions = Array_alloc(0);
 	return node;
 }
 
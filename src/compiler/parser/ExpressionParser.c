@@ -12,6 +12,7 @@
 #include "assertf.h"
 #include "allocator/MemoryAllocator.h"
 #include "internal/Array.h"
+#include "internal/CallStack.h"
 #include "compiler/lexer/Token.h"
 #include "compiler/parser/Parser.h"
 #include "compiler/parser/ASTNodes.h"
@@ -21,6 +22,7 @@
 
 ParserResult __Parser_parseFunctionCallExpression(Parser *parser);
 ParserResult __Parser_parseStringInterpolation(Parser *parser);
+void __Parser_parseExpression_extended(void *context);
 PrefixStatus prefix = P_UNRESOLVED;
 bool isPostfix = false;
 
@@ -50,7 +52,7 @@ enum PrecTableIndex Expr_getPrecTbIndex(Token *token, bool isIdentifier, Parser
 		}
 		return I_DOLLAR;
 	}
-	LexerResult postfixPrefix;
+	Token *postfixPrefix;
 
 	switch(token->kind) {
 		case TOKEN_PLUS:
@@ -80,11 +82,11 @@ enum PrecTableIndex Expr_getPrecTbIndex(Token *token, bool isIdentifier, Parser
 					prefix = P_IS_POSTFIX;
 					return I_UNWRAP_OP;
 				}
-				postfixPrefix = Lexer_peekToken(parser->lexer, 0);
-				if(postfixPrefix.success) {
-					if((postfixPrefix.token->type == TOKEN_IDENTIFIER) ||
-					   (postfixPrefix.token->type == TOKEN_LITERAL) ||
-					   (postfixPrefix.token->kind == TOKEN_RIGHT_PAREN)) {
+				postfixPrefix = Lexer_peek(parser->lexer, 0);
+				if(postfixPrefix) {
+					if((postfixPrefix->type == TOKEN_IDENTIFIER) ||
+					   (postfixPrefix->type == TOKEN_LITERAL) ||
+					   (postfixPrefix->kind == TOKEN_RIGHT_PAREN)) {
 						prefix = P_IS_POSTFIX;
 						return I_UNWRAP_OP;
 					}
@@ -93,11 +95,11 @@ enum PrecTableIndex Expr_getPrecTbIndex(Token *token, bool isIdentifier, Parser
 
 			// !x
 			if(!whitespace_right(token->whitespace)) {
-				postfixPrefix = Lexer_peekToken(parser->lexer, 2);
-				if(postfixPrefix.success) {
-					if((postfixPrefix.token->type == TOKEN_IDENTIFIER) ||
-					   (postfixPrefix.token->type == TOKEN_LITERAL) ||
-					   (postfixPrefix.token->kind == TOKEN_LEFT_PAREN)) {
+				postfixPrefix = Lexer_peek(parser->lexer, 2);
+				if(postfixPrefix) {
+					if((postfixPrefix->type == TOKEN_IDENTIFIER) ||
+					   (postfixPrefix->type == TOKEN_LITERAL) ||
+					   (postfixPrefix->kind == TOKEN_LEFT_PAREN)) {
 						prefix = P_IS_PREFIX;
 						return I_NOT;
 					}
@@ -218,7 +220,7 @@ StackItem* Expr_performReduction(Array *stack) {
 		StackItem *operator = Array_pop(stack);
 
 		// E -> E!
-		if(operator->token->kind == TOKEN_EXCLAMATION && argument->Stype == S_NONTERMINAL) {
+		if(operator->token && operator->token->kind == TOKEN_EXCLAMATION && argument->Stype == S_NONTERMINAL) {
 			UnaryExpressionASTNode *unaryE = new_UnaryExpressionASTNode(argument->node, OPERATOR_UNWRAP, false);
 			operator->node = (ExpressionASTNode*)unaryE;
 			operator->Stype = S_NONTERMINAL;
@@ -228,7 +230,7 @@ StackItem* Expr_performReduction(Array *stack) {
 			return operator;
 
 		// E -> !E
-		} else if(operator->Stype == S_NONTERMINAL && argument->token->kind == TOKEN_EXCLAMATION) {
+		} else if(operator->Stype == S_NONTERMINAL && argument->token && argument->token->kind == TOKEN_EXCLAMATION) {
 			UnaryExpressionASTNode *unaryLogE = new_UnaryExpressionASTNode(operator->node, OPERATOR_NOT, true);
 			argument->node = (ExpressionASTNode*)unaryLogE;
 			argument->Stype = S_NONTERMINAL;
@@ -248,7 +250,7 @@ StackItem* Expr_performReduction(Array *stack) {
 		StackItem *rightOperand = Array_pop(stack);
 
 		// E -> (E)
-		if(operator->Stype == S_NONTERMINAL && leftOperand->token->kind == TOKEN_LEFT_PAREN && rightOperand->token->kind == TOKEN_RIGHT_PAREN) {
+		if(operator->Stype == S_NONTERMINAL && leftOperand->token && leftOperand->token->kind == TOKEN_LEFT_PAREN && rightOperand->token && rightOperand->token->kind == TOKEN_RIGHT_PAREN) {
 			mem_free(leftOperand);
 			mem_free(rightOperand);
 
@@ -256,7 +258,7 @@ StackItem* Expr_performReduction(Array *stack) {
 		}
 
 		enum OperatorType operatorType = 0;
-		if(leftOperand->Stype == S_NONTERMINAL && rightOperand->Stype == S_NONTERMINAL)
+		if(leftOperand->Stype == S_NONTERMINAL && rightOperand->Stype == S_NONTERMINAL && operator->token)
 			switch(operator->token->kind) {
 				// E -> E + E
 				case TOKEN_PLUS:
@@ -371,6 +373,13 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 
 	FLUSH_ERROR_BUFFER(parser);
 
+	// Nested function calls in arguments recurse back here
+	if(CallStack_isExhausted()) {
+		ParserExpressionCall call = {.parser = parser};
+		CallStack_extend(__Parser_parseExpression_extended, &call);
+		return call.result;
+	}
+
 	Array *stack = Array_alloc(STACK_SIZE);
 
 	StackItem *bottom = mem_alloc(sizeof(StackItem));
@@ -385,27 +394,27 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 	int offset = 1;
 	enum PrecTableRelation operation = R;
 
-	LexerResult current = Lexer_peekToken(parser->lexer, offset);
+	Token *current = Lexer_peek(parser->lexer, offset);
 
 	while(true) {
-		if(!current.success) return LexerToParserError(current);
+		if(!current) return LexerToParserError(parser->lexer->error);
 		isIdentifier = false;
 
 		if(operation != X) {
 			// check if there is a function call in expression
-			if(current.token->type == TOKEN_IDENTIFIER) {
+			if(current->type == TOKEN_IDENTIFIER) {
 				// Check for '_' identifier
-				if(String_equals(current.token->value.string, "_")) {
+				if(String_equals(current->value.string, "_")) {
 					return ParserError(
 						String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
-						Array_fromArgs(1, current.token)
+						Array_fromArgs(1, current)
 					);
 				}
 
-				LexerResult next = Lexer_peekToken(parser->lexer, offset + 1);
-				if(!next.success) return LexerToParserError(current);
+				Token *next = Lexer_peek(parser->lexer, offset + 1);
+				if(!next) return LexerToParserError(parser->lexer->error);
 
-				if(next.token->kind == TOKEN_LEFT_PAREN) {
+				if(next->kind == TOKEN_LEFT_PAREN) {
 					StackItem *identifier = Expr_getTopTerminal(stack);
 					enum PrecTableIndex identifierIndex = Expr_getPrecTbIndex(identifier->token, isIdentifier, parser, identifier->isPrefix);
 					
@@ -424,18 +433,18 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 						Expr_pushAfterTopTerminal(stack);
 						Array_push(stack, function);
 
-						current = Lexer_peekToken(parser->lexer, offset);
-						if(!current.success) return LexerToParserError(current);
+						current = Lexer_peek(parser->lexer, offset);
+						if(!current) return LexerToParserError(parser->lexer->error);
 					}
 				}
 			}
 
 			// check for string interpolation
-			if(current.token->kind == TOKEN_STRING) {
-				LexerResult next = Lexer_peekToken(parser->lexer, offset + 1);
-				if(!next.success) return LexerToParserError(current);
+			if(current->kind == TOKEN_STRING) {
+				Token *next = Lexer_peek(parser->lexer, offset + 1);
+				if(!next) return LexerToParserError(parser->lexer->error);
 
-				if(next.token->kind == TOKEN_STRING_HEAD) {
+				if(next->kind == TOKEN_STRING_HEAD) {
 					StackItem *id = Expr_getTopTerminal(stack);
 					enum PrecTableIndex idIndex = Expr_getPrecTbIndex(id->token, isIdentifier, parser, id->isPrefix);
 					
@@ -454,8 +463,8 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 						Expr_pushAfterTopTerminal(stack);
 						Array_push(stack, string);
 
-						current = Lexer_peekToken(parser->lexer, offset);
-						if(!current.success) return LexerToParserError(current);
+						current = Lexer_peek(parser->lexer, offset);
+						if(!current) return LexerToParserError(parser->lexer->error);
 					}
 				}
 			}
@@ -463,7 +472,7 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 			StackItem *topTerminal = Expr_getTopTerminal(stack);
 
 			enum PrecTableIndex topTerminalIndex = Expr_getPrecTbIndex(topTerminal->token, isIdentifier, parser, topTerminal->isPrefix);
-			enum PrecTableIndex currentTokenIndex = Expr_getPrecTbIndex(current.token, isIdentifier, parser, P_UNRESOLVED);
+			enum PrecTableIndex currentTokenIndex = Expr_getPrecTbIndex(current, isIdentifier, parser, P_UNRESOLVED);
 
 			operation = precedence_table[topTerminalIndex][currentTokenIndex];
 		}
@@ -484,7 +493,7 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 		switch(operation) {
 			case S: {
 				currentToken->Stype = S_TERMINAL;
-				currentToken->token = current.token;
+				currentToken->token = current;
 				currentToken->node = NULL;
 				if(prefix == P_IS_POSTFIX) {
 					currentToken->isPrefix = P_IS_POSTFIX;
@@ -498,33 +507,31 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 				Expr_pushAfterTopTerminal(stack);
 				Array_push(stack, currentToken);
 
-				LexerResult removeFromTokenStream = Lexer_nextToken(parser->lexer);
-				if(!(removeFromTokenStream.success)) return LexerToParserError(current);
-				current = Lexer_peekToken(parser->lexer, offset);
+				if(!Lexer_next(parser->lexer)) return LexerToParserError(parser->lexer->error);
+				current = Lexer_peek(parser->lexer, offset);
 			} break;
 
 			case R: {
 				reductionSuccess = Expr_Reduce(stack, currentToken);
 				if(!reductionSuccess) {
-					return ParserError(String_fromFormat("Syntax error in expression"), Array_fromArgs(1, current.token));
+					return ParserError(String_fromFormat("Syntax error in expression"), Array_fromArgs(1, current));
 				}
 			} break;
 
 			case E: {
 				currentToken->Stype = S_TERMINAL;
-				currentToken->token = current.token;
+				currentToken->token = current;
 				currentToken->node = NULL;
 				Array_push(stack, currentToken);
 
-				LexerResult removeFromTokenStream = Lexer_nextToken(parser->lexer);
-				if(!(removeFromTokenStream.success)) return LexerToParserError(current);
-				current = Lexer_peekToken(parser->lexer, offset);
+				if(!Lexer_next(parser->lexer)) return LexerToParserError(parser->lexer->error);
+				current = Lexer_peek(parser->lexer, offset);
 			} break;
 
 			case X: {
 				reductionSuccess = Expr_Reduce(stack, currentToken);
 				if(!reductionSuccess) {
-					return ParserError(String_fromFormat("Syntax error in expression"), Array_fromArgs(1, current.token));
+					return ParserError(String_fromFormat("Syntax error in expression"), Array_fromArgs(1, current));
 				}
 			} break;
 
@@ -535,4 +542,9 @@ ParserResult __Parser_parseExpression(Parser *parser) {
 	return ParserNoMatch();
 }
 
+void __Parser_parseExpression_extended(void *context) {
+	ParserExpressionCall *call = context;
+	call->result = __Parser_parseExpression(call->parser);
+}
+
 /** End of file src/compiler/parser/ExpressionParser.c **/
@@ -2,7 +2,7 @@
  * @file src/compiler/parser/Parser.c
  * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
  * @author Radim Mifka <xmifka00@stud.fit.vutbr.cz>
- * @brief Implemetation of recusive descent parser.
+ * @brief Implementation of the table-driven LL(1) parser with hand-written rules for the leaves.
  * @copyright Copyright (c) 2023
  */
 
@@ -11,26 +11,34 @@
 #include <stdbool.h>
 
 #include "assertf.h"
+#include "allocator/MemoryAllocator.h"
 #include "internal/Array.h"
 #include "compiler/parser/ASTNodes.h"
+#include "compiler/parser/LLTable.h"
 #include "compiler/lexer/Lexer.h"
 
 
 /* Register private functions */
 
 ParserResult __Parser_parseProgram(Parser *parser);
-ParserResult __Parser_parseBlock(Parser *parser, bool requireBraces);
-ParserResult __Parser_parseStatement(Parser *parser);
+enum LLSymbol __Parser_getTerminal(Token *token);
+void __Parser_openBlock(Parser *parser, bool requireBraces);
+ParserResult __Parser_matchTerminal(Parser *parser, enum LLSymbol symbol, Token *lookahead);
+unsigned char __Parser_selectRule(enum LLSymbol symbol, enum LLSymbol terminal);
+void __Parser_expandRule(Parser *parser, enum LLSymbol symbol, unsigned char rule);
+ParserResult __Parser_expandNonTerminal(Parser *parser, enum LLSymbol symbol, Token *lookahead);
+ParserResult __Parser_reduce(Parser *parser, enum LLSymbol symbol);
+bool __Parser_recover(Parser *parser, ParserResult error);
 ParserResult __Parser_parseExpression(Parser *parser);
 ParserResult __Parser_parseTypeReference(Parser *parser);
 ParserResult __Parser_parseParameter(Parser *parser);
 ParserResult __Parser_parseParameterList(Parser *parser);
-ParserResult __Parser_parseFuncStatement(Parser *parser);
+ParserResult __Parser_parseFunctionName(Parser *parser);
 ParserResult __Parser_parsePattern(Parser *parser);
 ParserResult __Parser_parseOptionalBindingCondition(Parser *parser);
 ParserResult __Parser_parseTest(Parser *parser);
-ParserResult __Parser_parseIfStatement(Parser *parser);
-ParserResult __Parser_parseWhileStatement(Parser *parser);
+ParserResult __Parser_parseCondition(Parser *parser);
+ParserResult __Parser_parseIterator(Parser *parser);
 ParserResult __Parser_parseReturnStatement(Parser *parser);
 ParserResult __Parser_parseVariableDeclarator(Parser *parser);
 ParserResult __Parser_parseVariableDeclarationList(Parser *parser);
@@ -39,8 +47,8 @@ ParserResult __Parser_parseArgument(Parser *parser);
 ParserResult __Parser_parseArgumentList(Parser *parser);
 ParserResult __Parser_parseFunctionCallExpression(Parser *parser);
 ParserResult __Parser_parseAssignmentStatement(Parser *parser);
+ParserResult __Parser_parseExpressionStatement(Parser *parser);
 ParserResult __Parser_parseRange(Parser *parser);
-ParserResult __Parser_parseForStatement(Parser *parser);
 ParserResult __Parser_parseBreakStatement(Parser *parser);
 ParserResult __Parser_parseContinueStatement(Parser *parser);
 
@@ -52,10 +60,32 @@ void Parser_constructor(Parser *parser, Lexer *lexer) {
 
 	parser->lexer = lexer;
 	parser->lastLexerError = LexerErrorCustom(RESULT_INVALID, NULL, NULL);
+	parser->diagnostics = Array_alloc(0);
+	parser->symbols = Array_alloc(32);
+	parser->values = Array_alloc(32);
+	parser->frames = Array_alloc(8);
+	parser->framePool = Array_alloc(8);
 }
 
 void Parser_destructor(Parser *parser) {
 	parser->lexer = NULL;
+
+	Array_free(parser->diagnostics);
+	parser->diagnostics = NULL;
+
+	Array_free(parser->symbols);
+	parser->symbols = NULL;
+
+	Array_free(parser->values);
+	parser->values = NULL;
+
+	while(parser->frames->size > 0) mem_free(Array_pop(parser->frames));
+	Array_free(parser->frames);
+	parser->frames = NULL;
+
+	while(parser->framePool->size > 0) mem_free(Array_pop(parser->framePool));
+	Array_free(parser->framePool);
+	parser->framePool = NULL;
 }
 
 void Parser_setLexer(Parser *parser, Lexer *lexer) {
@@ -88,193 +118,574 @@ bool Parser_isAtEnd(Parser *parser) {
 	assertf(parser != NULL);
 	assertf(parser->lexer != NULL);
 
-	LexerResult result = Lexer_peekToken(parser->lexer, 1);
-	if(!result.success) {
-		parser->lastLexerError = result;
+	Token *token = Lexer_peek(parser->lexer, 1);
+	if(!token) {
+		parser->lastLexerError = parser->lexer->error;
 		return false;
 	}
 
-	return result.token->type == TOKEN_EOF;
+	return token->type == TOKEN_EOF;
 }
 
 ParserResult Parser_parse(Parser *parser) {
 	assertf(parser != NULL);
 	assertf(parser->lexer != NULL);
 
-	return __Parser_parseProgram(parser);
+	Array_clear(parser->diagnostics);
+
+	ParserResult result = __Parser_parseProgram(parser);
+
+	// Errors that could not be recovered from (e.g. lexical ones) end the parsing
+	if(!result.success) {
+		Array_push(parser->diagnostics, ParserResult_alloc(result.type, result.severity, result.message, result.markers, NULL));
+	}
+
+	// Report the first error, the rest is available in the diagnostics
+	if(parser->diagnostics->size > 0) {
+		ParserResult *error = Array_get(parser->diagnostics, 0);
+		return *error;
+	}
+
+	return result;
 }
 
 
 /* Definitions of private functions */
 
+/**
+ * Stack entries of the LL driver are either grammar symbols (enum LLSymbol) or
+ * reduction markers, which build the AST node once the whole rule is parsed.
+ */
+#define LL_REDUCE(symbol) (LL_SYMBOL_COUNT + (symbol))
+#define is_ll_reduction(entry) ((entry) >= LL_SYMBOL_COUNT)
+
+// Stacks of the driver are never shrunk, they would be reallocated back and forth otherwise
+#define push_symbol(stack, symbol) ( \
+	(stack)->size < (stack)->capacity \
+		? (void)((stack)->data[(stack)->size++] = (void*)(size_t)(symbol)) \
+		: Array_push(stack, (void*)(size_t)(symbol)) \
+)
+#define pop_symbol(stack) ((size_t)(stack)->data[--(stack)->size])
+#define pop_value(stack) ((stack)->data[--(stack)->size])
+
 ParserResult __Parser_parseProgram(Parser *parser) {
 	assertf(parser != NULL);
 
 	FLUSH_ERROR_BUFFER(parser);
 
-	ParserResult result = __Parser_parseBlock(parser, false);
-	if(!result.success) return result;
+	Array *symbols = parser->symbols;
+	Array *values = parser->values;
+	Array *frames = parser->frames;
+
+	Array_clear(symbols);
+	Array_clear(values);
+	while(frames->size > 0) Array_push(parser->framePool, Array_pop(frames));
+
+	// Augmented start rule (program → statements $), the program itself
+	// is the outermost block without braces
+	push_symbol(symbols, LL_T_EOF);
+	__Parser_openBlock(parser, false);
+	push_symbol(symbols, LL_N_STATEMENTS);
+
+	// Lookahead is peeked only once per consumed token
+	Token *lookahead = NULL;
+	enum LLSymbol terminal = LL_NONE;
+	int lookaheadIndex = -2;
+
+	while(symbols->size > 0) {
+		size_t entry = pop_symbol(symbols);
+		ParserResult result;
+
+		if(!is_ll_reduction(entry) && lookaheadIndex != parser->lexer->currentTokenIndex) {
+			lookahead = Lexer_peek(parser->lexer, 1);
+			if(!lookahead) return LexerToParserError(parser->lexer->error);
+
+			terminal = __Parser_getTerminal(lookahead);
+			lookaheadIndex = parser->lexer->currentTokenIndex;
+		}
+
+		if(is_ll_reduction(entry)) {
+			result = __Parser_reduce(parser, entry - LL_SYMBOL_COUNT);
+		} else if(is_ll_terminal(entry)) {
+			// Matching terminal is just consumed (it has already been peeked, so it cannot fail),
+			// only block delimiters need special handling
+			if(entry == terminal && entry != LL_T_LEFT_BRACE && entry != LL_T_EOF) {
+				Lexer_next(parser->lexer);
+				continue;
+			}
+
+			result = __Parser_matchTerminal(parser, entry, lookahead);
+		} else {
+			unsigned char rule = __Parser_selectRule(entry, terminal);
+			if(rule) {
+				__Parser_expandRule(parser, entry, rule);
+				continue;
+			}
+
+			result = __Parser_expandNonTerminal(parser, entry, lookahead);
+		}
+
+		if(!result.success) {
+			// Put the entry back, it may be the terminator of the current block
+			push_symbol(symbols, entry);
+
+			if(!__Parser_recover(parser, result)) {
+				FLUSH_ERROR_BUFFER(parser);
+				return result;
+			}
+		}
+	}
 
 	FLUSH_ERROR_BUFFER(parser);
 
-	ProgramASTNode *program = new_ProgramASTNode((BlockASTNode*)result.node);
+	ParserBlockFrame *frame = Array_get(frames, 0);
+	ProgramASTNode *program = new_ProgramASTNode(new_BlockASTNode(frame->statements));
 	return ParserSuccess(program);
 }
 
-ParserResult __Parser_parseBlock(Parser *parser, bool requireBraces) {
+enum LLSymbol __Parser_getTerminal(Token *token) {
+	if(token->type == TOKEN_EOF) return LL_T_EOF;
+	if(token->type == TOKEN_IDENTIFIER) return LL_T_IDENTIFIER;
+
+	switch(token->kind) {
+		case TOKEN_LEFT_BRACE: return LL_T_LEFT_BRACE;
+		case TOKEN_RIGHT_BRACE: return LL_T_RIGHT_BRACE;
+		case TOKEN_LEFT_PAREN: return LL_T_LEFT_PAREN;
+		case TOKEN_RIGHT_PAREN: return LL_T_RIGHT_PAREN;
+		case TOKEN_ARROW: return LL_T_ARROW;
+		case TOKEN_COMMA: return LL_T_COMMA;
+		case TOKEN_COLON: return LL_T_COLON;
+		case TOKEN_EQUAL: return LL_T_EQUAL;
+		case TOKEN_RANGE: return LL_T_RANGE;
+		case TOKEN_HALF_OPEN_RANGE: return LL_T_HALF_OPEN_RANGE;
+		case TOKEN_FUNC: return LL_T_FUNC;
+		case TOKEN_LET: return LL_T_LET;
+		case TOKEN_VAR: return LL_T_VAR;
+		case TOKEN_IF: return LL_T_IF;
+		case TOKEN_ELSE: return LL_T_ELSE;
+		case TOKEN_WHILE: return LL_T_WHILE;
+		case TOKEN_FOR: return LL_T_FOR;
+		case TOKEN_IN: return LL_T_IN;
+		case TOKEN_CONTINUE: return LL_T_CONTINUE;
+		case TOKEN_BREAK: return LL_T_BREAK;
+		case TOKEN_RETURN: return LL_T_RETURN;
+		default: return LL_T_EXPRESSION;
+	}
+}
+
+void __Parser_openBlock(Parser *parser, bool requireBraces) {
 	assertf(parser != NULL);
 
-	FLUSH_ERROR_BUFFER(parser);
+	// Frames of the closed blocks are reused
+	ParserBlockFrame *frame = parser->framePool->size > 0 ? Array_pop(parser->framePool) : mem_alloc(sizeof(ParserBlockFrame));
+	frame->statements = Array_alloc(0);
+	frame->symbolBase = parser->symbols->size;
+	frame->valueBase = parser->values->size;
+	frame->statementStart = parser->lexer->currentTokenIndex;
+	frame->requireBraces = requireBraces;
 
-	// Check for left brace
-	if(requireBraces) {
-		LexerResult result = Lexer_nextToken(parser->lexer);
-		if(!result.success) return LexerToParserError(result);
+	Array_push(parser->frames, frame);
+}
 
-		if(result.token->kind != TOKEN_LEFT_BRACE) {
+ParserResult __Parser_matchTerminal(Parser *parser, enum LLSymbol symbol, Token *lookahead) {
+	assertf(parser != NULL);
+	assertf(lookahead != NULL);
+
+	if(__Parser_getTerminal(lookahead) != symbol) {
+		if(symbol == LL_T_LEFT_BRACE || symbol == LL_T_RIGHT_BRACE || symbol == LL_T_EOF) {
 			return ParserError(
-				String_fromFormat("expected '{' in block body, but got '%s'", Token_toString(result.token)),
-				Array_fromArgs(1, result.token)
+				String_fromFormat("expected '%s' in block body, but got '%s'", symbol == LL_T_LEFT_BRACE ? "{" : "}", Token_toString(lookahead)),
+				Array_fromArgs(1, lookahead)
 			);
 		}
+
+		return ParserError(
+			String_fromFormat("expected '%s', but got '%s'", LL_SYMBOL_NAMES[symbol], Token_toString(lookahead)),
+			Array_fromArgs(1, lookahead)
+		);
 	}
 
-	// Parse statements
-	Array *statements = Array_alloc(0);
+	// The end of input is never consumed
+	if(symbol == LL_T_EOF) return ParserNoMatch();
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	LexerResult result = Lexer_nextToken(parser->lexer);
+	if(!result.success) return LexerToParserError(result);
+
+	// Every '{' at the statement level starts a new block, its body (statements) is already on the stack,
+	// so it is moved above the base of the new block
+	if(symbol == LL_T_LEFT_BRACE) {
+		(void)pop_symbol(parser->symbols);
+		__Parser_openBlock(parser, true);
+		push_symbol(parser->symbols, LL_N_STATEMENTS);
+	}
+
+	return ParserNoMatch();
+}
 
-	while(!Parser_isAtEnd(parser) && (!requireBraces || (requireBraces && peek.token->kind != TOKEN_RIGHT_BRACE))) {
-		ParserResult result = __Parser_parseStatement(parser);
-		if(!result.success) return result;
+/**
+ * Selects the rule to expand the non-terminal with.
+ * @param symbol Non-terminal on the top of the stack
+ * @param terminal Terminal of the lookahead
+ * @return Rule from the LL table, or 0 if there is none or the non-terminal is parsed by a hand-written function
+ */
+unsigned char __Parser_selectRule(enum LLSymbol symbol, enum LLSymbol terminal) {
+	switch(symbol) {
+		case LL_N_FUNCTION_NAME:
+		case LL_N_PARAMETER_CLAUSE:
+		case LL_N_TYPE:
+		case LL_N_CONDITION:
+		case LL_N_VARIABLE_NAME:
+		case LL_N_RANGE:
+		case LL_N_VARIABLE_DECLARATION:
+		case LL_N_EXPRESSION_STATEMENT:
+		case LL_N_CONTINUE_STATEMENT:
+		case LL_N_BREAK_STATEMENT:
+		case LL_N_RETURN_STATEMENT:
+			return 0;
+		default:
+			return LL_TABLE[symbol - LL_NON_TERMINAL_FIRST][terminal - LL_TERMINAL_FIRST];
+	}
+}
+
+void __Parser_expandRule(Parser *parser, enum LLSymbol symbol, unsigned char rule) {
+	assertf(parser != NULL);
+
+	const unsigned char *rhs = LL_RULES[rule];
+
+	if(symbol == LL_N_STATEMENTS) {
+		// Remember where the statement starts for the error recovery
+		ParserBlockFrame *frame = Array_get(parser->frames, -1);
+		frame->statementStart = parser->lexer->currentTokenIndex;
+	} else if(rhs[0] == LL_NONE) {
+		// Omitted optional part of the statement (else clause, return type...)
+		Array_push(parser->values, NULL);
+	}
+
+	switch(symbol) {
+		case LL_N_CODE_BLOCK:
+		case LL_N_STATEMENT:
+		case LL_N_FUNCTION_DECLARATION:
+		case LL_N_IF_STATEMENT:
+		case LL_N_WHILE_STATEMENT:
+		case LL_N_FOR_IN_STATEMENT:
+			push_symbol(parser->symbols, LL_REDUCE(symbol));
+			break;
+		default:
+			break;
+	}
+
+	// Push the right side in reverse order
+	int length = 0;
+	while(length < LL_MAX_RULE_LENGTH && rhs[length] != LL_NONE) length++;
+	for(int i = length - 1; i >= 0; i--) push_symbol(parser->symbols, rhs[i]);
+}
+
+ParserResult __Parser_expandNonTerminal(Parser *parser, enum LLSymbol symbol, Token *lookahead) {
+	assertf(parser != NULL);
+	assertf(lookahead != NULL);
+
+	// Rules not covered by the table are parsed by the hand-written functions
+	ParserResult result = ParserNoMatch();
+
+	switch(symbol) {
+		case LL_N_FUNCTION_NAME: result = __Parser_parseFunctionName(parser); break;
+		case LL_N_PARAMETER_CLAUSE: result = __Parser_parseParameterList(parser); break;
+		case LL_N_TYPE: result = __Parser_parseTypeReference(parser); break;
+		case LL_N_CONDITION: result = __Parser_parseCondition(parser); break;
+		case LL_N_VARIABLE_NAME: result = __Parser_parseIterator(parser); break;
+		case LL_N_RANGE: result = __Parser_parseRange(parser); break;
+		case LL_N_VARIABLE_DECLARATION: result = __Parser_parseVariableDeclarationStatement(parser); break;
+		case LL_N_EXPRESSION_STATEMENT: result = __Parser_parseExpressionStatement(parser); break;
+		case LL_N_CONTINUE_STATEMENT: result = __Parser_parseContinueStatement(parser); break;
+		case LL_N_BREAK_STATEMENT: result = __Parser_parseBreakStatement(parser); break;
+		case LL_N_RETURN_STATEMENT: result = __Parser_parseReturnStatement(parser); break;
+
+		default: {
+			// There is no rule for the lookahead (see __Parser_selectRule)
+			if(symbol == LL_N_CODE_BLOCK || symbol == LL_N_ELSE_BODY || symbol == LL_N_FUNCTION_BODY) {
+				return ParserError(
+					String_fromFormat("expected '{' in block body, but got '%s'", Token_toString(lookahead)),
+					Array_fromArgs(1, lookahead)
+				);
+			}
 
-		if(result.type == RESULT_NO_MATCH) {
 			return ParserError(
-				String_fromFormat("expected '}' in block body, but got '%s'", Token_toString(peek.token)),
-				Array_fromArgs(1, peek.token)
+				String_fromFormat("unexpected '%s' in %s", Token_toString(lookahead), LL_SYMBOL_NAMES[symbol]),
+				Array_fromArgs(1, lookahead)
 			);
 		}
+	}
 
-		Array_push(statements, result.node);
+	if(!result.success) return result;
 
-		// Check for delimiter after statement
-		peek = Lexer_peekToken(parser->lexer, 1);
-		if(!peek.success) return LexerToParserError(peek);
+	if(result.type == RESULT_NO_MATCH) {
+		Token *peek = Lexer_peek(parser->lexer, 1);
+		if(!peek) return LexerToParserError(parser->lexer->error);
 
-		// They don't want us to have semicolons :(
-		if(peek.token->kind == TOKEN_SEMICOLON) {
-			return ParserError(
-				String_fromFormat("';' is not supported after statement, use new line instead"),
-				Array_fromArgs(1, peek.token)
-			);
-		} else if(!(peek.token->whitespace & WHITESPACE_LEFT_NEWLINE) && !Parser_isAtEnd(parser)) {
-			if((requireBraces && peek.token->kind != TOKEN_RIGHT_BRACE) || !requireBraces) {
+		return ParserError(
+			String_fromFormat("expected '}' in block body, but got '%s'", Token_toString(peek)),
+			Array_fromArgs(1, peek)
+		);
+	}
+
+	Array_push(parser->values, result.node);
+	return ParserNoMatch();
+}
+
+ParserResult __Parser_reduce(Parser *parser, enum LLSymbol symbol) {
+	assertf(parser != NULL);
+
+	switch(symbol) {
+		case LL_N_STATEMENT: {
+			ParserBlockFrame *frame = Array_get(parser->frames, -1);
+			Array_push(frame->statements, pop_value(parser->values));
+
+			// Check for delimiter after statement
+			Token *peek = Lexer_peek(parser->lexer, 1);
+			if(!peek) return LexerToParserError(parser->lexer->error);
+
+			// The statement itself is fine, only the rest of the line is skipped on error
+			frame->statementStart = parser->lexer->currentTokenIndex;
+
+			// They don't want us to have semicolons :(
+			if(peek->kind == TOKEN_SEMICOLON) {
 				return ParserError(
-					String_fromFormat("expected new line after statement"),
-					Array_fromArgs(1, peek.token)
+					String_fromFormat("';' is not supported after statement, use new line instead"),
+					Array_fromArgs(1, peek)
 				);
+			} else if(!(peek->whitespace & WHITESPACE_LEFT_NEWLINE) && !Parser_isAtEnd(parser)) {
+				if((frame->requireBraces && peek->kind != TOKEN_RIGHT_BRACE) || !frame->requireBraces) {
+					return ParserError(
+						String_fromFormat("expected new line after statement"),
+						Array_fromArgs(1, peek)
+					);
+				}
 			}
-		}
-	}
 
-	// Check for right brace
-	if(requireBraces) {
-		LexerResult result = Lexer_nextToken(parser->lexer);
-		if(!result.success) return LexerToParserError(result);
+			FLUSH_ERROR_BUFFER(parser);
+		} break;
 
-		if(result.token->kind != TOKEN_RIGHT_BRACE) {
-			return ParserError(
-				String_fromFormat("expected '}' in block body, but got '%s'", Token_toString(result.token)),
-				Array_fromArgs(1, result.token)
-			);
-		}
+		case LL_N_CODE_BLOCK: {
+			ParserBlockFrame *frame = Array_pop(parser->frames);
+			Array_push(parser->values, new_BlockASTNode(frame->statements));
+			Array_push(parser->framePool, frame);
+		} break;
+
+		case LL_N_FUNCTION_DECLARATION: {
+			BlockASTNode *body = pop_value(parser->values);
+			TypeReferenceASTNode *returnType = pop_value(parser->values);
+			ParameterListASTNode *parameterList = pop_value(parser->values);
+			IdentifierASTNode *id = pop_value(parser->values);
+
+			if(!body) {
+				Token *peek = Lexer_peek(parser->lexer, 1);
+				if(!peek) return LexerToParserError(parser->lexer->error);
+
+				return ParserError(
+					String_fromFormat("expected '{' in block body, but got '%s'", Token_toString(peek)),
+					Array_fromArgs(1, peek)
+				);
+			}
+
+			Array_push(parser->values, new_FunctionDeclarationASTNode(id, parameterList, returnType, body));
+		} break;
+
+		case LL_N_IF_STATEMENT: {
+			ASTNode *alternate = pop_value(parser->values);
+			BlockASTNode *body = pop_value(parser->values);
+			ASTNode *test = pop_value(parser->values);
+
+			Array_push(parser->values, new_IfStatementASTNode(test, body, alternate));
+		} break;
+
+		case LL_N_WHILE_STATEMENT: {
+			BlockASTNode *body = pop_value(parser->values);
+			ASTNode *test = pop_value(parser->values);
+
+			Array_push(parser->values, new_WhileStatementASTNode(test, body));
+		} break;
+
+		case LL_N_FOR_IN_STATEMENT: {
+			BlockASTNode *body = pop_value(parser->values);
+			RangeASTNode *range = pop_value(parser->values);
+			IdentifierASTNode *iterator = pop_value(parser->values);
+
+			Array_push(parser->values, new_ForStatementASTNode(iterator, range, body));
+		} break;
+
+		default:
+			fassertf("Unexpected reduction of '%s'", LL_SYMBOL_NAMES[symbol]);
 	}
 
-	BlockASTNode *block = new_BlockASTNode(statements);
-	return ParserSuccess(block);
+	return ParserNoMatch();
 }
 
-ParserResult __Parser_parseStatement(Parser *parser) {
+/**
+ * Records a syntax error and synchronizes the token stream to the start of the next statement
+ * (first token on a new line) or to the closing brace of the current block, whichever comes first.
+ * Nested blocks are skipped as a whole. At least one token is always consumed, to prevent
+ * getting stuck on the same statement forever. The partially parsed statement is discarded.
+ * @param parser
+ * @param error Error to be recorded
+ * @return true if the parsing can continue, false otherwise
+ */
+bool __Parser_recover(Parser *parser, ParserResult error) {
 	assertf(parser != NULL);
 
-	FLUSH_ERROR_BUFFER(parser);
+	// Only syntax errors can be recovered from, the lexer cannot continue after an error
+	if(error.type != RESULT_ERROR_SYNTACTIC_ANALYSIS) return false;
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Array_push(parser->diagnostics, ParserResult_alloc(error.type, error.severity, error.message, error.markers, NULL));
 
-	if(peek.token->kind == TOKEN_FUNC) {
-		ParserResult funcResult = __Parser_parseFuncStatement(parser);
-		if(!funcResult.success) return funcResult;
-		return ParserSuccess(funcResult.node);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) {
+		parser->lastLexerError = parser->lexer->error;
+		return false;
 	}
 
-	if(peek.token->kind == TOKEN_IF) {
-		ParserResult ifResult = __Parser_parseIfStatement(parser);
-		if(!ifResult.success) return ifResult;
-		return ParserSuccess(ifResult.node);
+	// There is nothing more to parse, all of the open blocks are left unterminated
+	if(peek->type == TOKEN_EOF) {
+		while(parser->frames->size > 1) Array_push(parser->framePool, Array_pop(parser->frames));
 	}
 
-	if(peek.token->kind == TOKEN_WHILE) {
-		ParserResult whileResult = __Parser_parseWhileStatement(parser);
-		if(!whileResult.success) return whileResult;
-		return ParserSuccess(whileResult.node);
+	// Drop the rest of the current statement
+	ParserBlockFrame *frame = Array_get(parser->frames, -1);
+	parser->symbols->size = frame->symbolBase;
+	parser->values->size = frame->valueBase;
+
+	bool mustAdvance = parser->lexer->currentTokenIndex == frame->statementStart;
+	int depth = 0;
+
+	while(true) {
+		Token *token = Lexer_peek(parser->lexer, 1);
+		if(!token) {
+			parser->lastLexerError = parser->lexer->error;
+			return false;
+		}
+
+		if(token->type == TOKEN_EOF) break;
+
+		if(!mustAdvance && depth == 0) {
+			if(frame->requireBraces && token->kind == TOKEN_RIGHT_BRACE) break;
+			if(token->whitespace & WHITESPACE_LEFT_NEWLINE) break;
+		}
+
+		if(token->kind == TOKEN_LEFT_BRACE) depth++;
+		else if(token->kind == TOKEN_RIGHT_BRACE && depth > 0) depth--;
+
+		Lexer_next(parser->lexer);
+		mustAdvance = false;
 	}
 
-	if(peek.token->kind == TOKEN_FOR) {
-		ParserResult forResult = __Parser_parseForStatement(parser);
-		if(!forResult.success) return forResult;
-		return ParserSuccess(forResult.node);
+	// Continue with the next statement of the block
+	push_symbol(parser->symbols, LL_N_STATEMENTS);
+
+	return true;
+}
+
+ParserResult __Parser_parseFunctionName(Parser *parser) {
+	assertf(parser != NULL);
+
+	FLUSH_ERROR_BUFFER(parser);
+
+	// Consume the identifier
+	LexerResult result = Lexer_nextToken(parser->lexer);
+	if(!result.success) return LexerToParserError(result);
+
+	if(result.token->type != TOKEN_IDENTIFIER) {
+		return ParserError(
+			String_fromFormat("expected identifier in function declaration"),
+			Array_fromArgs(1, result.token));
 	}
 
-	if(peek.token->kind == TOKEN_RETURN) {
-		ParserResult returnResult = __Parser_parseReturnStatement(parser);
-		if(!returnResult.success) return returnResult;
-		return ParserSuccess(returnResult.node);
+	// Check for '_' identifier
+	if(String_equals(result.token->value.string, "_")) {
+		return ParserError(
+			String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
+			Array_fromArgs(1, result.token)
+		);
 	}
 
-	if(peek.token->kind == TOKEN_BREAK) {
-		ParserResult breakResult = __Parser_parseBreakStatement(parser);
-		if(!breakResult.success) return breakResult;
-		return ParserSuccess(breakResult.node);
+	IdentifierASTNode *funcId = new_IdentifierASTNode(result.token->value.string);
+	return ParserSuccess(funcId);
+}
+
+ParserResult __Parser_parseCondition(Parser *parser) {
+	assertf(parser != NULL);
+
+	FLUSH_ERROR_BUFFER(parser);
+
+	// The keyword of the statement has just been consumed
+	Token *keyword = Array_get(parser->lexer->tokens, parser->lexer->currentTokenIndex);
+	char *statement = keyword->kind == TOKEN_WHILE ? "while" : "if";
+
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
+
+	// look more into this
+	if(peek->kind == TOKEN_LEFT_BRACE) {
+		return ParserError(
+			String_fromFormat("missing condition in '%s' statement", statement),
+			Array_fromArgs(1, peek));
 	}
 
-	if(peek.token->kind == TOKEN_CONTINUE) {
-		ParserResult continueResult = __Parser_parseContinueStatement(parser);
-		if(!continueResult.success) return continueResult;
-		return ParserSuccess(continueResult.node);
+	if((keyword->kind == TOKEN_IF && peek->kind == TOKEN_ELSE) || peek->type == TOKEN_EOF) {
+		return ParserError(
+			String_fromFormat("expected expression, var, or let in '%s' condition", statement),
+			Array_fromArgs(1, peek));
 	}
 
-	if(peek.token->kind == TOKEN_LET || peek.token->kind == TOKEN_VAR) {
-		ParserResult variableDeclarationResult = __Parser_parseVariableDeclarationStatement(parser);
-		if(!variableDeclarationResult.success) return variableDeclarationResult;
-		return ParserSuccess(variableDeclarationResult.node);
+	return __Parser_parseTest(parser);
+}
+
+ParserResult __Parser_parseIterator(Parser *parser) {
+	assertf(parser != NULL);
+
+	FLUSH_ERROR_BUFFER(parser);
+
+	// Parse iterator identifier
+	LexerResult iteratorResult = Lexer_nextToken(parser->lexer);
+	if(!iteratorResult.success) return LexerToParserError(iteratorResult);
+
+	if(iteratorResult.token->type != TOKEN_IDENTIFIER) {
+		return ParserError(
+			String_fromFormat("expected identifier in for statement"),
+			Array_fromArgs(1, iteratorResult.token));
 	}
 
-	if(peek.token->type == TOKEN_IDENTIFIER) {
-		LexerResult tmp = Lexer_peekToken(parser->lexer, 2);
-		if(!tmp.success) return LexerToParserError(tmp);
+	IdentifierASTNode *iterator = new_IdentifierASTNode(iteratorResult.token->value.string);
+	return ParserSuccess(iterator);
+}
 
-		if(tmp.token->kind == TOKEN_EQUAL) {
-			ParserResult assignmentStatementResult = __Parser_parseAssignmentStatement(parser);
-			if(!assignmentStatementResult.success) return assignmentStatementResult;
-			return ParserSuccess(assignmentStatementResult.node);
-		} else if(tmp.token->kind == TOKEN_LEFT_PAREN) {
-			// Check for '_' identifier
-			if(String_equals(peek.token->value.string, "_")) {
-				return ParserError(
-					String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
-					Array_fromArgs(1, peek.token)
-				);
-			}
+ParserResult __Parser_parseExpressionStatement(Parser *parser) {
+	assertf(parser != NULL);
+
+	FLUSH_ERROR_BUFFER(parser);
 
-			// function call
-			ParserResult functionCallExpression = __Parser_parseFunctionCallExpression(parser);
-			if(!functionCallExpression.success) return functionCallExpression;
-			ExpressionStatementASTNode *expressionStatement = new_ExpressionStatementASTNode((ExpressionASTNode*)functionCallExpression.node);
-			return ParserSuccess(expressionStatement);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
+
+	Token *tmp = Lexer_peek(parser->lexer, 2);
+	if(!tmp) return LexerToParserError(parser->lexer->error);
+
+	if(tmp->kind == TOKEN_EQUAL) {
+		return __Parser_parseAssignmentStatement(parser);
+	}
+
+	if(tmp->kind == TOKEN_LEFT_PAREN) {
+		// Check for '_' identifier
+		if(String_equals(peek->value.string, "_")) {
+			return ParserError(
+				String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
+				Array_fromArgs(1, peek)
+			);
 		}
 
+		// function call
+		ParserResult functionCallExpression = __Parser_parseFunctionCallExpression(parser);
+		if(!functionCallExpression.success) return functionCallExpression;
+		ExpressionStatementASTNode *expressionStatement = new_ExpressionStatementASTNode((ExpressionASTNode*)functionCallExpression.node);
+		return ParserSuccess(expressionStatement);
 	}
 
 	return ParserNoMatch();
@@ -313,12 +724,12 @@ ParserResult __Parser_parseTypeReference(Parser *parser) {
 	}
 
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
 
 	// nullable type
-	if(peek.token->kind == TOKEN_QUESTION) {
+	if(peek->kind == TOKEN_QUESTION) {
 		nullable = true;
 		// Skip the '?' token
 		LexerResult tmp = Lexer_nextToken(parser->lexer);
@@ -341,7 +752,7 @@ ParserResult __Parser_parseParameter(Parser *parser) {
 	IdentifierASTNode *paramExternalId = NULL;
 	ExpressionASTNode *initializer = NULL;
 
-	LexerResult peek;
+	Token *peek;
 	LexerResult result = Lexer_nextToken(parser->lexer);
 
 	if(!result.success) return LexerToParserError(result);
@@ -360,11 +771,11 @@ ParserResult __Parser_parseParameter(Parser *parser) {
 
 	paramLocalId = new_IdentifierASTNode(result.token->value.string);
 
-	peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
 	// second parameter name exists
-	if(peek.token->type == TOKEN_IDENTIFIER) {
+	if(peek->type == TOKEN_IDENTIFIER) {
 		LexerResult result = Lexer_nextToken(parser->lexer);
 		if(!result.success) return LexerToParserError(result);
 
@@ -388,9 +799,9 @@ ParserResult __Parser_parseParameter(Parser *parser) {
 
 
 	// check for initializer
-	peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
-	if(peek.token->kind == TOKEN_EQUAL) {
+	peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
+	if(peek->kind == TOKEN_EQUAL) {
 		// Skip the '=' token
 		LexerResult tmp = Lexer_nextToken(parser->lexer);
 		if(!tmp.success) return LexerToParserError(result);
@@ -421,20 +832,20 @@ ParserResult __Parser_parseParameterList(Parser *parser) {
 
 	// parser parameter-list
 	Array *parameters = Array_alloc(0);
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	while(peek.token->kind != TOKEN_RIGHT_PAREN) {
+	while(peek->kind != TOKEN_RIGHT_PAREN) {
 
 		ParserResult paramResult = __Parser_parseParameter(parser);
 		if(!paramResult.success) return paramResult;
 
 		Array_push(parameters, (ParameterASTNode*)paramResult.node);
 
-		peek = Lexer_peekToken(parser->lexer, 1);
-		if(!peek.success) return LexerToParserError(peek);
+		peek = Lexer_peek(parser->lexer, 1);
+		if(!peek) return LexerToParserError(parser->lexer->error);
 
-		if(peek.token->kind == TOKEN_COMMA) {
+		if(peek->kind == TOKEN_COMMA) {
 			result = Lexer_nextToken(parser->lexer);
 			if(!result.success) return LexerToParserError(result);
 
@@ -452,74 +863,6 @@ ParserResult __Parser_parseParameterList(Parser *parser) {
 
 }
 
-ParserResult __Parser_parseFuncStatement(Parser *parser) {
-	// TODO: Symbol table management
-	assertf(parser != NULL);
-
-	FLUSH_ERROR_BUFFER(parser);
-
-	// Check for the keyword
-	LexerResult keyword = Lexer_nextToken(parser->lexer);
-	if(!keyword.success) return LexerToParserError(keyword);
-
-	if(keyword.token->kind != TOKEN_FUNC) {
-		return ParserError(
-			String_fromFormat("expected 'func' in function declaration"),
-			Array_fromArgs(1, keyword.token));
-	}
-
-	// Consume the identifier
-	LexerResult result = Lexer_nextToken(parser->lexer);
-	if(!result.success) return LexerToParserError(result);
-
-	LexerResult peek;
-
-
-	if(result.token->type != TOKEN_IDENTIFIER) {
-		return ParserError(
-			String_fromFormat("expected identifier in function declaration"),
-			Array_fromArgs(1, result.token));
-	}
-
-	// Check for '_' identifier
-	if(String_equals(result.token->value.string, "_")) {
-		return ParserError(
-			String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
-			Array_fromArgs(1, result.token)
-		);
-	}
-
-	IdentifierASTNode *funcId = new_IdentifierASTNode(result.token->value.string);
-
-	ParserResult parameterListResult = __Parser_parseParameterList(parser);
-	if(!parameterListResult.success) return parameterListResult;
-
-
-	peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
-
-	TypeReferenceASTNode *returnType = NULL;
-	if(peek.token->kind == TOKEN_ARROW) {
-		// Skip the '->' token
-		LexerResult tmp = Lexer_nextToken(parser->lexer);
-		if(!tmp.success) return LexerToParserError(result);
-
-		ParserResult returnTypeResult = __Parser_parseTypeReference(parser);
-		if(!returnTypeResult.success) return returnTypeResult;
-		returnType = (TypeReferenceASTNode*)returnTypeResult.node;
-	} else {
-		// Void return type
-		returnType = NULL;
-	}
-
-
-	ParserResult blockResult = __Parser_parseBlock(parser, true);
-	if(!blockResult.success) return blockResult;
-
-	FunctionDeclarationASTNode *func = new_FunctionDeclarationASTNode(funcId, (ParameterListASTNode*)parameterListResult.node, returnType, (BlockASTNode*)blockResult.node);
-	return ParserSuccess(func);
-}
-
 ParserResult __Parser_parsePattern(Parser *parser) {
 	assertf(parser != NULL);
 
@@ -545,10 +888,10 @@ ParserResult __Parser_parsePattern(Parser *parser) {
 	IdentifierASTNode *patternName = new_IdentifierASTNode(result.token->value.string);
 	TypeReferenceASTNode *type = NULL;
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	if(peek.token->kind == TOKEN_COLON) {
+	if(peek->kind == TOKEN_COLON) {
 		// skip ':'
 		LexerResult tmp = Lexer_nextToken(parser->lexer);
 		if(!tmp.success) return LexerToParserError(tmp);
@@ -572,20 +915,20 @@ ParserResult __Parser_parseOptionalBindingCondition(Parser *parser) {
 	LexerResult result = Lexer_nextToken(parser->lexer);
 	if(!result.success) return LexerToParserError(result);
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	if(peek.token->type != TOKEN_IDENTIFIER) {
+	if(peek->type != TOKEN_IDENTIFIER) {
 		return ParserError(
 			String_fromFormat("let must be followed by identifier"),
-			Array_fromArgs(1, peek.token));
+			Array_fromArgs(1, peek));
 	}
 
 	// Check for '_' identifier (has no point, but required by the assignment)
-	if(String_equals(peek.token->value.string, "_")) {
+	if(String_equals(peek->value.string, "_")) {
 		return ParserError(
 			String_fromFormat("'_' can only appear in a pattern or on the left side of an assignment"),
-			Array_fromArgs(1, peek.token)
+			Array_fromArgs(1, peek)
 		);
 	}
 
@@ -606,31 +949,31 @@ ParserResult __Parser_parseTest(Parser *parser) {
 
 	ASTNode *test = NULL;
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	if(peek.token->kind == TOKEN_LEFT_PAREN) {
-		LexerResult peek = Lexer_peekToken(parser->lexer, 2);
-		if(!peek.success) return LexerToParserError(peek);
+	if(peek->kind == TOKEN_LEFT_PAREN) {
+		Token *peek = Lexer_peek(parser->lexer, 2);
+		if(!peek) return LexerToParserError(parser->lexer->error);
 
-		if(peek.token->kind == TOKEN_VAR) {
+		if(peek->kind == TOKEN_VAR) {
 			return ParserError(
 				String_fromFormat("cannot use var in optional binding condition"),
-				Array_fromArgs(1, peek.token));
+				Array_fromArgs(1, peek));
 		}
 
-		if(peek.token->kind == TOKEN_LET) {
+		if(peek->kind == TOKEN_LET) {
 			return ParserError(
 				String_fromFormat("cannot use optional binding in condition with parentheses"),
-				Array_fromArgs(1, peek.token));
+				Array_fromArgs(1, peek));
 		}
 	}
 
-	if(peek.token->kind == TOKEN_VAR) {
+	if(peek->kind == TOKEN_VAR) {
 		return ParserError(
 			String_fromFormat("cannot use var in optional binding condition"),
-			Array_fromArgs(1, peek.token));
-	} else if(peek.token->kind == TOKEN_LET) {
+			Array_fromArgs(1, peek));
+	} else if(peek->kind == TOKEN_LET) {
 		ParserResult bindingConditionResult = __Parser_parseOptionalBindingCondition(parser);
 		if(!bindingConditionResult.success) return bindingConditionResult;
 		test = (ASTNode*)bindingConditionResult.node;
@@ -643,116 +986,6 @@ ParserResult __Parser_parseTest(Parser *parser) {
 	return ParserSuccess(test);
 }
 
-ParserResult __Parser_parseIfStatement(Parser *parser) {
-	assertf(parser != NULL);
-
-	FLUSH_ERROR_BUFFER(parser);
-
-	// Check for the keyword
-	LexerResult keyword = Lexer_nextToken(parser->lexer);
-	if(!keyword.success) return LexerToParserError(keyword);
-
-	if(keyword.token->kind != TOKEN_IF) {
-		return ParserError(
-			String_fromFormat("expected 'if' in if statement"),
-			Array_fromArgs(1, keyword.token));
-	}
-
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
-
-	// look more into this
-	if(peek.token->kind == TOKEN_LEFT_BRACE) {
-		return ParserError(
-			String_fromFormat("missing condition in 'if' statement"),
-			Array_fromArgs(1, peek.token));
-	}
-
-
-	if(peek.token->kind == TOKEN_ELSE || peek.token->type == TOKEN_EOF) {
-		return ParserError(
-			String_fromFormat("expected expression, var, or let in 'if' condition"),
-			Array_fromArgs(1, peek.token));
-	}
-
-	ParserResult testResult = __Parser_parseTest(parser);
-	if(!testResult.success) return testResult;
-
-	ParserResult blockResult = __Parser_parseBlock(parser, true);
-	if(!blockResult.success) return blockResult;
-
-	peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
-
-	ASTNode *alternate = NULL;
-
-	if(peek.token->kind == TOKEN_ELSE) {
-		// skip else keyword
-		LexerResult result = Lexer_nextToken(parser->lexer);
-		if(!result.success) return LexerToParserError(result);
-
-		LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-		if(!peek.success) return LexerToParserError(peek);
-
-		if(peek.token->kind == TOKEN_IF) {
-			ParserResult ifStatementResult = __Parser_parseIfStatement(parser);
-			if(!ifStatementResult.success) return ifStatementResult;
-			alternate = (ASTNode*)ifStatementResult.node;
-
-		} else {
-			ParserResult blockResult = __Parser_parseBlock(parser, true);
-			if(!blockResult.success) return blockResult;
-			alternate = (ASTNode*)blockResult.node;
-		}
-	}
-
-	IfStatementASTNode *ifStatement = new_IfStatementASTNode((ASTNode*)testResult.node,  (BlockASTNode*)blockResult.node, (ASTNode*)alternate);
-
-	return ParserSuccess(ifStatement);
-}
-
-ParserResult __Parser_parseWhileStatement(Parser *parser) {
-	assertf(parser != NULL);
-
-	FLUSH_ERROR_BUFFER(parser);
-
-	// Check for the keyword
-	LexerResult keyword = Lexer_nextToken(parser->lexer);
-	if(!keyword.success) return LexerToParserError(keyword);
-
-	if(keyword.token->kind != TOKEN_WHILE) {
-		return ParserError(
-			String_fromFormat("expected 'while' in while statement"),
-			Array_fromArgs(1, keyword.token));
-	}
-
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
-
-	// look more into this
-	if(peek.token->kind == TOKEN_LEFT_BRACE) {
-		return ParserError(
-			String_fromFormat("missing condition in 'while' statement"),
-			Array_fromArgs(1, peek.token));
-	}
-
-	if(peek.token->type == TOKEN_EOF) {
-		return ParserError(
-			String_fromFormat("expected expression, var, or let in 'while' condition"),
-			Array_fromArgs(1, peek.token));
-	}
-
-	ParserResult testResult = __Parser_parseTest(parser);
-	if(!testResult.success) return testResult;
-
-	ParserResult blockResult = __Parser_parseBlock(parser, true);
-	if(!blockResult.success) return blockResult;
-
-	WhileStatementASTNode *whileStatement = new_WhileStatementASTNode((ASTNode*)testResult.node,  (BlockASTNode*)blockResult.node);
-
-	return ParserSuccess(whileStatement);
-}
-
 ParserResult __Parser_parseRange(Parser *parser) {
 	assertf(parser != NULL);
 
@@ -784,56 +1017,6 @@ ParserResult __Parser_parseRange(Parser *parser) {
 	return ParserSuccess(range);
 }
 
-ParserResult __Parser_parseForStatement(Parser *parser) {
-	assertf(parser != NULL);
-
-	FLUSH_ERROR_BUFFER(parser);
-
-	// Check for the keyword
-	LexerResult keyword = Lexer_nextToken(parser->lexer);
-	if(!keyword.success) return LexerToParserError(keyword);
-
-	if(keyword.token->kind != TOKEN_FOR) {
-		return ParserError(
-			String_fromFormat("expected 'for' in for statement"),
-			Array_fromArgs(1, keyword.token));
-	}
-
-	// Parse iterator identifier
-	LexerResult iteratorResult = Lexer_nextToken(parser->lexer);
-	if(!iteratorResult.success) return LexerToParserError(iteratorResult);
-
-	if(iteratorResult.token->type != TOKEN_IDENTIFIER) {
-		return ParserError(
-			String_fromFormat("expected identifier in for statement"),
-			Array_fromArgs(1, iteratorResult.token));
-	}
-
-	// Check for the 'in' token
-	LexerResult inResult = Lexer_nextToken(parser->lexer);
-	if(!inResult.success) return LexerToParserError(inResult);
-
-	if(inResult.token->kind != TOKEN_IN) {
-		return ParserError(
-			String_fromFormat("expected 'in' in for statement"),
-			Array_fromArgs(1, inResult.token));
-	}
-
-	// Parse range
-	ParserResult rangeResult = __Parser_parseRange(parser);
-	if(!rangeResult.success) return rangeResult;
-
-	// Parse block
-	ParserResult blockResult = __Parser_parseBlock(parser, true);
-	if(!blockResult.success) return blockResult;
-
-	// Create the for statement node
-	IdentifierASTNode *iterator = new_IdentifierASTNode(iteratorResult.token->value.string);
-	ForStatementASTNode *forStatement = new_ForStatementASTNode(iterator, (RangeASTNode*)rangeResult.node, (BlockASTNode*)blockResult.node);
-
-	return ParserSuccess(forStatement);
-}
-
 ParserResult __Parser_parseReturnStatement(Parser *parser) {
 	assertf(parser != NULL);
 
@@ -849,24 +1032,24 @@ ParserResult __Parser_parseReturnStatement(Parser *parser) {
 			Array_fromArgs(1, keyword.token));
 	}
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
 	ExpressionASTNode *expression = NULL;
 
 	if(
-		peek.token->type != TOKEN_EOF &&
-		peek.token->kind != TOKEN_RIGHT_BRACE &&
+		peek->type != TOKEN_EOF &&
+		peek->kind != TOKEN_RIGHT_BRACE &&
 		// An empty return followed by another statement
-		peek.token->kind != TOKEN_FUNC &&
-		peek.token->kind != TOKEN_IF &&
-		peek.token->kind != TOKEN_WHILE &&
-		peek.token->kind != TOKEN_FOR &&
-		peek.token->kind != TOKEN_RETURN &&
-		peek.token->kind != TOKEN_BREAK &&
-		peek.token->kind != TOKEN_CONTINUE &&
-		peek.token->kind != TOKEN_LET &&
-		peek.token->kind != TOKEN_VAR
+		peek->kind != TOKEN_FUNC &&
+		peek->kind != TOKEN_IF &&
+		peek->kind != TOKEN_WHILE &&
+		peek->kind != TOKEN_FOR &&
+		peek->kind != TOKEN_RETURN &&
+		peek->kind != TOKEN_BREAK &&
+		peek->kind != TOKEN_CONTINUE &&
+		peek->kind != TOKEN_LET &&
+		peek->kind != TOKEN_VAR
 	) {
 		ParserResult expressionResult = __Parser_parseExpression(parser);
 		if(!expressionResult.success) return expressionResult;
@@ -926,14 +1109,14 @@ ParserResult __Parser_parseVariableDeclarator(Parser *parser) {
 	ParserResult patternResult = __Parser_parsePattern(parser);
 	if(!patternResult.success) return patternResult;
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
 	PatternASTNode *patternNode = (PatternASTNode*)patternResult.node;
 
 	ExpressionASTNode *initializer = NULL;
 
-	if(peek.token->kind == TOKEN_EQUAL) {
+	if(peek->kind == TOKEN_EQUAL) {
 		// Consume the `=` token
 		LexerResult result = Lexer_nextToken(parser->lexer);
 		if(!result.success) return LexerToParserError(result);
@@ -957,12 +1140,12 @@ ParserResult __Parser_parseVariableDeclarationList(Parser *parser) {
 
 	FLUSH_ERROR_BUFFER(parser);
 
-	LexerResult peek;
+	Token *peek;
 	LexerResult result;
 
 	Array *declarators = Array_alloc(0);
-	peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
 	while(true) {
 		ParserResult declaratorResult = __Parser_parseVariableDeclarator(parser);
@@ -970,11 +1153,11 @@ ParserResult __Parser_parseVariableDeclarationList(Parser *parser) {
 
 		Array_push(declarators, (VariableDeclaratorASTNode*)declaratorResult.node);
 
-		peek = Lexer_peekToken(parser->lexer, 1);
-		if(!peek.success) return LexerToParserError(peek);
+		peek = Lexer_peek(parser->lexer, 1);
+		if(!peek) return LexerToParserError(parser->lexer->error);
 
 		// Consume the `,` token
-		if(peek.token->kind == TOKEN_COMMA) {
+		if(peek->kind == TOKEN_COMMA) {
 			result = Lexer_nextToken(parser->lexer);
 			if(!result.success) return LexerToParserError(result);
 		} else {
@@ -1019,15 +1202,15 @@ ParserResult __Parser_parseArgument(Parser *parser) {
 	IdentifierASTNode *argumentLabel = NULL;
 	ExpressionASTNode *expression = NULL;
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	LexerResult peekColon = Lexer_peekToken(parser->lexer, 2);
-	if(!peekColon.success) return LexerToParserError(peekColon);
+	Token *peekColon = Lexer_peek(parser->lexer, 2);
+	if(!peekColon) return LexerToParserError(parser->lexer->error);
 
 
 	// labeled argument
-	if(peek.token->type == TOKEN_IDENTIFIER && peekColon.token->kind == TOKEN_COLON) {
+	if(peek->type == TOKEN_IDENTIFIER && peekColon->kind == TOKEN_COLON) {
 
 		LexerResult result = Lexer_nextToken(parser->lexer);
 		if(!result.success) return LexerToParserError(result);
@@ -1059,32 +1242,32 @@ ParserResult __Parser_parseArgumentList(Parser *parser) {
 	// Parse argument-list
 	Array *arguments = Array_alloc(0);
 
-	LexerResult peek = Lexer_peekToken(parser->lexer, 1);
-	if(!peek.success) return LexerToParserError(peek);
+	Token *peek = Lexer_peek(parser->lexer, 1);
+	if(!peek) return LexerToParserError(parser->lexer->error);
 
-	while(peek.token->kind != TOKEN_RIGHT_PAREN) {
+	while(peek->kind != TOKEN_RIGHT_PAREN) {
 		ParserResult argumentResult = __Parser_parseArgument(parser);
 		if(!argumentResult.success) return argumentResult;
 
 		Array_push(arguments, (ArgumentASTNode*)argumentResult.node);
 
-		peek = Lexer_peekToken(parser->lexer, 1);
-		if(!peek.success) return LexerToParserError(peek);
+		peek = Lexer_peek(parser->lexer, 1);
+		if(!peek) return LexerToParserError(parser->lexer->error);
 
-		if(peek.token->kind == TOKEN_COMMA) {
+		if(peek->kind == TOKEN_COMMA) {
 			// Skip ','
 			result = Lexer_nextToken(parser->lexer);
 			if(!result.success) return LexerToParserError(result);
 
 			// Peek to the next argument
-			peek = Lexer_peekToken(parser->lexer, 1);
-			if(!peek.success) return LexerToParserError(peek);
+			peek = Lexer_peek(parser->lexer, 1);
+			if(!peek) return LexerToParserError(parser->lexer->error);
 
 			// No argument after ','
-			if(peek.token->kind == TOKEN_RIGHT_PAREN) {
+			if(peek->kind == TOKEN_RIGHT_PAREN) {
 				return ParserError(
 					String_fromFormat("expected expression in argument list"),
-					Array_fromArgs(1, peek.token));
+					Array_fromArgs(1, peek));
 			}
 		}
 	}
@@ -1179,10 +1362,10 @@ ParserResult __Parser_parseStringInterpolation(Parser *parser) {
 	// Consume the first string
 	Array_push(strings, result.token->value.string);
 
-	LexerResult marker = Lexer_peekToken(parser->lexer, 1);
-	if(!marker.success) return LexerToParserError(marker);
+	Token *marker = Lexer_peek(parser->lexer, 1);
+	if(!marker) return LexerToParserError(parser->lexer->error);
 
-	while(marker.token->type == TOKEN_STRING_INTERPOLATION_MARKER && marker.token->kind != TOKEN_STRING_TAIL) {
+	while(marker->type == TOKEN_STRING_INTERPOLATION_MARKER && marker->kind != TOKEN_STRING_TAIL) {
 		// Consume the interpolation marker
 		LexerResult tmp = Lexer_nextToken(parser->lexer);
 		if(!tmp.success) return LexerToParserError(tmp);
@@ -1208,8 +1391,8 @@ ParserResult __Parser_parseStringInterpolation(Parser *parser) {
 		Array_push(strings, stringResult.token->value.string);
 
 		// Peek the next token
-		marker = Lexer_peekToken(parser->lexer, 1);
-		if(!marker.success) return LexerToParserError(marker);
+		marker = Lexer_peek(parser->lexer, 1);
+		if(!marker) return LexerToParserError(parser->lexer->error);
 	}
 
 	InterpolationExpressionASTNode *stringInterpolation = new_InterpolationExpressionASTNode(strings, expressions);
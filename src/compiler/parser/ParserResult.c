@@ -6,6 +6,7 @@
  */
 
 #include "compiler/parser/ParserResult.h"
+#include "allocator/MemoryAllocator.h"
 
 void ParserResult_constructor(
 	ParserResult *result,
@@ -36,4 +37,25 @@ ParserResult ParserResult_construct(
 	return result;
 }
 
+ParserResult* ParserResult_alloc(
+	enum ResultType type,
+	enum Severity severity,
+	String *message,
+	Array *markers,
+	ASTNode *node
+) {
+	ParserResult *result = mem_alloc(sizeof(ParserResult));
+	if(!result) return NULL;
+
+	ParserResult_constructor(result, type, severity, message, markers, node);
+	return result;
+}
+
+void ParserResult_free(ParserResult *result) {
+	if(!result) return;
+
+	ParserResult_destructor(result);
+	mem_free(result);
+}
+
 /** End of file src/compiler/parser/ParserResult.c **/
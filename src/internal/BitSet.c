@@ -0,0 +1,149 @@
+/**
+ * @file src/internal/BitSet.c
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Implementation of BitSet data structure.
+ * @copyright Copyright (c) 2023
+ */
+
+#include "internal/BitSet.h"
+
+#include <string.h>
+
+#include "allocator/MemoryAllocator.h"
+
+void __BitSet_grow(BitSet *set, size_t words);
+
+void BitSet_constructor(BitSet *set) {
+	if(!set) return;
+
+	set->words = NULL;
+	set->capacity = 0;
+}
+
+void BitSet_destructor(BitSet *set) {
+	if(!set) return;
+
+	if(set->words) mem_free(set->words);
+
+	set->words = NULL;
+	set->capacity = 0;
+}
+
+void BitSet_set(BitSet *set, size_t index, bool value) {
+	if(!set) return;
+
+	size_t word = index / BITSET_WORD_BITS;
+	uint64_t mask = (uint64_t)1 << (index % BITSET_WORD_BITS);
+
+	// Clearing a bit past the end does not need to grow the set
+	if(word >= set->capacity) {
+		if(!value) return;
+
+		__BitSet_grow(set, word + 1);
+	}
+
+	if(value) set->words[word] |= mask;
+	else set->words[word] &= ~mask;
+}
+
+bool BitSet_has(BitSet *set, size_t index) {
+	if(!set) return false;
+
+	size_t word = index / BITSET_WORD_BITS;
+	if(word >= set->capacity) return false;
+
+	return (set->words[word] >> (index % BITSET_WORD_BITS)) & 1;
+}
+
+size_t BitSet_next(BitSet *set, size_t index) {
+	if(!set) return SIZE_MAX;
+
+	size_t word = index / BITSET_WORD_BITS;
+	if(word >= set->capacity) return SIZE_MAX;
+
+	// The bits below the index are masked out, the empty words are skipped as a whole
+	uint64_t bits = set->words[word] & (~(uint64_t)0 << (index % BITSET_WORD_BITS));
+
+	while(!bits) {
+		if(++word >= set->capacity) return SIZE_MAX;
+		bits = set->words[word];
+	}
+
+	size_t offset = 0;
+	while(!(bits & 1)) {
+		bits >>= 1;
+		offset++;
+	}
+
+	return word * BITSET_WORD_BITS + offset;
+}
+
+void BitSet_clear(BitSet *set) {
+	if(!set) return;
+	if(!set->words) return;
+
+	memset(set->words, 0, set->capacity * sizeof(uint64_t));
+}
+
+bool BitSet_union(BitSet *set, BitSet *other) {
+	if(!set || !other) return false;
+
+	// Only the words with any bit set need to fit in the set
+	size_t size = other->capacity;
+	while(size > 0 && !other->words[size - 1]) size--;
+	if(size > set->capacity) __BitSet_grow(set, size);
+
+	bool isChanged = false;
+
+	for(size_t i = 0; i < size; i++) {
+		uint64_t word = set->words[i] | other->words[i];
+		if(word != set->words[i]) isChanged = true;
+
+		set->words[i] = word;
+	}
+
+	return isChanged;
+}
+
+void BitSet_subtract(BitSet *set, BitSet *other) {
+	if(!set || !other) return;
+
+	size_t size = set->capacity < other->capacity ? set->capacity : other->capacity;
+
+	for(size_t i = 0; i < size; i++) {
+		set->words[i] &= ~other->words[i];
+	}
+}
+
+void BitSet_copy(BitSet *set, BitSet *other) {
+	if(!set || !other) return;
+
+	BitSet_clear(set);
+	BitSet_union(set, other);
+}
+
+void __BitSet_grow(BitSet *set, size_t words) {
+	size_t capacity = set->capacity ? set->capacity : 1;
+	while(capacity < words) capacity <<= 1;
+
+	set->words = mem_recalloc(set->words, set->capacity, capacity, sizeof(uint64_t));
+	set->capacity = capacity;
+}
+
+BitSet* BitSet_alloc() {
+	BitSet *set = mem_alloc(sizeof(BitSet));
+	if(!set) return NULL;
+
+	BitSet_constructor(set);
+
+	return set;
+}
+
+void BitSet_free(BitSet *set) {
+	if(!set) return;
+
+	BitSet_destructor(set);
+	mem_free(set);
+}
+
+/** End of file src/internal/BitSet.c **/
@@ -0,0 +1,89 @@
+/**
+ * @file src/internal/CallStack.c
+ * @author Jaroslav Louma <xlouma00@stud.fit.vutbr.cz>
+ * @brief Segmented call stack for the recursive AST walkers.
+ * @copyright Copyright (c) 2023
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "internal/CallStack.h"
+
+#include <stdint.h>
+#include <ucontext.h>
+#include <sys/resource.h>
+
+#include "assertf.h"
+#include "allocator/MemoryAllocator.h"
+
+
+/* Register private functions */
+
+void __CallStack_run(unsigned int high, unsigned int low);
+size_t __CallStack_getNativeSize();
+
+// Lowest address the current segment can grow to before starting a new one
+static uintptr_t limit = 0;
+
+
+/* Definitions of public functions */
+
+bool CallStack_isExhausted() {
+	char marker;
+	uintptr_t address = (uintptr_t)&marker;
+
+	// The first check happens near the top of the native stack
+	if(!limit) {
+		size_t size = __CallStack_getNativeSize();
+		limit = size < address ? address - size + CALL_STACK_RED_ZONE : address;
+	}
+
+	return address < limit;
+}
+
+void CallStack_extend(void (*function)(void *context), void *context) {
+	assertf(function != NULL);
+
+	CallStackCall call = {.function = function, .context = context};
+	uint64_t address = (uintptr_t)&call;
+
+	char *segment = mem_alloc(CALL_STACK_SEGMENT_SIZE);
+
+	ucontext_t caller;
+	ucontext_t callee;
+
+	if(getcontext(&callee) != 0) fassertf("Failed to initialize a call stack segment.");
+	callee.uc_stack.ss_sp = segment;
+	callee.uc_stack.ss_size = CALL_STACK_SEGMENT_SIZE;
+	callee.uc_link = &caller;
+	makecontext(&callee, (void (*)())__CallStack_run, 2, (unsigned int)(address >> 32), (unsigned int)address);
+
+	uintptr_t previousLimit = limit;
+	limit = (uintptr_t)segment + CALL_STACK_RED_ZONE;
+
+	if(swapcontext(&caller, &callee) != 0) fassertf("Failed to switch to a call stack segment.");
+
+	limit = previousLimit;
+	mem_free(segment);
+}
+
+
+/* Definitions of private functions */
+
+void __CallStack_run(unsigned int high, unsigned int low) {
+	// Pointers do not have to fit into an int argument of `makecontext`
+	CallStackCall *call = (CallStackCall*)(uintptr_t)(((uint64_t)high << 32) | low);
+	call->function(call->context);
+}
+
+size_t __CallStack_getNativeSize() {
+	struct rlimit rlim;
+
+	// Without a known soft limit, assume the conservative default
+	if(getrlimit(RLIMIT_STACK, &rlim) != 0) return CALL_STACK_NATIVE_SIZE;
+	if(rlim.rlim_cur == RLIM_INFINITY) return CALL_STACK_NATIVE_SIZE;
+
+	return (size_t)rlim.rlim_cur;
+}
+
+/** End of file src/internal/CallStack.c **/
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include "colors.h"
 
 
@@ -15,15 +16,34 @@
 #include "compiler/lexer/Lexer.h"
 #include "compiler/parser/Parser.h"
 #include "compiler/analyser/Analyser.h"
+#include "compiler/optimizer/Optimizer.h"
 #include "compiler/codegen/Codegen.h"
+#include "compiler/codegen/Peephole.h"
 
 #include "colors.h"
 
 #define BUFFER_SIZE 1024
 
+/**
+ * Options (the source is always read from the standard input):
+ *   --stack  Evaluate the expressions on the data stack instead of the frame temporaries (for comparison of the lowerings)
+ *   --stats  Print the statistics of the peephole optimization to the standard error output
+ */
 int main(int argc, const char *argv[]) {
-	(void)argc;
-	(void)argv;
+	bool useStack = false;
+	bool printStats = false;
+
+	// Parse the command line options
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--stack") == 0) {
+			useStack = true;
+		} else if(strcmp(argv[i], "--stats") == 0) {
+			printStats = true;
+		} else {
+			fprintf(stderr, RED BOLD "error: " RST WHITE "unknown option '%s'\n" RST, argv[i]);
+			return RESULT_ERROR_INTERNAL;
+		}
+	}
 
 	// Prepare the source string and input buffer
 	String *source = String_alloc("");
@@ -47,15 +67,29 @@ int main(int argc, const char *argv[]) {
 	Analyser analyser;
 	Analyser_constructor(&analyser);
 
+	// Prepare the optimizer
+	Optimizer optimizer;
+	Optimizer_constructor(&optimizer, &analyser);
+
 	// Prepare the code generator
 	Codegen codegen;
 	Codegen_constructor(&codegen, &analyser);
 
+	// Expressions are lowered to the three-address code unless requested otherwise
+	if(useStack) codegen.lowering = LOWERING_STACK;
+
+	// Prepare the peephole optimizer
+	Peephole peephole;
+	Peephole_constructor(&peephole);
+
 	// Parse the source
 	ParserResult result = Parser_parse(&parser);
 	if(!result.success) {
 		// TODO: Add error utils here
-		fprintf(stderr, RED BOLD "error: " RST WHITE "%s\n" RST, result.message->value);
+		for(size_t i = 0; i < parser.diagnostics->size; i++) {
+			ParserResult *error = Array_get(parser.diagnostics, i);
+			fprintf(stderr, RED BOLD "error: " RST WHITE "%s\n" RST, error->message->value);
+		}
 
 		Allocator_cleanup();
 		return result.type;
@@ -71,9 +105,18 @@ int main(int argc, const char *argv[]) {
 		return analyserResult.type;
 	}
 
+	// Optimize the analysed AST
+	Optimizer_optimize(&optimizer);
+
 	// Generate the assembly
 	Codegen_generate(&codegen);
 
+	// Optimize the generated instructions
+	Peephole_optimize(&peephole, &codegen.instructions);
+	if(printStats) Peephole_printStats(&peephole, stderr);
+
+	Codegen_emit(&codegen, stdout);
+
 	Allocator_cleanup();
 	return 0;
 }
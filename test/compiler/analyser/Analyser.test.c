@@ -3232,7 +3232,8 @@ DESCRIBE(declaration_registry, "Declaration registry") {
 		FunctionDeclaration *func1 = Array_get(HashMap_get(analyser.overloads, "foo"), 0);
 		EXPECT_NOT_NULL(func1);
 		EXPECT_TRUE(String_equals(func1->node->id->name, "foo"));
-		EXPECT_EQUAL_PTR(HashMap_get(analyser.functions, String_fromLong(func1->id)->value), func1);
+		EXPECT_EQUAL_PTR(Analyser_getFunctionById(&analyser, func1->id), func1);
+		EXPECT_TRUE(Analyser_isDeclarationGlobal(&analyser, func1->id));
 		EXPECT_EQUAL_INT(func1->variables->size, 2);
 
 
@@ -3270,7 +3271,8 @@ DESCRIBE(declaration_registry, "Declaration registry") {
 		FunctionDeclaration *func2 = Array_get(HashMap_get(analyser.overloads, "foo"), 0);
 		EXPECT_NOT_NULL(func2);
 		EXPECT_TRUE(String_equals(func2->node->id->name, "foo"));
-		EXPECT_EQUAL_PTR(HashMap_get(analyser.functions, String_fromLong(func2->id)->value), func2);
+		EXPECT_EQUAL_PTR(Analyser_getFunctionById(&analyser, func2->id), func2);
+		EXPECT_TRUE(Analyser_isDeclarationGlobal(&analyser, func2->id));
 		EXPECT_EQUAL_INT(func2->variables->size, 3);
 
 
@@ -3324,13 +3326,15 @@ DESCRIBE(declaration_registry, "Declaration registry") {
 		FunctionDeclaration *func3 = Array_get(HashMap_get(analyser.overloads, "foo"), 0);
 		EXPECT_NOT_NULL(func3);
 		EXPECT_TRUE(String_equals(func3->node->id->name, "foo"));
-		EXPECT_EQUAL_PTR(HashMap_get(analyser.functions, String_fromLong(func3->id)->value), func3);
+		EXPECT_EQUAL_PTR(Analyser_getFunctionById(&analyser, func3->id), func3);
+		EXPECT_TRUE(Analyser_isDeclarationGlobal(&analyser, func3->id));
 		EXPECT_EQUAL_INT(func3->variables->size, 3);
 
 		FunctionDeclaration *func4 = Array_get(HashMap_get(analyser.overloads, "bar"), 0);
 		EXPECT_NOT_NULL(func4);
 		EXPECT_TRUE(String_equals(func4->node->id->name, "bar"));
-		EXPECT_EQUAL_PTR(HashMap_get(analyser.functions, String_fromLong(func4->id)->value), func4);
+		EXPECT_EQUAL_PTR(Analyser_getFunctionById(&analyser, func4->id), func4);
+		EXPECT_TRUE(Analyser_isDeclarationGlobal(&analyser, func4->id));
 		EXPECT_EQUAL_INT(func4->variables->size, 6);
 	} TEST_END();
 
@@ -5751,3 +5755,495 @@ DESCRIBE(bin_gt_null, "GT/LT analysis with nullable arguments") {
 		EXPECT_FALSE(analyserResult.success);
 	} TEST_END();
 }
+
+DESCRIBE(deep_nesting_analysis, "Analysis of deeply nested code") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	const int depth = 100000;
+
+	TEST_BEGIN("Blocks nested 10^5 levels deep") {
+		String *source = String_alloc("");
+		for(int i = 0; i < depth; i++) String_append(source, i % 2 ? "while false {" LF : "if true {" LF);
+		String_append(source, "var a = 1" LF);
+		String_append(source, "a = 2" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+
+	TEST_BEGIN("Shadowed variables in blocks nested 10^5 levels deep") {
+		String *source = String_alloc("let a = \"global\"" LF "var b = 1" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "if true {" LF "let a = b" LF "b = a + 1" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "}" LF);
+		String_append(source, "let c = a + \"!\"" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		// The shadowing bindings are gone once their blocks are left
+		VariableDeclaration *variable = Analyser_getVariableByName(&analyser, "a", analyser.globalScope);
+		EXPECT_NOT_NULL(variable);
+		EXPECT_TRUE(variable->type.type == TYPE_STRING);
+		EXPECT_TRUE(variable->scope == analyser.globalScope);
+	} TEST_END();
+
+	TEST_BEGIN("Else-if chain of 10^5 branches") {
+		String *source = String_alloc("let a = 1" LF "if a == 0 {}");
+		for(int i = 0; i < depth; i++) String_append(source, " else if a == 1 {}");
+		String_append(source, " else {}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+
+	TEST_BEGIN("Return reachability in branches nested 10^5 levels deep") {
+		String *source = String_alloc("func f() -> Int {" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "if true {" LF);
+		String_append(source, "return 1" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "}" LF);
+		String_append(source, "return 0" LF "}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+
+	TEST_BEGIN("Return reachability in else-if chain of 10^5 branches") {
+		String *source = String_alloc("func f(_ a: Int) -> Int {" LF "if a == 0 {" LF "return 0" LF "}");
+		for(int i = 0; i < depth; i++) String_append(source, " else if a == 1 {" LF "return 1" LF "}");
+		String_append(source, " else {" LF "return 2" LF "}" LF "}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		// Without the last branch, the return is not reachable
+		String_replaceAll(source, " else {" LF "return 2" LF "}", "");
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_FALSE(analyserResult.success);
+		EXPECT_TRUE(analyserResult.type == RESULT_ERROR_SEMANTIC_INVALID_RETURN);
+	} TEST_END();
+
+	TEST_BEGIN("Binary expression nested 10^5 levels deep") {
+		String *source = String_alloc("let a: Double = ");
+		for(int i = 0; i < depth; i++) String_append(source, "(1 + ");
+		String_append(source, "1");
+		for(int i = 0; i < depth; i++) String_append(source, ")");
+		String_append(source, LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+
+	TEST_BEGIN("Function calls nested 10^5 levels deep") {
+		String *source = String_alloc("func f(_ x: Int) -> Int {" LF "return x" LF "}" LF "let a = ");
+		for(int i = 0; i < depth; i++) String_append(source, "f(");
+		String_append(source, "1");
+		for(int i = 0; i < depth; i++) String_append(source, ")");
+		String_append(source, LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+}
+
+DESCRIBE(overloaded_call_chains, "Resolution of nested overloaded calls") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	TEST_BEGIN("Overloaded calls nested 500 levels deep") {
+		const int depth = 500;
+
+		String *source = String_alloc(
+			"func f(_ x: Int) -> Int {return x}" LF
+			"func f(_ x: Double) -> Double {return x}" LF
+			"func f(_ x: String) -> String {return x}" LF
+			"let a: Double = "
+		);
+		for(int i = 0; i < depth; i++) String_append(source, "f(");
+		String_append(source, "1");
+		for(int i = 0; i < depth; i++) String_append(source, ")");
+		String_append(source, LF);
+
+		Lexer_setSource(&lexer, source->value);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		VariableDeclaration *variable = Analyser_getVariableByName(&analyser, "a", analyser.globalScope);
+		EXPECT_NOT_NULL(variable);
+
+		// Every call of the chain is resolved to the 'Double' overload, including the literal
+		ExpressionASTNode *expression = variable->node->initializer;
+		for(int i = 0; i < depth; i++) {
+			FunctionCallASTNode *call = (FunctionCallASTNode*)expression;
+			EXPECT_TRUE(call->_type == NODE_FUNCTION_CALL);
+
+			FunctionDeclaration *function = Analyser_getFunctionById(&analyser, call->id->id);
+			EXPECT_NOT_NULL(function);
+			EXPECT_TRUE(function->returnType.type == TYPE_DOUBLE);
+
+			expression = ((ArgumentASTNode*)Array_get(call->argumentList->arguments, 0))->expression;
+		}
+
+		LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)expression;
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_TRUE(literal->type.type == TYPE_DOUBLE);
+	} TEST_END();
+
+	TEST_BEGIN("Overloads filtered by argument labels") {
+		Lexer_setSource(
+			&lexer,
+			"func g(a x: Int) -> Int {return x}" LF
+			"func g(b x: Int) -> Double {return 1.5}" LF
+			"func g(_ x: Int) -> String {return \"\"}" LF
+			"let v1 = g(b: 1)" LF
+			"let v2 = g(1)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		VariableDeclaration *variable1 = Analyser_getVariableByName(&analyser, "v1", analyser.globalScope);
+		EXPECT_NOT_NULL(variable1);
+		EXPECT_TRUE(variable1->type.type == TYPE_DOUBLE);
+
+		VariableDeclaration *variable2 = Analyser_getVariableByName(&analyser, "v2", analyser.globalScope);
+		EXPECT_NOT_NULL(variable2);
+		EXPECT_TRUE(variable2->type.type == TYPE_STRING);
+
+		Lexer_setSource(
+			&lexer,
+			"func g(a x: Int) -> Int {return x}" LF
+			"func g(b x: Int) -> Double {return 1.5}" LF
+			"let v = g(c: 1)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_FALSE(analyserResult.success);
+	} TEST_END();
+}
+
+DESCRIBE(incremental_analysis, "Re-analysis of replaced function declarations") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	// Names in the AST are owned by the lexer, so the replacements are parsed separately
+	Lexer replacementLexer;
+	Lexer_constructor(&replacementLexer);
+
+	Parser replacementParser;
+	Parser_constructor(&replacementParser, &replacementLexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	Array *functions = Array_alloc(1);
+
+	TEST_BEGIN("Replaced function body is analysed alone") {
+		Lexer_setSource(
+			&lexer,
+			"func f(_ a: Int) -> Int {" LF
+			"	return a" LF
+			"}" LF
+			"func g() -> Int {" LF
+			"	if true {}" LF
+			"	return f(1)" LF
+			"}" LF
+			"let x = g()" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Array *statements = analyser.ast->block->statements;
+		FunctionDeclarationASTNode *g = Array_get(statements, -2);
+		size_t ifId = ((IfStatementASTNode*)Array_get(g->body->statements, 0))->id;
+
+		Lexer_setSource(&replacementLexer, "func f(_ a: Int) -> Int {" LF "	var b = a" LF "	b = b + 1" LF "	return b" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		FunctionDeclarationASTNode *node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -3, node);
+		Array_clear(functions);
+		Array_push(functions, node);
+
+		EXPECT_TRUE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_TRUE(analyserResult.success);
+
+		// The new body is registered with its local variables
+		FunctionDeclaration *declaration = Analyser_getFunctionById(&analyser, node->id->id);
+		EXPECT_NOT_NULL(declaration);
+		EXPECT_TRUE(declaration->node == node);
+		EXPECT_EQUAL_INT(declaration->variables->size, 1);
+
+		// Signature did not change, so the caller is not analysed again
+		EXPECT_TRUE(((IfStatementASTNode*)Array_get(g->body->statements, 0))->id == ifId);
+	} TEST_END();
+
+	TEST_BEGIN("Callers of a changed signature are analysed again") {
+		Lexer_setSource(
+			&lexer,
+			"func f(_ a: Int) -> Int {" LF
+			"	return a" LF
+			"}" LF
+			"func g() {" LF
+			"	let y = f(1)" LF
+			"}" LF
+			"func h() {" LF
+			"	if true {}" LF
+			"}" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Array *statements = analyser.ast->block->statements;
+		FunctionDeclarationASTNode *h = Array_get(statements, -1);
+		size_t ifId = ((IfStatementASTNode*)Array_get(h->body->statements, 0))->id;
+
+		Lexer_setSource(&replacementLexer, "func f(_ a: Double) -> Double {" LF "	return a" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		FunctionDeclarationASTNode *node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -3, node);
+		Array_clear(functions);
+		Array_push(functions, node);
+
+		EXPECT_TRUE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_TRUE(analyserResult.success);
+
+		// The local variable of the caller is typed by the new signature
+		FunctionDeclaration *g = Analyser_getFunctionById(&analyser, ((FunctionDeclarationASTNode*)Array_get(statements, -2))->id->id);
+		EXPECT_EQUAL_INT(g->variables->size, 1);
+		EXPECT_TRUE(((VariableDeclaration*)Array_get(g->variables, 0))->type.type == TYPE_DOUBLE);
+
+		// Unrelated function is not analysed again
+		EXPECT_TRUE(((IfStatementASTNode*)Array_get(h->body->statements, 0))->id == ifId);
+	} TEST_END();
+
+	TEST_BEGIN("Errors of the replaced body are reported") {
+		Lexer_setSource(
+			&lexer,
+			"func f() -> Int {" LF
+			"	return 1" LF
+			"}" LF
+			"let a = 1" LF
+			"func g() -> Int {" LF
+			"	return a" LF
+			"}" LF
+			"let b = 2" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Array *statements = analyser.ast->block->statements;
+
+		// Global variables declared after the function are not visible in its body
+		Lexer_setSource(&replacementLexer, "func g() -> Int {" LF "	return a + b" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		FunctionDeclarationASTNode *node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -2, node);
+		Array_clear(functions);
+		Array_push(functions, node);
+
+		EXPECT_TRUE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_FALSE(analyserResult.success);
+		EXPECT_TRUE(analyserResult.type == RESULT_ERROR_SEMANTIC_UNDEFINED_VARIABLE);
+
+		// Fixing the body makes the program valid again, names of the previous replacement are still referenced
+		Lexer_constructor(&replacementLexer);
+		Lexer_setSource(&replacementLexer, "func g() -> Int {" LF "	return a + 1" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -2, node);
+		Array_clear(functions);
+		Array_push(functions, node);
+
+		EXPECT_TRUE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_TRUE(analyserResult.success);
+		EXPECT_NOT_NULL(Analyser_getVariableByName(&analyser, "b", analyser.globalScope));
+	} TEST_END();
+
+	TEST_BEGIN("Changes affecting the global code require a full analysis") {
+		Lexer_setSource(
+			&lexer,
+			"func f(_ a: Int) -> Int {" LF
+			"	return a" LF
+			"}" LF
+			"let x = f(1)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Array *statements = analyser.ast->block->statements;
+		FunctionDeclarationASTNode *previous = Array_get(statements, -2);
+
+		// Signature of a function called from the global code
+		Lexer_setSource(&replacementLexer, "func f(_ a: Double) -> Int {" LF "	return 1" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		FunctionDeclarationASTNode *node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -2, node);
+		Array_clear(functions);
+		Array_push(functions, node);
+
+		EXPECT_FALSE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, previous->id->id)->node == previous);
+
+		// Renamed function
+		Lexer_setSource(&replacementLexer, "func e(_ a: Int) -> Int {" LF "	return a" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -2, node);
+		Array_set(functions, 0, node);
+
+		EXPECT_FALSE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+
+		// Body only change is fine
+		Lexer_setSource(&replacementLexer, "func f(_ a: Int) -> Int {" LF "	return a * 2" LF "}" LF);
+		parserResult = Parser_parse(&replacementParser);
+		EXPECT_TRUE(parserResult.success);
+
+		node = Array_get(((ProgramASTNode*)parserResult.node)->block->statements, 0);
+		Array_set(statements, -2, node);
+		Array_set(functions, 0, node);
+
+		EXPECT_TRUE(Analyser_reanalyse(&analyser, functions, &analyserResult));
+		EXPECT_TRUE(analyserResult.success);
+	} TEST_END();
+}
+
+DESCRIBE(tail_call_detection, "Detection of self-recursive tail calls") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	TEST_BEGIN("Only the returned calls of the function itself are tail calls") {
+		Lexer_setSource(
+			&lexer,
+			"func fact(_ n: Int, _ acc: Int) -> Int {" LF
+			"	if n < 2 { return acc }" LF
+			"	return fact(n - 1, acc * n)" LF
+			"}" LF
+			"func slow(_ n: Int) -> Int {" LF
+			"	if n < 2 { return 1 }" LF
+			"	return n * slow(n - 1)" LF
+			"}" LF
+			"func f(_ x: Int) -> Int { return x }" LF
+			"func f(_ x: Double) -> Int { return f(1) }" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Array *statements = analyser.ast->block->statements;
+		FunctionDeclarationASTNode *fact = Array_get(statements, -4);
+		FunctionDeclarationASTNode *slow = Array_get(statements, -3);
+		FunctionDeclarationASTNode *f = Array_get(statements, -1);
+
+		IfStatementASTNode *ifStatement = Array_get(fact->body->statements, 0);
+		EXPECT_FALSE(((ReturnStatementASTNode*)Array_get(ifStatement->body->statements, 0))->isTailCall);
+		EXPECT_TRUE(((ReturnStatementASTNode*)Array_get(fact->body->statements, 1))->isTailCall);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, fact->id->id)->isTailRecursive);
+
+		// Result of the recursive call is used by the caller
+		EXPECT_FALSE(((ReturnStatementASTNode*)Array_get(slow->body->statements, 1))->isTailCall);
+		EXPECT_FALSE(Analyser_getFunctionById(&analyser, slow->id->id)->isTailRecursive);
+
+		// Call resolves to the other overload
+		EXPECT_FALSE(((ReturnStatementASTNode*)Array_get(f->body->statements, 0))->isTailCall);
+		EXPECT_FALSE(Analyser_getFunctionById(&analyser, f->id->id)->isTailRecursive);
+	} TEST_END();
+}
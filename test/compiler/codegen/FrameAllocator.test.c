@@ -0,0 +1,120 @@
+#include "compiler/codegen/Instruction.h"
+#include "compiler/codegen/FrameAllocator.h"
+#include "internal/Array.h"
+#include "unit.h"
+#include <stdio.h>
+
+#define TEST_PRIORITY 100
+
+DESCRIBE(frame_allocator, "Frame variable allocation") {
+	InstructionList list;
+	FrameAllocator allocator;
+	Instruction *instruction = NULL;
+
+	TEST("Variables with disjoint lifetimes share a slot", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		FrameAllocator_constructor(&allocator);
+
+		Instruction_defvar_id(1, FRAME_LOCAL);
+		Instruction_defvar_id(2, FRAME_LOCAL);
+		Instruction_defvar_id(3, FRAME_LOCAL);
+
+		// a = 1; write(a); b = 2; write(b)
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(FRAME_LOCAL, 1), Operand_int(1));
+		Instruction_emit(OPCODE_WRITE, 1, Operand_variable_id(FRAME_LOCAL, 1));
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(FRAME_LOCAL, 2), Operand_int(2));
+		Instruction_emit(OPCODE_WRITE, 1, Operand_variable_id(FRAME_LOCAL, 2));
+		Instruction_return();
+
+		FrameAllocator_allocate(&allocator, &list);
+
+		EXPECT_EQUAL_INT(allocator.variables, 3);
+		EXPECT_EQUAL_INT(allocator.slots, 1);
+		EXPECT_EQUAL_INT(list.instructions->size, 6);
+
+		instruction = Array_get(list.instructions, 3);
+		EXPECT_TRUE(instruction->opcode == OPCODE_MOVE);
+		EXPECT_EQUAL_INT(instruction->operands[0].id, 1);
+
+		instruction = Array_get(list.instructions, 4);
+		EXPECT_TRUE(instruction->opcode == OPCODE_WRITE);
+		EXPECT_EQUAL_INT(instruction->operands[0].id, 1);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Variables live around a loop keep their slots", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		FrameAllocator_constructor(&allocator);
+
+		Instruction_defvar_id(1, FRAME_LOCAL);
+		Instruction_defvar_id(2, FRAME_LOCAL);
+
+		// a = 0; while(...) { b = a; a = b + 1 }
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(FRAME_LOCAL, 1), Operand_int(0));
+		Instruction_label_id("loop_start", 1);
+		Instruction_emit(OPCODE_JUMPIFEQ, 3, Operand_label_id("loop_end", 1), Operand_variable_id(FRAME_LOCAL, 1), Operand_int(10));
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable_id(FRAME_LOCAL, 2), Operand_variable_id(FRAME_LOCAL, 1));
+		Instruction_emit(OPCODE_ADD, 3, Operand_variable_id(FRAME_LOCAL, 1), Operand_variable_id(FRAME_LOCAL, 2), Operand_int(1));
+		Instruction_jump_id("loop_start", 1);
+		Instruction_label_id("loop_end", 1);
+		Instruction_return();
+
+		FrameAllocator_allocate(&allocator, &list);
+
+		EXPECT_EQUAL_INT(allocator.slots, 2);
+
+		instruction = Array_get(list.instructions, 6);
+		EXPECT_TRUE(instruction->opcode == OPCODE_ADD);
+		EXPECT_EQUAL_INT(instruction->operands[0].id, 1);
+		EXPECT_EQUAL_INT(instruction->operands[1].id, 2);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Names are not confused with the ids appended to them", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		FrameAllocator_constructor(&allocator);
+
+		Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_named_id(FRAME_LOCAL, "x_1", 2));
+		Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable(FRAME_LOCAL, "x_1_2"));
+
+		// Both are live at once, each needs its own slot
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable_named_id(FRAME_LOCAL, "x_1", 2), Operand_int(1));
+		Instruction_emit(OPCODE_MOVE, 2, Operand_variable(FRAME_LOCAL, "x_1_2"), Operand_int(2));
+		Instruction_emit(OPCODE_WRITE, 1, Operand_variable_named_id(FRAME_LOCAL, "x_1", 2));
+		Instruction_emit(OPCODE_WRITE, 1, Operand_variable(FRAME_LOCAL, "x_1_2"));
+		Instruction_return();
+
+		FrameAllocator_allocate(&allocator, &list);
+
+		EXPECT_EQUAL_INT(allocator.variables, 2);
+		EXPECT_EQUAL_INT(allocator.slots, 2);
+
+		instruction = Array_get(list.instructions, 5);
+		EXPECT_TRUE(instruction->opcode == OPCODE_WRITE);
+		EXPECT_FALSE(instruction->operands[0].hasId);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Jumps out of the list keep it intact", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		FrameAllocator_constructor(&allocator);
+
+		Instruction_defvar_id(1, FRAME_LOCAL);
+		Instruction_defvar_id(2, FRAME_LOCAL);
+		Instruction_jump("elsewhere");
+
+		FrameAllocator_allocate(&allocator, &list);
+
+		EXPECT_EQUAL_INT(allocator.slots, 2);
+		EXPECT_EQUAL_INT(list.instructions->size, 3);
+
+		InstructionList_destructor(&list);
+	})
+}
@@ -0,0 +1,107 @@
+#include "compiler/codegen/Instruction.h"
+#include "internal/String.h"
+#include "internal/Array.h"
+#include "unit.h"
+#include <stdio.h>
+
+#define TEST_PRIORITY 100
+
+String* serializeInstructions(InstructionList *list) {
+	FILE *stream = tmpfile();
+	InstructionList_serialize(list, stream);
+	rewind(stream);
+
+	String *output = String_alloc("");
+	int c;
+	while((c = fgetc(stream)) != EOF) String_appendChar(output, c);
+
+	fclose(stream);
+	return output;
+}
+
+DESCRIBE(instruction_list, "Instruction list") {
+	InstructionList list;
+
+	TEST("Serializes the operands", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+
+		String *string = String_alloc("a b#\\");
+		Instruction_defvar_id(4, FRAME_LOCAL);
+		Instruction_move_string_id(FRAME_LOCAL, 4, string);
+		Instruction_pushs_func_result(2);
+		Instruction_readInt("READ_TMP", FRAME_GLOBAL);
+		COMMENT_WHILE(3lu)
+		Instruction_jump_ifneqs_id("loop_end", 3);
+
+		EXPECT_EQUAL_INT(list.instructions->size, 6);
+		EXPECT_EQUAL_STRING(string->value, "a b#\\");
+		EXPECT_EQUAL_STRING(serializeInstructions(&list)->value,
+			"DEFVAR LF@$4\n"
+			"MOVE LF@$4 string@a\\032b\\035\\092\n"
+			"PUSHS TF@$ret_2\n"
+			"READ GF@$READ_TMP int\n"
+			"# While loop 3\n"
+			"JUMPIFNEQS $loop_end_3\n"
+		);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Splits the list into basic blocks", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+
+		Instruction_pushs_int(1);
+		Instruction_jump_ifeqs_id("if_else", 1);
+		Instruction_call_func(2);
+		NEWLINE
+		Instruction_label_id("if_else", 1);
+		Instruction_label_id("if_end", 1);
+		Instruction_exit(0);
+
+		Array *blocks = InstructionList_getBasicBlocks(&list);
+		EXPECT_EQUAL_INT(blocks->size, 4);
+
+		BasicBlock *block = Array_get(blocks, 0);
+		EXPECT_EQUAL_INT(block->start, 0);
+		EXPECT_EQUAL_INT(block->end, 2);
+
+		block = Array_get(blocks, 1);
+		EXPECT_EQUAL_INT(block->start, 2);
+		EXPECT_EQUAL_INT(block->end, 4);
+
+		block = Array_get(blocks, 2);
+		EXPECT_EQUAL_INT(block->start, 4);
+		EXPECT_EQUAL_INT(block->end, 5);
+
+		block = Array_get(blocks, 3);
+		EXPECT_EQUAL_INT(block->start, 5);
+		EXPECT_EQUAL_INT(block->end, 7);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Appends a separately generated body", {
+		InstructionList body;
+		InstructionList_constructor(&list);
+		InstructionList_constructor(&body);
+
+		InstructionList_select(&body);
+		Instruction_emit(OPCODE_ADD, 3, Operand_variable_named_id(FRAME_LOCAL, "tmp", 0), Operand_variable_id(FRAME_LOCAL, 1), Operand_int(1));
+
+		InstructionList_select(&list);
+		Instruction_emit(OPCODE_DEFVAR, 1, Operand_variable_named_id(FRAME_LOCAL, "tmp", 0));
+		InstructionList_append(&list, &body);
+		InstructionList_select(NULL);
+
+		EXPECT_EQUAL_INT(list.instructions->size, 2);
+		EXPECT_EQUAL_STRING(serializeInstructions(&list)->value,
+			"DEFVAR LF@$tmp_0\n"
+			"ADD LF@$tmp_0 LF@$1 int@1\n"
+		);
+
+		InstructionList_destructor(&body);
+		InstructionList_destructor(&list);
+	})
+}
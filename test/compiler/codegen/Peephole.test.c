@@ -0,0 +1,101 @@
+#include "compiler/codegen/Instruction.h"
+#include "compiler/codegen/Peephole.h"
+#include "internal/Array.h"
+#include "unit.h"
+#include <stdio.h>
+
+#define TEST_PRIORITY 100
+
+DESCRIBE(peephole_rules, "Peephole rules") {
+	InstructionList list;
+	Peephole peephole;
+	Instruction *instruction = NULL;
+
+	TEST("Lowers the stack traffic through the helper variables", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		Peephole_constructor(&peephole);
+
+		// a = b + c
+		Instruction_pushs_id(2, FRAME_GLOBAL);
+		Instruction_pushs_id(3, FRAME_GLOBAL);
+		Instruction_adds();
+		Instruction_pops_id(1, FRAME_GLOBAL);
+
+		// write(a)
+		Instruction_pushs_id(1, FRAME_GLOBAL);
+		Instruction_pops("WRITE_TMP", FRAME_GLOBAL);
+		Instruction_write("WRITE_TMP", FRAME_GLOBAL);
+
+		Peephole_optimize(&peephole, &list);
+
+		EXPECT_EQUAL_INT(list.instructions->size, 2);
+		EXPECT_EQUAL_INT(peephole.inputSize, 7);
+		EXPECT_EQUAL_INT(peephole.outputSize, 2);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_STACK_OPERATION], 1);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_PUSH_POP], 1);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_HELPER_SOURCE], 1);
+
+		instruction = Array_get(list.instructions, 0);
+		EXPECT_TRUE(instruction->opcode == OPCODE_ADD);
+		EXPECT_EQUAL_INT(instruction->operands[0].id, 1);
+		EXPECT_EQUAL_INT(instruction->operands[1].id, 2);
+		EXPECT_EQUAL_INT(instruction->operands[2].id, 3);
+
+		instruction = Array_get(list.instructions, 1);
+		EXPECT_TRUE(instruction->opcode == OPCODE_WRITE);
+		EXPECT_EQUAL_INT(instruction->operands[0].id, 1);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Fuses the comparison into the conditional jump", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		Peephole_constructor(&peephole);
+
+		// while a != 10
+		Instruction_label_id("loop_start", 4);
+		Instruction_pushs_id(1, FRAME_GLOBAL);
+		Instruction_pushs_int(10);
+		Instruction_eqs();
+		Instruction_nots();
+		Instruction_pushs_bool(true);
+		Instruction_jump_ifneqs_id("loop_end", 4);
+
+		Peephole_optimize(&peephole, &list);
+
+		EXPECT_EQUAL_INT(list.instructions->size, 2);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_NEGATED_JUMP], 1);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_COMPARE_JUMP], 1);
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_OPERAND_JUMP], 1);
+
+		instruction = Array_get(list.instructions, 1);
+		EXPECT_TRUE(instruction->opcode == OPCODE_JUMPIFEQ);
+		EXPECT_EQUAL_INT(instruction->operands[1].id, 1);
+		EXPECT_EQUAL_INT(instruction->operands[2].value.integer, 10);
+
+		InstructionList_destructor(&list);
+	})
+
+	TEST("Keeps the value pushed before it is overwritten", {
+		InstructionList_constructor(&list);
+		InstructionList_select(&list);
+		Peephole_constructor(&peephole);
+
+		// (a, b) = (b, a) through the stack
+		Instruction_pushs_id(1, FRAME_GLOBAL);
+		Instruction_pushs_id(2, FRAME_GLOBAL);
+		Instruction_pops_id(1, FRAME_GLOBAL);
+		Instruction_pops_id(2, FRAME_GLOBAL);
+
+		Peephole_optimize(&peephole, &list);
+
+		EXPECT_EQUAL_INT(peephole.hits[PEEPHOLE_PUSH_MOVE_POP], 0);
+
+		instruction = Array_get(list.instructions, 0);
+		EXPECT_TRUE(instruction->opcode == OPCODE_PUSHS);
+
+		InstructionList_destructor(&list);
+	})
+}
@@ -0,0 +1,42 @@
+// Call-heavy loop, small functions are inlined at the call sites
+var calls = 0
+
+func square(_ x: Int) -> Int {
+    return x * x
+}
+
+func toDouble(_ x: Int) -> Double {
+    return Int2Double(x)
+}
+
+func average(_ a: Double, _ b: Double) -> Double {
+    return (a + b) / 2
+}
+
+func clamp(_ x: Int, _ limit: Int) -> Int {
+    var result = x
+    if (x > limit) {
+        result = limit
+    }
+    return result
+}
+
+func step(_ x: Int, _ y: Int) -> Int {
+    let sum = x + y
+    var next = sum * 3
+    next = next - square(y)
+    calls = calls + 1
+    return next
+}
+
+var i = 0
+var total = 0
+var mean = 0.0
+while (i < 20000) {
+    total = step(square(i) - total, i)
+    total = clamp(total, 1000000)
+    mean = average(mean, toDouble(i))
+    i = i + 1
+}
+
+write("Total: ", total, ", mean: ", mean, ", calls: ", calls, "\n")
@@ -0,0 +1,21 @@
+// Loop-heavy code, invariant expressions are hoisted and the iterator arithmetic is strength-reduced
+let text = "loop invariant code motion"
+let width = 7
+
+var checksum = 0
+var i = 0
+while i < length(text) * 40 {
+    let index = i - (i / length(text)) * length(text)
+    checksum = checksum + ord(substring(of: text, startingAt: index, endingBefore: index + 1)!) * (width * 3 + 1)
+    i = i + 1
+}
+
+var grid = 0
+for row in 0..<100 {
+    for column in 0..<100 {
+        grid = grid + row * width + column * 2 + 1
+    }
+}
+
+write("checksum: ", checksum, "\n")
+write("grid: ", grid, "\n")
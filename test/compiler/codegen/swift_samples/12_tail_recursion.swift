@@ -0,0 +1,29 @@
+// Self-recursive calls in tail position reuse the frame of the function
+func factorial(_ n: Int, _ accumulator: Int) -> Int {
+    if (n < 2) {
+        return accumulator
+    }
+    return factorial(n - 1, accumulator * n)
+}
+
+func countChars(_ text: String, _ char: String, _ index: Int, _ count: Int) -> Int {
+    if (index >= length(text)) {
+        return count
+    }
+    let current = substring(of: text, startingAt: index, endingBefore: index + 1)!
+    if (current == char) {
+        return countChars(text, char, index + 1, count + 1)
+    }
+    return countChars(text, char, index + 1, count)
+}
+
+func sumTo(_ n: Int, _ total: Int) -> Int {
+    if (n == 0) {
+        return total
+    }
+    return sumTo(n - 1, total + n)
+}
+
+write("factorial: ", factorial(20, 1), "\n")
+write("count: ", countChars("tail calls are jumps to the function body", "a", 0, 0), "\n")
+write("sum: ", sumTo(100000, 0), "\n")
@@ -0,0 +1,18 @@
+// Chained concatenations and interpolations are built in a single accumulator
+func tag(_ name: String?, _ isOpen: Bool) -> String {
+    return "<" + "\(name)" + " open=\(isOpen)" + ">"
+}
+
+var csv = ""
+var i = 0
+while (i < 5) {
+    csv = csv + "\(i)" + ","
+    i = i + 1
+}
+
+let missing: String? = nil
+let flag: Bool? = false
+
+write(csv, "\n")
+write(tag("div", true), tag(nil, false), "\n")
+write("missing: \(missing), flag: \(flag), nested: \("a\("b")c")", "\n")
@@ -0,0 +1,12 @@
+// Concatenated arguments of write are written part by part
+func logged(_ x: Int) -> Int {
+    write("<logged>")
+    return x * 2
+}
+
+var count = 3
+let missing: Int? = nil
+
+write("count=\(count) ready=\(count > 2) missing=\(missing)\n")
+write("before call: \(logged(count)), after call: \(count)\n")
+write("a" + "b" + "\(count)" + "c\n")
@@ -0,0 +1,19 @@
+// Numbers are converted to strings by the native routines
+func describe(_ value: Double?, _ count: Int?) -> String {
+    return "value=\(value) count=\(count)"
+}
+
+let negative = 0 - 1234
+let fraction = 0.0 - 0.125
+let whole = 42.0
+
+write("\(negative) \(0) \(fraction) \(whole) \(1.0 / 3.0)\n")
+write(describe(2.5, 3), " ", describe(nil, nil), "\n")
+
+// The minimum Int has no positive counterpart
+var minimum = 0 - 9223372036854775807
+while (minimum > 0 - 9223372036854775807 - 1) {
+    minimum = minimum - 1
+}
+let extremes = "\(minimum) \(minimum + 1) \(0 - minimum - 1)"
+write(extremes, "\n")
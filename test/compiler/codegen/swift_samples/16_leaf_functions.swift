@@ -0,0 +1,28 @@
+// Leaf functions are called without a frame, their variables live in the global frame
+func mix(_ a: Int, _ b: Int) -> Int {
+    var t = a * 31 + b
+    if (t > 1000) {
+        t = t - (t / 1000) * 1000
+    }
+    return t
+}
+
+func gcd(_ a: Int, _ b: Int) -> Int {
+    if (b == 0) {
+        return a
+    }
+    return gcd(b, a - (a / b) * b)
+}
+
+func report(_ label: String, _ value: Int) {
+    write(label, ": ", value, "\n")
+}
+
+var i = 0
+var h = 7
+while (i < 20) {
+    h = mix(h, mix(i, h))
+    i = i + 1
+}
+report("mix", h)
+report("gcd", gcd(1071, 462))
@@ -0,0 +1,75 @@
+// Conditions jump to their targets, the operands are evaluated only when needed
+func mark(_ name: String, _ value: Bool) -> Bool {
+    write(name, " ")
+    return value
+}
+
+var yes = true
+var no = false
+let missing: Int? = nil
+let present: Int? = 7
+
+// The left operand decides the result, the right one is skipped
+if mark("a", no) && mark("b", yes) {
+    write("and-true\n")
+} else {
+    write("and-false\n")
+}
+if mark("c", yes) || mark("d", no) {
+    write("or-true\n")
+} else {
+    write("or-false\n")
+}
+
+// The left operand does not decide the result, the right one runs
+if mark("e", yes) && mark("f", no) {
+    write("and-true\n")
+} else {
+    write("and-false\n")
+}
+if mark("g", no) || mark("h", yes) {
+    write("or-true\n")
+} else {
+    write("or-false\n")
+}
+
+// Negations swap the targets of the nested operands
+if !(mark("i", yes) && !mark("j", no)) {
+    write("not-true\n")
+} else {
+    write("not-false\n")
+}
+if !(!mark("k", no)) || !(mark("l", no) || mark("m", yes)) {
+    write("not-true\n")
+} else {
+    write("not-false\n")
+}
+
+// Comparisons with nil
+if missing == nil && present != nil {
+    write("nil-true\n")
+} else {
+    write("nil-false\n")
+}
+if missing != nil || mark("n", present == nil) {
+    write("nil-true\n")
+} else {
+    write("nil-false\n")
+}
+if (missing ?? 0) == 0 && (present ?? 0) == 7 {
+    write("coalesce-true\n")
+} else {
+    write("coalesce-false\n")
+}
+
+// Logical expressions used as values
+let both = mark("o", no) && mark("p", yes)
+let either = mark("q", yes) || mark("r", no)
+write(both, " ", either, "\n")
+
+// Loop conditions evaluate the right operand on every iteration
+var i = 0
+while i < 3 && mark("s", i != 1) {
+    i = i + 1
+}
+write(i, "\n")
@@ -0,0 +1,61 @@
+// Substring and ord are lowered in place, the bounds are checked before the copying loop
+func show(_ value: String?) {
+    if let value {
+        write("[", value, "]\n")
+    } else {
+        write("nil\n")
+    }
+}
+
+let s = "hello"
+let n = length(s)
+var r: String? = nil
+
+r = substring(of: s, startingAt: 1, endingBefore: 3)
+show(r)
+r = substring(of: s, startingAt: 0, endingBefore: n)
+show(r)
+
+// Start after the end
+r = substring(of: s, startingAt: 3, endingBefore: 1)
+show(r)
+
+// Negative start or end
+r = substring(of: s, startingAt: 0 - 1, endingBefore: 2)
+show(r)
+r = substring(of: s, startingAt: 0, endingBefore: 0 - 1)
+show(r)
+
+// Start at the length, end past the length
+r = substring(of: s, startingAt: n, endingBefore: n)
+show(r)
+r = substring(of: s, startingAt: 2, endingBefore: n + 1)
+show(r)
+
+// Empty result
+r = substring(of: s, startingAt: 2, endingBefore: 2)
+show(r)
+
+// Bounds known only at runtime
+var i = 0 - 1
+while i <= n {
+    let c = substring(of: s, startingAt: i, endingBefore: i + 1)
+    let code = ord(c ?? "")
+    write(i, ":", c, ":", code, " ")
+    i = i + 1
+}
+write("\n")
+
+// Empty string has no first character
+let empty = ""
+write(ord(empty), " ", ord(""), " ", ord(s), "\n")
+
+// Destination is also the argument
+var t = "abcdef"
+t = substring(of: t, startingAt: 1, endingBefore: 4)!
+write(t, "\n")
+var u: String? = "wxyz"
+u = substring(of: u ?? "", startingAt: 1, endingBefore: 3)
+show(u)
+u = substring(of: u ?? "", startingAt: 1, endingBefore: 5)
+show(u)
@@ -1,10 +1,12 @@
 #! /usr/bin/bash
 
 set -e
+set -o pipefail
 
 INTERPRETER_PATH="./test/compiler/codegen/ic23int"
 CODEGEN_PATH="./test/compiler/codegen"
 COMPILER_PATH="./bin/main"
+EXPECTED_PATH="$CODEGEN_PATH/expected_outputs"
 
 function prepare_environment() {
    echo "🌱 Preparing test environment"
@@ -42,7 +44,7 @@ function run_interpreter() {
     echo "Running program: $file"
     echo "Interpreter output ⬇️"
 
-    if $INTERPRETER_PATH "$file"; then
+    if $INTERPRETER_PATH "$file" | tee "$file.out"; then
         echo ""
         echo "✅ Interpreter finished successfully"
     else
@@ -50,11 +52,47 @@ function run_interpreter() {
         echo "❌ Interpreter failed"
         exit 1
     fi
+
+    check_output "$file.out" "$EXPECTED_PATH/$(basename "$file" .ifjcode).out"
   done
 
   echo "🚀 Code interpreted"
 }
 
+# Samples with an expected output are also checked with the data stack lowering
+function run_stack_lowering() {
+  echo "📚 Running samples with the stack lowering"
+
+  for expected in "$EXPECTED_PATH"/*.out; do
+    local sample="$CODEGEN_PATH/swift_samples/$(basename "$expected" .out)"
+    local file="$CODEGEN_PATH/compiled_codes/$(basename "$sample").stack.ifjcode"
+    echo "Running program: $sample (--stack)"
+
+    if ! ($COMPILER_PATH --stack < "$sample") > "$file" || ! $INTERPRETER_PATH "$file" > "$file.out"; then
+        echo "❌ Stack lowering failed at file: $sample"
+        exit 1
+    fi
+
+    check_output "$file.out" "$expected"
+  done
+
+  echo "📚 Stack lowering complete"
+}
+
+function check_output() {
+  local output="$1"
+  local expected="$2"
+
+  [ -f "$expected" ] || return 0
+
+  if diff "$expected" "$output"; then
+     echo "✅ Output matches $expected"
+  else
+     echo "❌ Output differs from $expected"
+     exit 1
+  fi
+}
+
 function cleanup() {
   echo "🧹 Cleaning up"
 
@@ -72,3 +110,4 @@ cleanup
 prepare_environment
 run_compilation
 run_interpreter
+run_stack_lowering
@@ -2863,3 +2863,83 @@ DESCRIBE(peekToken, "Peeking tokens (peekToken)") {
 		EXPECT_TRUE(Lexer_isAtEnd(&lexer));
 	} TEST_END();
 }
+
+DESCRIBE(peek, "Peeking tokens without result (peek)") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Token *token;
+	LexerResult result;
+
+	TEST_BEGIN("Peeking ahead does not consume the tokens") {
+		Lexer_setSource(&lexer, "1 2 3");
+
+		token = Lexer_peek(&lexer, 0);
+		EXPECT_NULL(token);
+
+		token = Lexer_peek(&lexer, 3);
+		EXPECT_NOT_NULL(token);
+		EXPECT_TRUE(token->kind == TOKEN_INTEGER);
+		EXPECT_EQUAL_INT(token->value.integer, 3);
+		EXPECT_EQUAL_INT(lexer.currentTokenIndex, -1);
+
+		token = Lexer_peek(&lexer, 1);
+		EXPECT_NOT_NULL(token);
+		EXPECT_EQUAL_INT(token->value.integer, 1);
+
+		result = Lexer_nextToken(&lexer);
+		EXPECT_TRUE(result.success);
+		EXPECT_TRUE(result.token == token);
+
+		token = Lexer_peek(&lexer, 0);
+		EXPECT_TRUE(token == result.token);
+
+		token = Lexer_peek(&lexer, -1);
+		EXPECT_NULL(token);
+
+		result = Lexer_nextToken(&lexer);
+		EXPECT_TRUE(result.success);
+		EXPECT_EQUAL_INT(result.token->value.integer, 2);
+
+		token = Lexer_peek(&lexer, -1);
+		EXPECT_NOT_NULL(token);
+		EXPECT_EQUAL_INT(token->value.integer, 1);
+	} TEST_END();
+
+	TEST_BEGIN("Peeking after the end of the token stream") {
+		Lexer_setSource(&lexer, "a");
+
+		token = Lexer_peek(&lexer, 2);
+		EXPECT_NOT_NULL(token);
+		EXPECT_TRUE(token->type == TOKEN_EOF);
+
+		token = Lexer_peek(&lexer, 10);
+		EXPECT_NOT_NULL(token);
+		EXPECT_TRUE(token->type == TOKEN_EOF);
+
+		result = Lexer_nextToken(&lexer);
+		EXPECT_TRUE(result.success);
+		EXPECT_TRUE(result.token->type == TOKEN_IDENTIFIER);
+
+		result = Lexer_nextToken(&lexer);
+		EXPECT_TRUE(result.success);
+		EXPECT_TRUE(result.token->type == TOKEN_EOF);
+	} TEST_END();
+
+	TEST_BEGIN("Peeking at the invalid token") {
+		Lexer_setSource(&lexer, "a ~");
+
+		token = Lexer_peek(&lexer, 1);
+		EXPECT_NOT_NULL(token);
+		EXPECT_TRUE(lexer.error.success);
+
+		token = Lexer_peek(&lexer, 2);
+		EXPECT_NULL(token);
+		EXPECT_FALSE(lexer.error.success);
+		EXPECT_TRUE(lexer.error.type == RESULT_ERROR_LEXICAL_ANALYSIS);
+
+		result = Lexer_peekToken(&lexer, 2);
+		EXPECT_FALSE(result.success);
+		EXPECT_TRUE(result.type == RESULT_ERROR_LEXICAL_ANALYSIS);
+	} TEST_END();
+}
@@ -0,0 +1,513 @@
+#include <stdio.h>
+
+#include "unit.h"
+
+#include "compiler/lexer/Lexer.h"
+#include "compiler/parser/Parser.h"
+#include "compiler/parser/ASTNodes.h"
+#include "compiler/analyser/Analyser.h"
+#include "compiler/optimizer/Optimizer.h"
+
+#include "../parser/parser_assertions.h"
+
+#define TEST_PRIORITY 60
+
+// Initializer of the first declarator of the variable declaration statement
+#define INITIALIZER_OF(statements, index) \
+	(((VariableDeclaratorASTNode*)Array_get(((VariableDeclarationASTNode*)Array_get(statements, index))->declaratorList->declarators, 0))->initializer)
+
+DESCRIBE(constant_folding, "Folding of constant expressions") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	Optimizer optimizer;
+	Optimizer_constructor(&optimizer, &analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	// Declarations of the built-in functions are prepended to the statements, so they are indexed from the end
+
+	TEST_BEGIN("Arithmetic over literals keeps the semantics of the target code") {
+		Lexer_setSource(
+			&lexer,
+			"var a = 1 + 2 * 3" LF
+			"var b = (0 - 7) / 2" LF
+			"var c = 7.0 / 2" LF
+			"var d = \"a\" + \"b\"" LF
+			"var e = 1 / 0" LF
+			"write(a, b, c, d, e)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -6);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_TRUE(literal->type.type == TYPE_INT);
+		EXPECT_EQUAL_INT(literal->value.integer, 7);
+
+		// Integer division rounds towards negative infinity
+		literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -5);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(literal->value.integer, -4);
+
+		literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -4);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_TRUE(literal->type.type == TYPE_DOUBLE);
+		EXPECT_TRUE(literal->value.floating == 3.5);
+
+		literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -3);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_TRUE(literal->type.type == TYPE_STRING);
+		EXPECT_TRUE(String_equals(literal->value.string, "ab"));
+
+		// Division by zero has to fail at runtime
+		EXPECT_TRUE(INITIALIZER_OF(statements, -2)->_type == NODE_BINARY_EXPRESSION);
+	} TEST_END();
+
+	TEST_BEGIN("Comparisons, logical operators and null coalescing") {
+		Lexer_setSource(
+			&lexer,
+			"var a = \"a\" < \"b\" && !(1 == 2.0)" LF
+			"var b = 5 ?? 6" LF
+			"var c: Int? = nil" LF
+			"var d = c ?? 4" LF
+			"write(a, b, d)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -5);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_TRUE(literal->type.type == TYPE_BOOL);
+		EXPECT_TRUE(literal->value.boolean);
+
+		literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -4);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(literal->value.integer, 5);
+
+		// Variable can be modified, so its value is unknown
+		EXPECT_TRUE(INITIALIZER_OF(statements, -2)->_type == NODE_BINARY_EXPRESSION);
+	} TEST_END();
+
+	TEST_BEGIN("Constants initialized with literals are propagated") {
+		Lexer_setSource(
+			&lexer,
+			"let a = 2 * 3" LF
+			"let b: Int? = nil" LF
+			"var c = a + 1" LF
+			"var d = b ?? a" LF
+			"var e = c + a" LF
+			"write(d, e, f())" LF
+			"func f() -> Int {" LF
+			"	return a * 2" LF
+			"}" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		LiteralExpressionASTNode *literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -5);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(literal->value.integer, 7);
+
+		literal = (LiteralExpressionASTNode*)INITIALIZER_OF(statements, -4);
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(literal->value.integer, 6);
+
+		BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)INITIALIZER_OF(statements, -3);
+		EXPECT_TRUE(binary->_type == NODE_BINARY_EXPRESSION);
+		EXPECT_TRUE(binary->left->_type == NODE_IDENTIFIER);
+		EXPECT_TRUE(binary->right->_type == NODE_LITERAL_EXPRESSION);
+
+		// Constants are propagated into the function bodies as well
+		FunctionDeclarationASTNode *function = Array_get(statements, -1);
+		ReturnStatementASTNode *returnStatement = Array_get(function->body->statements, 0);
+		literal = (LiteralExpressionASTNode*)returnStatement->expression;
+		EXPECT_TRUE(literal->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(literal->value.integer, 12);
+	} TEST_END();
+}
+
+DESCRIBE(dead_code_elimination, "Elimination of dead code and unused declarations") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	Optimizer optimizer;
+	Optimizer_constructor(&optimizer, &analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	TEST_BEGIN("Unreachable statements are removed") {
+		Lexer_setSource(
+			&lexer,
+			"func f(_ a: Int) -> Int {" LF
+			"	while a > 0 {" LF
+			"		break" LF
+			"		write(1)" LF
+			"	}" LF
+			"	return a" LF
+			"	write(2)" LF
+			"}" LF
+			"let isDebug = false" LF
+			"if isDebug {" LF
+			"	write(3)" LF
+			"} else if 1 < 2 {" LF
+			"	write(f(4))" LF
+			"	write(5)" LF
+			"}" LF
+			"while false {}" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		// Taken branch replaced the if statement and the loop was removed
+		EXPECT_TRUE(((StatementASTNode*)Array_get(statements, -1))->_type == NODE_EXPRESSION_STATEMENT);
+		EXPECT_TRUE(((StatementASTNode*)Array_get(statements, -2))->_type == NODE_EXPRESSION_STATEMENT);
+		EXPECT_TRUE(((StatementASTNode*)Array_get(statements, -3))->_type == NODE_VARIABLE_DECLARATION);
+		EXPECT_TRUE(((StatementASTNode*)Array_get(statements, -4))->_type == NODE_FUNCTION_DECLARATION);
+
+		// Invariant test of the loop is evaluated in front of it
+		FunctionDeclarationASTNode *function = Array_get(statements, -4);
+		EXPECT_EQUAL_INT(function->body->statements->size, 3);
+		EXPECT_TRUE(((StatementASTNode*)Array_get(function->body->statements, -1))->_type == NODE_RETURN_STATEMENT);
+
+		WhileStatementASTNode *whileStatement = Array_get(function->body->statements, 1);
+		EXPECT_EQUAL_INT(whileStatement->body->statements->size, 1);
+	} TEST_END();
+
+	TEST_BEGIN("Unreachable functions and unused variables are removed") {
+		Lexer_setSource(
+			&lexer,
+			"func f() -> Int {" LF
+			"	var n = 0" LF
+			"	while n < 3 {" LF
+			"		n = n + g()" LF
+			"	}" LF
+			"	return n" LF
+			"}" LF
+			"func g() -> Int {" LF
+			"	let a = 1" LF
+			"	return 2" LF
+			"}" LF
+			"func h() -> Int {" LF
+			"	return f()" LF
+			"}" LF
+			"let x = 1" LF
+			"var y = x + 1" LF
+			"var z = f()" LF
+			"write(y)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		FunctionDeclarationASTNode *f = Array_get(statements, -7);
+		FunctionDeclarationASTNode *g = Array_get(statements, -6);
+		FunctionDeclarationASTNode *h = Array_get(statements, -5);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, f->id->id)->isUsed);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, g->id->id)->isUsed);
+		EXPECT_FALSE(Analyser_getFunctionById(&analyser, h->id->id)->isUsed);
+
+		// Helpers of the string interpolation are not called
+		Array *stringify = Analyser_getFunctionDeclarationsByName(&analyser, "__stringify__");
+		for(size_t i = 0; i < stringify->size; i++) {
+			FunctionDeclaration *declaration = Array_get(stringify, i);
+			EXPECT_FALSE(declaration->isUsed);
+		}
+
+		// Constant was propagated, the result of the call is unused but the call has to be made
+		EXPECT_EQUAL_INT(((VariableDeclarationASTNode*)Array_get(statements, -4))->declaratorList->declarators->size, 0);
+		EXPECT_EQUAL_INT(((VariableDeclarationASTNode*)Array_get(statements, -2))->declaratorList->declarators->size, 1);
+		EXPECT_EQUAL_INT(analyser.variables->size, 2);
+
+		FunctionDeclaration *declaration = Analyser_getFunctionById(&analyser, g->id->id);
+		EXPECT_EQUAL_INT(declaration->variables->size, 0);
+	} TEST_END();
+
+	TEST_BEGIN("Functions calling no other user functions are leaves") {
+		Lexer_setSource(
+			&lexer,
+			"func square(_ x: Int) -> Int {" LF
+			"	if(x < 0) {" LF
+			"		write(\"\\(x)\")" LF
+			"	}" LF
+			"	return x * x" LF
+			"}" LF
+			"func count(_ n: Int, _ total: Int) -> Int {" LF
+			"	if(n == 0) {" LF
+			"		return total" LF
+			"	}" LF
+			"	return count(n - 1, total + n)" LF
+			"}" LF
+			"func sum(_ n: Int) -> Int {" LF
+			"	let a = square(n)" LF
+			"	return a + count(n, 0)" LF
+			"}" LF
+			"write(sum(3))" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		// Built-in functions and the self-recursive tail calls do not make a call frame
+		FunctionDeclarationASTNode *square = Array_get(statements, -4);
+		FunctionDeclarationASTNode *count = Array_get(statements, -3);
+		FunctionDeclarationASTNode *sum = Array_get(statements, -2);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, square->id->id)->isLeaf);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, count->id->id)->isLeaf);
+		EXPECT_FALSE(Analyser_getFunctionById(&analyser, sum->id->id)->isLeaf);
+	} TEST_END();
+}
+
+DESCRIBE(function_inlining, "Inlining of small functions") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	Optimizer optimizer;
+	Optimizer_constructor(&optimizer, &analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	TEST_BEGIN("Single return bodies are substituted into the expressions") {
+		Lexer_setSource(
+			&lexer,
+			"func square(_ x: Int) -> Int {" LF
+			"	return x * x" LF
+			"}" LF
+			"func fact(_ n: Int) -> Int {" LF
+			"	if n < 2 { return 1 }" LF
+			"	return n * fact(n - 1)" LF
+			"}" LF
+			"var a = readInt() ?? 0" LF
+			"var b = square(a) + square(3)" LF
+			"var c = fact(a)" LF
+			"write(b, c)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)INITIALIZER_OF(statements, -3);
+		EXPECT_TRUE(binary->_type == NODE_BINARY_EXPRESSION);
+		EXPECT_TRUE(binary->left->_type == NODE_BINARY_EXPRESSION);
+		EXPECT_TRUE(((BinaryExpressionASTNode*)binary->left)->left->_type == NODE_IDENTIFIER);
+		EXPECT_TRUE(binary->right->_type == NODE_LITERAL_EXPRESSION);
+		EXPECT_EQUAL_INT(((LiteralExpressionASTNode*)binary->right)->value.integer, 9);
+
+		// Recursive function is called as usual
+		EXPECT_TRUE(INITIALIZER_OF(statements, -2)->_type == NODE_FUNCTION_CALL);
+
+		FunctionDeclarationASTNode *square = Array_get(statements, -6);
+		FunctionDeclarationASTNode *fact = Array_get(statements, -5);
+		EXPECT_FALSE(Analyser_getFunctionById(&analyser, square->id->id)->isUsed);
+		EXPECT_TRUE(Analyser_getFunctionById(&analyser, fact->id->id)->isUsed);
+	} TEST_END();
+
+	TEST_BEGIN("Straight-line bodies are inlined with fresh variables") {
+		Lexer_setSource(
+			&lexer,
+			"func sum(_ a: Int, _ b: Int) -> Int {" LF
+			"	var t = a + b" LF
+			"	t = t * 2" LF
+			"	return t" LF
+			"}" LF
+			"func f() -> Int {" LF
+			"	let r = sum(readInt() ?? 0, 1)" LF
+			"	return r" LF
+			"}" LF
+			"write(f())" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		FunctionDeclarationASTNode *sum = Array_get(statements, -3);
+		FunctionDeclarationASTNode *f = Array_get(statements, -2);
+		FunctionDeclaration *sumDeclaration = Analyser_getFunctionById(&analyser, sum->id->id);
+		FunctionDeclaration *fDeclaration = Analyser_getFunctionById(&analyser, f->id->id);
+		EXPECT_FALSE(sumDeclaration->isUsed);
+		EXPECT_TRUE(fDeclaration->isUsed);
+
+		// Copies of the parameters precede the body, the constant argument was propagated
+		Array *body = f->body->statements;
+		EXPECT_EQUAL_INT(body->size, 6);
+		EXPECT_EQUAL_INT(((VariableDeclarationASTNode*)Array_get(body, 1))->declaratorList->declarators->size, 0);
+		EXPECT_TRUE(((StatementASTNode*)Array_get(body, 3))->_type == NODE_ASSIGNMENT_STATEMENT);
+
+		VariableDeclaratorASTNode *a = Array_get(((VariableDeclarationASTNode*)Array_get(body, 0))->declaratorList->declarators, 0);
+		VariableDeclaratorASTNode *t = Array_get(((VariableDeclarationASTNode*)Array_get(body, 2))->declaratorList->declarators, 0);
+		BinaryExpressionASTNode *binary = (BinaryExpressionASTNode*)t->initializer;
+		EXPECT_TRUE(binary->left->_type == NODE_IDENTIFIER);
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)binary->left)->id, a->pattern->id->id);
+		EXPECT_TRUE(binary->right->_type == NODE_LITERAL_EXPRESSION);
+
+		// Local variables of the inlined function are declared again in the caller
+		EXPECT_EQUAL_INT(fDeclaration->variables->size, 3);
+		VariableDeclaration *original = Array_get(sumDeclaration->variables, 0);
+		EXPECT_TRUE(t->pattern->id->id != original->id);
+		EXPECT_TRUE(((AssignmentStatementASTNode*)Array_get(body, 3))->id->id == t->pattern->id->id);
+	} TEST_END();
+}
+
+DESCRIBE(loop_optimization, "Optimization of the loops") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	Analyser analyser;
+	Analyser_constructor(&analyser);
+
+	Optimizer optimizer;
+	Optimizer_constructor(&optimizer, &analyser);
+
+	ParserResult parserResult;
+	AnalyserResult analyserResult;
+
+	TEST_BEGIN("Invariant expressions are evaluated before the loop") {
+		Lexer_setSource(
+			&lexer,
+			"func count(_ s: String, _ k: Int) -> Int {" LF
+			"	var n = 0" LF
+			"	var i = 0" LF
+			"	while i < length(s) {" LF
+			"		n = n + (k * 3 + 1) / k" LF
+			"		i = i + 1" LF
+			"	}" LF
+			"	return n" LF
+			"}" LF
+			"write(count(\"abc\", readInt() ?? 1))" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		FunctionDeclarationASTNode *count = Array_get(statements, -2);
+		Array *body = count->body->statements;
+		EXPECT_EQUAL_INT(body->size, 6);
+
+		VariableDeclaratorASTNode *length = Array_get(((VariableDeclarationASTNode*)Array_get(body, 2))->declaratorList->declarators, 0);
+		VariableDeclaratorASTNode *product = Array_get(((VariableDeclarationASTNode*)Array_get(body, 3))->declaratorList->declarators, 0);
+		EXPECT_TRUE(length->initializer->_type == NODE_FUNCTION_CALL);
+		EXPECT_TRUE(product->initializer->_type == NODE_BINARY_EXPRESSION);
+
+		WhileStatementASTNode *whileStatement = Array_get(body, 4);
+		BinaryExpressionASTNode *test = (BinaryExpressionASTNode*)whileStatement->test;
+		EXPECT_TRUE(test->right->_type == NODE_IDENTIFIER);
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)test->right)->id, length->pattern->id->id);
+
+		// Division by a variable could fail, it stays in the loop
+		AssignmentStatementASTNode *assignment = Array_get(whileStatement->body->statements, 0);
+		BinaryExpressionASTNode *division = (BinaryExpressionASTNode*)((BinaryExpressionASTNode*)assignment->expression)->right;
+		EXPECT_TRUE(division->_type == NODE_BINARY_EXPRESSION);
+		EXPECT_TRUE(division->left->_type == NODE_IDENTIFIER);
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)division->left)->id, product->pattern->id->id);
+	} TEST_END();
+
+	TEST_BEGIN("Affine expressions of the iterator are strength-reduced") {
+		Lexer_setSource(
+			&lexer,
+			"var total = 0" LF
+			"for i in 1...10 {" LF
+			"	total = total + (i * 4 + 1)" LF
+			"	write(2 * i - 1, i, (1 + i * 4) * 1)" LF
+			"}" LF
+			"write(total)" LF
+		);
+		parserResult = Parser_parse(&parser);
+		EXPECT_TRUE(parserResult.success);
+
+		analyserResult = Analyser_analyse(&analyser, (ProgramASTNode*)parserResult.node);
+		EXPECT_TRUE(analyserResult.success);
+
+		Optimizer_optimize(&optimizer);
+		Array *statements = analyser.ast->block->statements;
+
+		ForStatementASTNode *forStatement = Array_get(statements, -2);
+		EXPECT_TRUE(forStatement->_type == NODE_FOR_STATEMENT);
+		EXPECT_EQUAL_INT(forStatement->inductions->size, 2);
+
+		// Equal expressions share the induction variable
+		InductionVariable *first = Array_get(forStatement->inductions, 0);
+		InductionVariable *second = Array_get(forStatement->inductions, 1);
+		EXPECT_EQUAL_INT(first->scale, 4);
+		EXPECT_EQUAL_INT(first->offset, 1);
+		EXPECT_EQUAL_INT(second->scale, 2);
+		EXPECT_EQUAL_INT(second->offset, -1);
+
+		Array *arguments = ((FunctionCallASTNode*)((ExpressionStatementASTNode*)Array_get(forStatement->body->statements, 1))->expression)->argumentList->arguments;
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)((ArgumentASTNode*)Array_get(arguments, 0))->expression)->id, second->id);
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)((ArgumentASTNode*)Array_get(arguments, 1))->expression)->id, forStatement->iterator->id);
+		EXPECT_EQUAL_INT(((IdentifierASTNode*)((ArgumentASTNode*)Array_get(arguments, 2))->expression)->id, first->id);
+	} TEST_END();
+}
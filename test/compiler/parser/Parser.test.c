@@ -2217,7 +2217,7 @@ DESCRIBE(kinda_invalid_tokens, "Invalid tokens") {
 
 			result = Parser_parse(&parser);
 			EXPECT_FALSE(result.success);
-			EXPECT_TRUE(result.type == RESULT_ERROR_SYNTACTIC_ANALYSIS);
+			EXPECT_TRUE(result.type == RESULT_ERROR_LEXICAL_ANALYSIS);
 		}
 		{
 			Lexer_setSource(
@@ -2227,7 +2227,7 @@ DESCRIBE(kinda_invalid_tokens, "Invalid tokens") {
 
 			result = Parser_parse(&parser);
 			EXPECT_FALSE(result.success);
-			EXPECT_TRUE(result.type == RESULT_ERROR_SYNTACTIC_ANALYSIS);
+			EXPECT_TRUE(result.type == RESULT_ERROR_LEXICAL_ANALYSIS);
 		}
 		{
 			Lexer_setSource(
@@ -2761,6 +2761,21 @@ DESCRIBE(invalid_lexical, "Lexical error propagation") {
 		// prbbly later add message check also
 	}
 	TEST_END();
+
+	TEST_BEGIN("After an operand at the end of a statement") {
+		Lexer_setSource(
+			&lexer,
+			"let a = 1" LF
+			"let b = a" LF
+			"@"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_TRUE(result.type == RESULT_ERROR_LEXICAL_ANALYSIS);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 1);
+	}
+	TEST_END();
 }
 
 DESCRIBE(simple_programs, "Simple program parsing") {
@@ -3708,3 +3723,182 @@ DESCRIBE(simple_programs, "Simple program parsing") {
 	TEST_END();
 
 }
+
+DESCRIBE(error_recovery, "Syntax error recovery") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	ParserResult result;
+
+	TEST_BEGIN("Multiple errors in top-level statements") {
+		Lexer_setSource(
+			&lexer,
+			"let a = )" LF
+			"let b = 5" LF
+			"var c: = 7" LF
+			"b = 6"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_TRUE(result.type == RESULT_ERROR_SYNTACTIC_ANALYSIS);
+		EXPECT_NULL(result.node);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 2);
+	} TEST_END();
+
+	TEST_BEGIN("Errors inside of nested blocks") {
+		Lexer_setSource(
+			&lexer,
+			"func foo() {" LF
+			"	let a = = 1" LF
+			"	while true {" LF
+			"		let b = )" LF
+			"	}" LF
+			"	return" LF
+			"}" LF
+			"let c = (" LF
+			"foo()"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 3);
+	} TEST_END();
+
+	TEST_BEGIN("Missing delimiters between statements") {
+		Lexer_setSource(
+			&lexer,
+			"let a = 1 let b = 2" LF
+			"let c = 3" LF
+			"let d = 4 e = 5" LF
+			"let f = 6"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 2);
+	} TEST_END();
+
+	TEST_BEGIN("Unexpected tokens are skipped") {
+		Lexer_setSource(
+			&lexer,
+			") ) )" LF
+			"}" LF
+			"let a = 1"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 2);
+	} TEST_END();
+
+	TEST_BEGIN("Diagnostics are reset between runs") {
+		Lexer_setSource(&lexer, "let a = )");
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 1);
+
+		Lexer_setSource(&lexer, "let a = 1");
+		result = Parser_parse(&parser);
+
+		EXPECT_TRUE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 0);
+	} TEST_END();
+
+	TEST_BEGIN("Lexical error stops the recovery") {
+		Lexer_setSource(
+			&lexer,
+			"let a = )" LF
+			"let b = \"unterminated" LF
+			"let c = )"
+		);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_TRUE(result.type == RESULT_ERROR_SYNTACTIC_ANALYSIS);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 2);
+
+		ParserResult *error = Array_get(parser.diagnostics, 1);
+		EXPECT_TRUE(error->type == RESULT_ERROR_LEXICAL_ANALYSIS);
+	} TEST_END();
+}
+
+DESCRIBE(deep_nesting_parsing, "Parsing of deeply nested code") {
+	Lexer lexer;
+	Lexer_constructor(&lexer);
+
+	Parser parser;
+	Parser_constructor(&parser, &lexer);
+
+	ParserResult result;
+
+	const int depth = 100000;
+
+	TEST_BEGIN("Blocks nested 10^5 levels deep") {
+		String *source = String_alloc("var a = 1" LF);
+		for(int i = 0; i < depth; i++) String_append(source, i % 2 ? "while a < 1 {" LF : "if a == 1 {" LF);
+		String_append(source, "a = 2" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		result = Parser_parse(&parser);
+
+		EXPECT_TRUE(result.success);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 0);
+
+		BlockASTNode *block = ((ProgramASTNode*)result.node)->block;
+		int level = 0;
+
+		while(block->statements->size > 0) {
+			StatementASTNode *statement = Array_get(block->statements, -1);
+			if(statement->_type == NODE_IF_STATEMENT) block = ((IfStatementASTNode*)statement)->body;
+			else if(statement->_type == NODE_WHILE_STATEMENT) block = ((WhileStatementASTNode*)statement)->body;
+			else break;
+			level++;
+		}
+
+		EXPECT_EQUAL_INT(level, depth);
+	} TEST_END();
+
+	TEST_BEGIN("Parentheses nested 10^5 levels deep") {
+		String *source = String_alloc("let a = ");
+		for(int i = 0; i < depth; i++) String_append(source, "(");
+		String_append(source, "1");
+		for(int i = 0; i < depth; i++) String_append(source, ")");
+
+		Lexer_setSource(&lexer, source->value);
+		result = Parser_parse(&parser);
+
+		EXPECT_TRUE(result.success);
+	} TEST_END();
+
+	TEST_BEGIN("Function calls nested 10^5 levels deep") {
+		String *source = String_alloc("let a = ");
+		for(int i = 0; i < depth; i++) String_append(source, "f(");
+		String_append(source, "1");
+		for(int i = 0; i < depth; i++) String_append(source, ")");
+
+		Lexer_setSource(&lexer, source->value);
+		result = Parser_parse(&parser);
+
+		EXPECT_TRUE(result.success);
+	} TEST_END();
+
+	TEST_BEGIN("Error in a block nested 10^5 levels deep") {
+		String *source = String_alloc("");
+		for(int i = 0; i < depth; i++) String_append(source, "if true {" LF);
+		String_append(source, "let = 2" LF);
+		for(int i = 0; i < depth; i++) String_append(source, "}" LF);
+
+		Lexer_setSource(&lexer, source->value);
+		result = Parser_parse(&parser);
+
+		EXPECT_FALSE(result.success);
+		EXPECT_TRUE(result.type == RESULT_ERROR_SYNTACTIC_ANALYSIS);
+		EXPECT_EQUAL_INT(parser.diagnostics->size, 1);
+	} TEST_END();
+}
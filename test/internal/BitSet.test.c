@@ -0,0 +1,137 @@
+#include "internal/BitSet.h"
+#include "unit.h"
+#include <stdio.h>
+
+#define TEST_PRIORITY 100
+
+DESCRIBE(bitset_set_has, "BitSet_set/BitSet_has") {
+	BitSet *set = NULL;
+
+	TEST("Empty set has no bits", {
+		set = BitSet_alloc();
+
+		EXPECT_FALSE(BitSet_has(set, 0));
+		EXPECT_FALSE(BitSet_has(set, 1));
+		EXPECT_FALSE(BitSet_has(set, 1000));
+		EXPECT_EQUAL_INT(set->capacity, 0);
+	})
+
+	TEST("Set and clear bits", {
+		set = BitSet_alloc();
+
+		BitSet_set(set, 3, true);
+		BitSet_set(set, 63, true);
+		BitSet_set(set, 64, true);
+
+		EXPECT_TRUE(BitSet_has(set, 3));
+		EXPECT_TRUE(BitSet_has(set, 63));
+		EXPECT_TRUE(BitSet_has(set, 64));
+		EXPECT_FALSE(BitSet_has(set, 2));
+		EXPECT_FALSE(BitSet_has(set, 4));
+		EXPECT_FALSE(BitSet_has(set, 65));
+
+		BitSet_set(set, 63, false);
+		EXPECT_FALSE(BitSet_has(set, 63));
+		EXPECT_TRUE(BitSet_has(set, 64));
+	})
+
+	TEST("Growing keeps existing bits", {
+		set = BitSet_alloc();
+
+		for(size_t i = 0; i < 10000; i += 7) {
+			BitSet_set(set, i, true);
+		}
+
+		for(size_t i = 0; i < 10000; i++) {
+			EXPECT_TRUE(BitSet_has(set, i) == (i % 7 == 0));
+		}
+	})
+
+	TEST("Clearing past the end does not grow the set", {
+		set = BitSet_alloc();
+
+		BitSet_set(set, 5000, false);
+		EXPECT_EQUAL_INT(set->capacity, 0);
+		EXPECT_FALSE(BitSet_has(set, 5000));
+	})
+}
+
+DESCRIBE(bitset_next, "BitSet_next") {
+	BitSet *set = NULL;
+
+	TEST("Empty set has no next bit", {
+		set = BitSet_alloc();
+
+		EXPECT_TRUE(BitSet_next(set, 0) == SIZE_MAX);
+		EXPECT_TRUE(BitSet_next(set, 1000) == SIZE_MAX);
+	})
+
+	TEST("Walk the set bits in order", {
+		set = BitSet_alloc();
+
+		BitSet_set(set, 0, true);
+		BitSet_set(set, 63, true);
+		BitSet_set(set, 64, true);
+		BitSet_set(set, 700, true);
+
+		EXPECT_EQUAL_INT(BitSet_next(set, 0), 0);
+		EXPECT_EQUAL_INT(BitSet_next(set, 1), 63);
+		EXPECT_EQUAL_INT(BitSet_next(set, 63), 63);
+		EXPECT_EQUAL_INT(BitSet_next(set, 64), 64);
+		EXPECT_EQUAL_INT(BitSet_next(set, 65), 700);
+		EXPECT_TRUE(BitSet_next(set, 701) == SIZE_MAX);
+	})
+}
+
+DESCRIBE(bitset_clear, "BitSet_clear") {
+	BitSet *set = NULL;
+
+	TEST("Clear all bits", {
+		set = BitSet_alloc();
+
+		BitSet_set(set, 1, true);
+		BitSet_set(set, 200, true);
+		BitSet_clear(set);
+
+		EXPECT_FALSE(BitSet_has(set, 1));
+		EXPECT_FALSE(BitSet_has(set, 200));
+	})
+}
+
+DESCRIBE(bitset_operations, "BitSet set operations") {
+	BitSet *set = NULL;
+	BitSet *other = NULL;
+
+	TEST("Union reports the changed bits", {
+		set = BitSet_alloc();
+		other = BitSet_alloc();
+
+		BitSet_set(set, 1, true);
+		BitSet_set(other, 1, true);
+		BitSet_set(other, 130, true);
+
+		EXPECT_TRUE(BitSet_union(set, other));
+		EXPECT_TRUE(BitSet_has(set, 1));
+		EXPECT_TRUE(BitSet_has(set, 130));
+		EXPECT_FALSE(BitSet_union(set, other));
+	})
+
+	TEST("Subtract and copy", {
+		set = BitSet_alloc();
+		other = BitSet_alloc();
+
+		BitSet_set(set, 2, true);
+		BitSet_set(set, 70, true);
+		BitSet_set(other, 70, true);
+		BitSet_set(other, 500, true);
+		BitSet_subtract(set, other);
+
+		EXPECT_TRUE(BitSet_has(set, 2));
+		EXPECT_FALSE(BitSet_has(set, 70));
+
+		BitSet_copy(set, other);
+		EXPECT_FALSE(BitSet_has(set, 2));
+		EXPECT_TRUE(BitSet_has(set, 70));
+		EXPECT_TRUE(BitSet_has(set, 500));
+	})
+}